@@ -0,0 +1,47 @@
+#include "Arena.cpp"
+#include "benchmark/benchmark.h"
+#include <vector>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A node the size of a search tree node.
+*/
+struct BenchmarkNode {
+  NodePool<BenchmarkNode>::Index firstChild;
+  NodePool<BenchmarkNode>::Index nextSibling;
+  float value;
+  int visits;
+  float data[4];
+};
+
+// A turn of a tree search : create nodes, then free them all.
+static void BM_NodesFromPool(benchmark::State &state) {
+  Arena arena;
+  arena.reserve(state.range(0) * sizeof(BenchmarkNode));
+  NodePool<BenchmarkNode> pool(arena);
+  for (auto _ : state) {
+    pool.clear();
+    for (int i = 0; i < state.range(0); ++i)
+      pool[pool.create()].visits = i;
+    benchmark::DoNotOptimize(pool[0].visits);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_NodesFromPool)->Arg(1 << 16);
+
+static void BM_NodesFromNew(benchmark::State &state) {
+  std::vector<BenchmarkNode *> nodes(state.range(0));
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); ++i) {
+      nodes[i] = new BenchmarkNode();
+      nodes[i]->visits = i;
+    }
+    benchmark::DoNotOptimize(nodes[0]->visits);
+    for (int i = 0; i < state.range(0); ++i)
+      delete nodes[i];
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_NodesFromNew)->Arg(1 << 16);
+}
@@ -0,0 +1,7 @@
+#include "Vector2Benchmarks.cpp"
+#include "SimulatorBenchmarks.cpp"
+#include "ArenaBenchmarks.cpp"
+#include "RandomBenchmarks.cpp"
+#include "benchmark/benchmark.h"
+
+BENCHMARK_MAIN();
@@ -0,0 +1,77 @@
+#include "Random.cpp"
+#include "RandomBatch.cpp"
+#include "benchmark/benchmark.h"
+#include <random>
+
+namespace fuzzyTelegram {
+
+// The draws of a random MOVE : an index, then a point in the step disc.
+static void BM_RandomMoveMt19937(benchmark::State &state) {
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> unit(0, 1);
+  std::uniform_int_distribution<int> slot(0, MAX_ENEMIES - 1);
+  for (auto _ : state) {
+    int index = slot(random);
+    float angle = unit(random) * 2 * static_cast<float>(M_PI);
+    float length = std::sqrt(unit(random)) * WOLFF_STEP;
+    Vector2f point(std::cos(angle) * length, std::sin(angle) * length);
+    benchmark::DoNotOptimize(index);
+    benchmark::DoNotOptimize(point);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RandomMoveMt19937);
+
+static void BM_RandomMoveFastRandom(benchmark::State &state) {
+  FastRandom random(1);
+  for (auto _ : state) {
+    int index = static_cast<int>(random.below(MAX_ENEMIES));
+    Vector2f point = random.inDisc(WOLFF_STEP);
+    benchmark::DoNotOptimize(index);
+    benchmark::DoNotOptimize(point);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RandomMoveFastRandom);
+
+static void BM_BoundedIntMt19937(benchmark::State &state) {
+  std::mt19937 random(1);
+  std::uniform_int_distribution<int> slot(0, MAX_ENEMIES - 1);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(slot(random));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BoundedIntMt19937);
+
+static void BM_BoundedIntFastRandom(benchmark::State &state) {
+  FastRandom random(1);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(random.below(MAX_ENEMIES));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BoundedIntFastRandom);
+
+// Filling the genes of a whole population.
+static void BM_FillBatch(benchmark::State &state) {
+  FastRandomBatch<> batch(1);
+  std::uint32_t bits[1024];
+  for (auto _ : state) {
+    batch.fill(bits, 1024);
+    benchmark::DoNotOptimize(bits[1023]);
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_FillBatch);
+
+static void BM_FillScalar(benchmark::State &state) {
+  FastRandom random(1);
+  std::uint32_t bits[1024];
+  for (auto _ : state) {
+    for (int i = 0; i < 1024; ++i)
+      bits[i] = random();
+    benchmark::DoNotOptimize(bits[1023]);
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_FillScalar);
+}
@@ -0,0 +1,196 @@
+#include "AliveMask.cpp"
+#include "Damage.cpp"
+#include "Simulator.cpp"
+#include "SpatialGrid.cpp"
+#include "StateHistory.cpp"
+#include "ThreatMap.cpp"
+#include "Vector2Batch.cpp"
+#include "benchmark/benchmark.h"
+#include <memory>
+#include <random>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return a state with as many data points as enemies, entities in
+* total, and no enemy close enough to kill Wolff next turn.
+*/
+static GameState benchmarkState(int entities, unsigned seed = 1) {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> x(0, static_cast<int>(MAP_WIDTH) - 1);
+  std::uniform_int_distribution<int> y(0, static_cast<int>(MAP_HEIGHT) - 1);
+  GameState state;
+  state.wolff.set(8000, 4500);
+  for (int i = 0; i < entities / 2; ++i)
+    state.addDataPoint(i, Vector2f(x(random), y(random)));
+  for (int i = 0; i < entities - entities / 2; ++i) {
+    Vector2f position;
+    do {
+      position.set(x(random), y(random));
+    } while (Vector2f::distance(position, state.wolff) < 4000);
+    state.addEnemy(i, position, 10);
+    state.initialTotalLife += 10;
+  }
+  return state;
+}
+
+static void BM_NearestDataPointScalar(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)) * 2);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const Vector2f from = game.enemyPositions[i++ % game.enemyCount];
+    int nearest = -1;
+    float nearestDistance = 0;
+    for (int j = 0; j < game.dataCount; ++j) {
+      float distance = Vector2f::distance(game.dataPositions[j], from);
+      if (nearest == -1 || distance < nearestDistance) {
+        nearest = j;
+        nearestDistance = distance;
+      }
+    }
+    benchmark::DoNotOptimize(nearest);
+  }
+}
+BENCHMARK(BM_NearestDataPointScalar)->Arg(5)->Arg(25)->Arg(50)->Arg(100);
+
+static void BM_NearestDataPoint(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)) * 2);
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(nearestDataPoint(
+        game, game.enemyPositions[i++ % game.enemyCount]));
+}
+BENCHMARK(BM_NearestDataPoint)->Arg(5)->Arg(25)->Arg(50)->Arg(100);
+
+// The two lookups nearestDataPoint chooses from, to tune
+// DATA_GRID_THRESHOLD.
+static void BM_NearestDataPointBatch(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)) * 2);
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(game.dataPositions.nearest(
+        game.enemyPositions[i++ % game.enemyCount]));
+}
+BENCHMARK(BM_NearestDataPointBatch)->Arg(5)->Arg(25)->Arg(50)->Arg(100);
+
+static void BM_NearestDataPointGrid(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)) * 2);
+  std::size_t i = 0;
+  DataGrid::Index nearest;
+  float squaredDistance;
+  for (auto _ : state) {
+    game.dataGrid.nearest(game.dataPositions,
+                          game.enemyPositions[i++ % game.enemyCount], 1,
+                          &nearest, &squaredDistance);
+    benchmark::DoNotOptimize(nearest);
+  }
+}
+BENCHMARK(BM_NearestDataPointGrid)->Arg(5)->Arg(25)->Arg(50)->Arg(100);
+
+static void BM_ThreatMapBuild(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)) * 2);
+  std::unique_ptr<ThreatMap> threats(new ThreatMap());
+  for (auto _ : state) {
+    threats->build(game);
+    benchmark::DoNotOptimize(threats->cellTurn(0, 0));
+  }
+}
+BENCHMARK(BM_ThreatMapBuild)->Arg(5)->Arg(25)->Arg(50)->Arg(100);
+
+// Whether a move is safe next turn, by testing every enemy or by reading the
+// threat map.
+static void BM_SafeMoveEnemies(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)) * 2);
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(game.enemyPositions.anyWithin(
+        game.dataPositions[i++ % game.dataCount], KILL_RANGE + ENEMY_STEP));
+}
+BENCHMARK(BM_SafeMoveEnemies)->Arg(5)->Arg(25)->Arg(50)->Arg(100);
+
+static void BM_SafeMoveThreatMap(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)) * 2);
+  std::unique_ptr<ThreatMap> threats(new ThreatMap());
+  threats->build(game);
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        threats->isSafe(game.dataPositions[i++ % game.dataCount], 1));
+}
+BENCHMARK(BM_SafeMoveThreatMap)->Arg(5)->Arg(25)->Arg(50)->Arg(100);
+
+// The damage of shots from the distances of the map beyond the kill range.
+static void BM_ShotDamagePow(benchmark::State &state) {
+  float squaredDistance = 2000.0f * 2000.0f;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(shotDamage(std::sqrt(squaredDistance)));
+    squaredDistance = squaredDistance > 3e8f ? 4e6f : squaredDistance * 1.01f;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShotDamagePow);
+
+static void BM_ShotDamageTable(benchmark::State &state) {
+  float squaredDistance = 2000.0f * 2000.0f;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(shotDamageSquared(squaredDistance));
+    squaredDistance = squaredDistance > 3e8f ? 4e6f : squaredDistance * 1.01f;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShotDamageTable);
+
+// Each iteration copies the root, as every search does before simulating.
+// The planners update the targets of their root once per turn.
+static void BM_SimulateTurn(benchmark::State &state) {
+  GameState root = benchmarkState(static_cast<int>(state.range(0)));
+  updateTargets(root);
+  GameState game;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    game = root;
+    simulate(game, i++ & 1 ? Action::shoot(0)
+                           : Action::move(Vector2f(15000, 8000)));
+    benchmark::DoNotOptimize(game.turn);
+  }
+}
+BENCHMARK(BM_SimulateTurn)->Arg(10)->Arg(50)->Arg(100)->Arg(200);
+
+// Branching from a root : play a rollout of 8 turns and go back, either by
+// restoring a snapshot or by undoing the turns.
+static const int BRANCH_DEPTH = 8;
+
+static Action branchAction(std::size_t i) {
+  return i & 1 ? Action::shoot(0) : Action::move(Vector2f(15000, 8000));
+}
+
+static void BM_BranchSnapshot(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)));
+  updateTargets(game);
+  SnapshotStack<1> snapshots;
+  snapshots.push(game);
+  std::size_t i = 0;
+  for (auto _ : state) {
+    for (int turn = 0; turn < BRANCH_DEPTH; ++turn)
+      simulate(game, branchAction(i++));
+    snapshots.restore(game);
+    benchmark::DoNotOptimize(game.turn);
+  }
+}
+BENCHMARK(BM_BranchSnapshot)->Arg(100)->Arg(200);
+
+static void BM_BranchUndo(benchmark::State &state) {
+  GameState game = benchmarkState(static_cast<int>(state.range(0)));
+  updateTargets(game);
+  std::unique_ptr<UndoLog> log(new UndoLog());
+  std::size_t i = 0;
+  for (auto _ : state) {
+    for (int turn = 0; turn < BRANCH_DEPTH; ++turn)
+      simulate(game, branchAction(i++), *log);
+    while (log->turns() > 0)
+      log->undo(game);
+    benchmark::DoNotOptimize(game.turn);
+  }
+}
+BENCHMARK(BM_BranchUndo)->Arg(100)->Arg(200);
+}
@@ -0,0 +1,120 @@
+#include "Vector2.hpp"
+#include "benchmark/benchmark.h"
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return 256 vectors spread over the map, none of them null.
+*/
+template <typename T> static const Vector2<T> *sampleVectors() {
+  static Vector2<T> vectors[256];
+  for (int i = 0; i < 256; ++i)
+    vectors[i].set(1 + i * 6151 % 16000, 1 + i * 3571 % 9000);
+  return vectors;
+}
+
+template <typename T> static void BM_Magnitude(benchmark::State &state) {
+  const Vector2<T> *vectors = sampleVectors<T>();
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(vectors[i++ & 255].magnitude());
+}
+BENCHMARK_TEMPLATE(BM_Magnitude, int);
+BENCHMARK_TEMPLATE(BM_Magnitude, float);
+BENCHMARK_TEMPLATE(BM_Magnitude, double);
+
+template <typename T> static void BM_Distance(benchmark::State &state) {
+  const Vector2<T> *vectors = sampleVectors<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        Vector2<T>::distance(vectors[i & 255], vectors[(i + 1) & 255]));
+    ++i;
+  }
+}
+BENCHMARK_TEMPLATE(BM_Distance, int);
+BENCHMARK_TEMPLATE(BM_Distance, float);
+BENCHMARK_TEMPLATE(BM_Distance, double);
+
+template <typename T> static void BM_Normalized(benchmark::State &state) {
+  const Vector2<T> *vectors = sampleVectors<T>();
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(vectors[i++ & 255].normalized());
+}
+BENCHMARK_TEMPLATE(BM_Normalized, int);
+BENCHMARK_TEMPLATE(BM_Normalized, float);
+BENCHMARK_TEMPLATE(BM_Normalized, double);
+
+static void BM_NormalizedFast(benchmark::State &state) {
+  const Vector2f *vectors = sampleVectors<float>();
+  std::size_t i = 0;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(vectors[i++ & 255].normalized<FastMath>());
+}
+BENCHMARK(BM_NormalizedFast);
+
+template <typename T> static void BM_Angle(benchmark::State &state) {
+  const Vector2<T> *vectors = sampleVectors<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        Vector2<T>::angle(vectors[i & 255], vectors[(i + 1) & 255]));
+    ++i;
+  }
+}
+BENCHMARK_TEMPLATE(BM_Angle, int);
+BENCHMARK_TEMPLATE(BM_Angle, float);
+BENCHMARK_TEMPLATE(BM_Angle, double);
+
+static void BM_AngleFast(benchmark::State &state) {
+  const Vector2f *vectors = sampleVectors<float>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Vector2f::angle<FastMath>(
+        vectors[i & 255], vectors[(i + 1) & 255]));
+    ++i;
+  }
+}
+BENCHMARK(BM_AngleFast);
+
+template <typename T> static void BM_Lerp(benchmark::State &state) {
+  const Vector2<T> *vectors = sampleVectors<T>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Vector2<T>::lerp(
+        vectors[i & 255], vectors[(i + 1) & 255], (i & 15) / 15.0f));
+    ++i;
+  }
+}
+BENCHMARK_TEMPLATE(BM_Lerp, int);
+BENCHMARK_TEMPLATE(BM_Lerp, float);
+BENCHMARK_TEMPLATE(BM_Lerp, double);
+
+// A move of 1000 towards the next vector : in floats, then truncated like the
+// referee, against the exact integer step.
+static void BM_MoveTruncatedFloat(benchmark::State &state) {
+  const Vector2f *vectors = sampleVectors<float>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Vector2f position = vectors[i & 255];
+    Vector2f direction = vectors[(i + 1) & 255] - position;
+    position += direction * (1000 / direction.magnitude());
+    benchmark::DoNotOptimize(Vector2i(position));
+    ++i;
+  }
+}
+BENCHMARK(BM_MoveTruncatedFloat);
+
+static void BM_StepTowardsInt(benchmark::State &state) {
+  const Vector2i *vectors = sampleVectors<int>();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Vector2i position = vectors[i & 255];
+    stepTowards(position, vectors[(i + 1) & 255], 1000);
+    benchmark::DoNotOptimize(position);
+    ++i;
+  }
+}
+BENCHMARK(BM_StepTowardsInt);
+}
@@ -0,0 +1,65 @@
+#ifndef ALIVEMASK_H
+#define ALIVEMASK_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A fixed-capacity set of slots stored as 64-bit words, one bit per
+* slot. Reads like an array of bool, and finds the next set slot with a count
+* of trailing zeros instead of a loop over all slots.
+*/
+template <std::size_t Capacity> class AliveMask {
+
+public:
+  static const std::size_t WORDS = (Capacity + 63) / 64;
+
+  std::uint64_t words[WORDS];
+
+  /*!
+  * \brief Initialize to no slot set.
+  */
+  AliveMask(void);
+
+  /*!
+  * \brief Unset all slots.
+  */
+  void clear();
+
+  /*!
+  * \brief Set a slot.
+  * \param i The slot, less than Capacity.
+  */
+  void set(std::size_t i);
+
+  /*!
+  * \brief Unset a slot.
+  * \param i The slot, less than Capacity.
+  */
+  void reset(std::size_t i);
+
+  /*!
+  * \brief Return true if a slot is set.
+  * \param i The slot, less than Capacity.
+  * \return true if the slot is set.
+  */
+  bool operator[](std::size_t i) const;
+
+  /*!
+  * \brief Return the number of slots set.
+  * \return The number of slots set.
+  */
+  std::size_t count() const;
+
+  /*!
+  * \brief Return the first slot set from a slot on.
+  * \param from The first slot looked at.
+  * \return The slot, Capacity if there is none.
+  */
+  std::size_t next(std::size_t from) const;
+};
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef ANYTIMESEARCH_H
+#define ANYTIMESEARCH_H
+
+#include "TurnClock.hpp"
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief How an anytime search uses the turn.
+*/
+struct AnytimeConfig {
+  /*!
+  * \brief The number of iterations between two reads of the clock.
+  */
+  unsigned checkInterval;
+
+  /*!
+  * \brief The time kept at the end of the turn to print the action.
+  */
+  double safetyMarginMs;
+
+  /*!
+  * \brief Initialize to a check every 64 iterations and a 10 ms margin.
+  */
+  AnytimeConfig(unsigned checkInterval = 64, double safetyMarginMs = 10);
+};
+
+/*!
+* \brief Run search.iterate() until the turn is over, margin included, or
+* until search.isDone() when the search has that method, and return the
+* number of iterations done. The search keeps the best action found so far,
+* which must be valid even if no iteration is done.
+* \param search Any type with a void iterate() method, and optionally a
+* bool isDone() const method.
+* \param clock The clock of the current turn.
+* \param config When the clock is read and how much time is kept.
+* \return The number of iterations done.
+*/
+template <typename Search>
+unsigned long runAnytime(Search &search, const TurnClock &clock,
+                         const AnytimeConfig &config = AnytimeConfig());
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A bump-pointer allocator over one buffer allocated up front. Memory
+* is handed out by moving an offset and is only given back all at once, so
+* allocating costs a few instructions and freeing a whole search tree is O(1).
+*/
+class Arena {
+
+public:
+  /*!
+  * \brief Initialize to an arena without memory, reserve must be called
+  * before allocating.
+  */
+  Arena(void);
+
+  ~Arena();
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  /*!
+  * \brief Allocate the buffer and write it once, so that the pages are
+  * mapped now rather than during a timed turn. Forget all allocations.
+  * \param bytes The size of the buffer.
+  */
+  void reserve(std::size_t bytes);
+
+  /*!
+  * \brief Return aligned memory from the arena.
+  * \param bytes The size of the memory.
+  * \param alignment The alignment of the memory, a power of two.
+  * \return The memory, nullptr if the arena is full.
+  */
+  void *allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /*!
+  * \brief Return the current offset, to give back everything allocated after
+  * it with release.
+  * \return The number of bytes used.
+  */
+  std::size_t mark() const;
+
+  /*!
+  * \brief Give back everything allocated after a mark.
+  * \param mark A value returned by mark, and not released since.
+  */
+  void release(std::size_t mark);
+
+  /*!
+  * \brief Give back everything, in O(1).
+  */
+  void reset();
+
+  std::size_t capacity() const;
+  std::size_t used() const;
+
+  /*!
+  * \brief Return the most bytes used at once since reserve.
+  * \return The peak usage in bytes.
+  */
+  std::size_t peak() const;
+
+private:
+  unsigned char *buffer;
+  std::size_t size;
+  std::size_t offset;
+  std::size_t highWater;
+};
+
+/*!
+* \brief Search tree nodes allocated one by one from an arena, which must not
+* be used for anything else, so that they form a contiguous array addressed by
+* index. Node must be trivially copyable and hold the links of the tree :
+* - Index firstChild : its first child, NONE if it has none.
+* - Index nextSibling : the next child of its parent, NONE if it is the last.
+*/
+template <typename Node> class NodePool {
+
+public:
+  typedef std::int32_t Index;
+
+  static const Index NONE = -1;
+
+  /*!
+  * \brief Initialize to an empty pool allocating from an arena.
+  * \param arena The arena, reserved and owned by the pool.
+  */
+  explicit NodePool(Arena &arena);
+
+  /*!
+  * \brief Return the number of nodes in the pool.
+  * \return The number of nodes.
+  */
+  Index size() const;
+
+  /*!
+  * \brief Remove all nodes, in O(1).
+  */
+  void clear();
+
+  /*!
+  * \brief Add a node, with no child and no sibling, the other members are
+  * left as they are.
+  * \return The index of the node, NONE if the arena is full.
+  */
+  Index create();
+
+  Node &operator[](Index i);
+  const Node &operator[](Index i) const;
+
+  /*!
+  * \brief Keep only a subtree, moved to the front of the pool in breadth
+  * first order so that its root gets index 0.
+  * \param root The root of the subtree to keep, NONE to keep nothing.
+  * \return The number of nodes kept, 0 if the arena is too full to copy the
+  * subtree, and then the pool is cleared.
+  */
+  Index keepSubtree(Index root);
+
+private:
+  Arena &arena;
+  Node *nodes;
+  Index count;
+};
+}
+
+#endif
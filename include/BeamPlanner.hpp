@@ -0,0 +1,206 @@
+#ifndef BEAMPLANNER_H
+#define BEAMPLANNER_H
+
+#include "Simulator.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Beam search : the states reached after each turn are ranked with
+* evaluate and only the best width of them are expanded the next turn. The
+* children of a state are a SHOOT at each alive enemy and MOVES moves, in the
+* 4 directions and the 4 diagonals at RADII distances. Children equal to a
+* state already in the layer are dropped by hashing them. The game is
+* deterministic, so a state is simulated once and kept in the beam.
+*
+* States are ranked with the shots of the root : the bonus drops with each
+* shot at once, and lines shooting to save data would be pruned before the
+* data is saved. The best sequence is picked with the real value.
+*
+* One iteration simulates one child, so the search stops anytime. A search
+* starts MIN_WIDTH wide and is played again twice as wide each time it
+* reaches the last turn, until it is the width of the planner. The beams are
+* allocated with the planner for that width.
+*/
+class BeamPlanner {
+
+public:
+  static const int DEFAULT_WIDTH = 64;
+  static const int DEFAULT_DEPTH = 6;
+  static const int MIN_WIDTH = 8;
+  static const int RADII = 3;
+  static const int MOVES = 8 * RADII;
+
+  /*!
+  * \brief Initialize a planner with no turn.
+  * \param seed Unused, the search is deterministic. Taken like the other
+  * planners, for ParallelPlanner.
+  * \param width The number of states kept per turn by the widest search.
+  * \param depth The number of turns searched.
+  */
+  explicit BeamPlanner(unsigned seed = 0, int width = DEFAULT_WIDTH,
+                       int depth = DEFAULT_DEPTH);
+
+  /*!
+  * \brief Start a new turn from root, and expand the root so that
+  * bestAction is a searched action. The beam is built again from scratch,
+  * starting MIN_WIDTH wide : nothing is kept from the previous turn.
+  * \param root The state parsed this turn.
+  * \param played The action played the previous turn, unused.
+  */
+  void reset(const GameState &root, const Action &played);
+
+  /*!
+  * \brief Start a new turn from root, rebuilding the beam from scratch.
+  * \param root The state parsed this turn.
+  */
+  void reset(const GameState &root);
+
+  /*!
+  * \brief Simulate the next child of the layer. Does nothing once the
+  * widest search is over.
+  */
+  void iterate();
+
+  /*!
+  * \brief Return the first action of the best sequence of the last search
+  * over, or the best action of the root before that.
+  * \return The action to play this turn.
+  */
+  Action bestAction() const;
+
+  /*!
+  * \brief Return the value of the state bestAction leads to.
+  * \return The value of the best sequence.
+  */
+  float bestValue() const;
+
+  /*!
+  * \brief Return the number of children simulated since the last reset.
+  * \return The number of states simulated this turn.
+  */
+  unsigned long rollouts() const;
+
+  /*!
+  * \brief Write what the search knows about the actions of the root.
+  * \param out Receives the statistics.
+  * \param capacity The capacity of out.
+  * \return The number of actions written.
+  */
+  int rootStatistics(ActionStatistics *out, int capacity) const;
+
+  /*!
+  * \brief Return the width of the search going on.
+  */
+  int width() const;
+
+  /*!
+  * \brief Return true once the widest search is over. runAnytime stops
+  * there.
+  */
+  bool isDone() const;
+
+  /*!
+  * \brief Return the number of children dropped this turn because an equal
+  * state was already in their layer.
+  */
+  unsigned long duplicates() const;
+
+private:
+  /*!
+  * \brief A state of a beam, with the first action of the sequence leading
+  * to it.
+  */
+  struct Node {
+    GameState state;
+    Action first;
+
+    /*!
+    * \brief The value of state with the shots of the root.
+    */
+    float value;
+  };
+
+  const int maxWidth;
+  const int depth;
+  Vector2f moves[MOVES];
+
+  GameState root;
+  GameState scratch;
+
+  /*!
+  * \brief The layer expanded and the layer filled, maxWidth nodes each.
+  */
+  std::vector<Node> layers[2];
+  int current;
+  int currentCount;
+  int nextCount;
+
+  /*!
+  * \brief The worst node of the next layer, replaced once it is full.
+  */
+  int nextWorst;
+
+  /*!
+  * \brief The nodes of the current layer, best first.
+  */
+  std::vector<int> order;
+
+  int searchWidth;
+  int layer;
+  int parent;
+  int child;
+  bool done;
+
+  /*!
+  * \brief The hashes of the states of the next layer, open addressed. A
+  * slot is used when its stamp is the stamp of the layer, so starting a
+  * layer clears the table in O(1).
+  */
+  std::vector<std::uint64_t> seenHashes;
+  std::vector<std::uint32_t> seenStamps;
+  std::uint32_t stamp;
+
+  Action best;
+  float bestSequenceValue;
+  Action searchBest;
+  float searchBestValue;
+  int searchBestLayer;
+
+  unsigned long rolloutCount;
+  unsigned long duplicateCount;
+
+  /*!
+  * \brief Start a search of searchWidth from the root.
+  */
+  void startSearch();
+
+  /*!
+  * \brief Make the next layer the current one, or end the search after
+  * the last turn.
+  */
+  void nextLayer();
+
+  /*!
+  * \brief Add state to the next layer if it is new and among the best.
+  * \param state A child of the current layer.
+  * \param first The first action of the sequence leading to state.
+  */
+  void offer(const GameState &state, const Action &first);
+
+  /*!
+  * \brief Return false if hash is already in the next layer, else add it.
+  */
+  bool insertSeen(std::uint64_t hash);
+
+  /*!
+  * \brief Return a hash of what decides the future of state : Wolff, the
+  * alive entities with the enemy lives, and the shots.
+  */
+  static std::uint64_t hashState(const GameState &state);
+};
+}
+
+#endif
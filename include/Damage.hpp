@@ -0,0 +1,93 @@
+#ifndef DAMAGE_H
+#define DAMAGE_H
+
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return the damage done by a shot : round(125000 / distance^1.2).
+* The reference formula, see shotDamageSquared for simulations.
+* \param distance The distance between Wolff and the enemy.
+* \return The damage done.
+*/
+int shotDamage(float distance);
+
+/*!
+* \brief The damage of a shot by squared distance, without square root nor
+* pow. The squared distances are bucketed by their float bits : the exponent
+* and the SUBDIVISION_BITS high bits of the mantissa, so that the damage
+* changes by less than 1 within a bucket. A bucket holds the lowest damage of
+* its distances, and the largest squared distance of every damage decides
+* whether to add 1. Both are computed once from shotDamage, the results are
+* exactly those of shotDamage(Vector2f::distance(...)).
+*/
+class DamageTable {
+
+public:
+  /*!
+  * \brief Squared distances below 2^MIN_EXPONENT (distance 256) or from
+  * 2^MAX_EXPONENT (distance 23170, beyond the map) are computed with the
+  * formula.
+  */
+  static const int MIN_EXPONENT = 16;
+  static const int MAX_EXPONENT = 29;
+  static const int SUBDIVISION_BITS = 8;
+  static const int BUCKETS = (MAX_EXPONENT - MIN_EXPONENT) << SUBDIVISION_BITS;
+
+  /*!
+  * \brief The highest damage of the table, above the damage at distance 256.
+  */
+  static const int MAX_DAMAGE = 255;
+
+  /*!
+  * \brief Compute the table, about a millisecond.
+  */
+  DamageTable();
+
+  /*!
+  * \brief Return the damage done by a shot.
+  * \param squaredDistance The squared distance between Wolff and the enemy.
+  * \return The damage done, shotDamage of the distance.
+  */
+  int damage(float squaredDistance) const;
+
+  /*!
+  * \brief Return the largest squared distance where a shot does damage.
+  * \param damage The damage, in [1, MAX_DAMAGE].
+  * \return The largest squared distance.
+  */
+  float reach(int damage) const;
+
+private:
+  /*!
+  * \brief The lowest damage of every bucket.
+  */
+  std::uint8_t buckets[BUCKETS];
+
+  /*!
+  * \brief The largest squared distance of every damage, the first unused.
+  */
+  float thresholds[MAX_DAMAGE + 2];
+};
+
+/*!
+* \brief Return the damage done by a shot from the shared table, the same as
+* shotDamage(Vector2f::distance(...)) but several times faster.
+* \param squaredDistance The squared distance between Wolff and the enemy.
+* \return The damage done.
+*/
+int shotDamageSquared(float squaredDistance);
+
+/*!
+* \brief Return the number of shots from the same distance needed to kill an
+* enemy.
+* \param life The life of the enemy.
+* \param squaredDistance The squared distance between Wolff and the enemy.
+* \return The number of shots, 0 if life is not positive, -1 if the enemy is
+* too far to be damaged.
+*/
+int shotsToKill(int life, float squaredDistance);
+}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef DIVERGENCE_H
+#define DIVERGENCE_H
+
+#include "Simulator.hpp"
+#include <iosfwd>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief The differences between the state predicted for a turn and the
+* state parsed at that turn. Entities are matched by id.
+*/
+struct Divergence {
+  /*!
+  * \brief The distance between the predicted and the parsed Wolff.
+  */
+  float wolffError;
+
+  /*!
+  * \brief The number of enemies alive in both states.
+  */
+  int enemies;
+
+  /*!
+  * \brief The number of enemies alive in both states somewhere else.
+  */
+  int enemiesMoved;
+
+  /*!
+  * \brief The largest distance between a predicted and a parsed enemy.
+  */
+  float maxEnemyError;
+
+  /*!
+  * \brief The number of enemies alive in both states with another life.
+  */
+  int livesChanged;
+
+  /*!
+  * \brief The number of enemies alive in one state only.
+  */
+  int enemiesMissed;
+
+  /*!
+  * \brief The number of data points alive in one state only.
+  */
+  int dataMissed;
+
+  /*!
+  * \brief Initialize to no difference.
+  */
+  Divergence(void);
+
+  /*!
+  * \brief Return true if the states hold the same entities, at the same
+  * positions with the same lives.
+  * \return true if the prediction was exact.
+  */
+  bool exact() const;
+};
+
+/*!
+* \brief Keep the state predicted for the next turn, the root simulated with
+* the action played, and compare it with the state parsed at that turn. The
+* turn loop adopts the prediction when it was exact : its slots stay those of
+* the previous turn, dead entities included, so the planners keep their
+* trees and the enemies their targets.
+*/
+class DivergenceTracker {
+
+public:
+  /*!
+  * \brief The number of diverging enemies printed per turn.
+  */
+  static const int MAX_PRINTED_ENEMIES = 4;
+
+  /*!
+  * \brief Initialize a tracker with no prediction.
+  */
+  DivergenceTracker(void);
+
+  /*!
+  * \brief Predict the next turn.
+  * \param root The state of this turn.
+  * \param action The action played this turn.
+  */
+  void predict(const GameState &root, const Action &action);
+
+  /*!
+  * \brief Return true if a turn was predicted and not compared yet.
+  * \return true if compare can be called.
+  */
+  bool hasPrediction() const;
+
+  /*!
+  * \brief Compare the prediction with the state parsed, and add the
+  * differences to the totals of the game.
+  * \param observed The state parsed this turn.
+  * \return The differences.
+  */
+  const Divergence &compare(const GameState &observed);
+
+  /*!
+  * \brief Return the state predicted for the turn last compared.
+  * \return The predicted state.
+  */
+  const GameState &prediction() const;
+
+  /*!
+  * \brief Print the differences of the turn last compared : a line of
+  * counts, then the enemies that diverged.
+  * \param output Where to print.
+  */
+  void printTurn(std::ostream &output) const;
+
+  /*!
+  * \brief Print the totals of the game on one line.
+  * \param output Where to print.
+  */
+  void printTotals(std::ostream &output) const;
+
+  /*!
+  * \brief Return the number of turns compared.
+  */
+  int turns() const;
+
+  /*!
+  * \brief Return the number of turns predicted exactly.
+  */
+  int exactTurns() const;
+
+private:
+  GameState predicted;
+  bool pending;
+  Divergence last;
+
+  /*!
+  * \brief The ids of the diverging enemies of the last turn, their
+  * predicted and parsed positions and lives.
+  */
+  int printedIds[MAX_PRINTED_ENEMIES];
+  Vector2f printedPredicted[MAX_PRINTED_ENEMIES];
+  Vector2f printedObserved[MAX_PRINTED_ENEMIES];
+  int printedLives[MAX_PRINTED_ENEMIES][2];
+  int printed;
+
+  int compared;
+  int exactCount;
+  int wolffErrors;
+  int enemiesMoved;
+  int livesChanged;
+  int entitiesMissed;
+  float maxEnemyError;
+};
+}
+
+#endif
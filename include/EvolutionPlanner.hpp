@@ -0,0 +1,156 @@
+#ifndef EVOLUTIONPLANNER_H
+#define EVOLUTIONPLANNER_H
+
+#include "Random.hpp"
+#include "Simulator.hpp"
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief One action of a genome, relative to where Wolff is when it is
+* played : a MOVE in a direction and at a distance, or a SHOOT at an enemy
+* slot. A SHOOT at a dead enemy shoots the closest alive one instead.
+*/
+struct Gene {
+  enum Kind { MOVE, SHOOT };
+
+  std::uint8_t kind;
+  std::uint8_t enemy;
+
+  /*!
+  * \brief The direction of a MOVE in 1/65536 of a turn.
+  */
+  std::uint16_t angle;
+
+  /*!
+  * \brief The length of a MOVE, at most WOLFF_STEP.
+  */
+  std::uint16_t distance;
+
+  /*!
+  * \brief Return a gene made from four random numbers.
+  * \param bits Four random 32-bit numbers.
+  * \param enemies The number of enemy slots.
+  * \return A random MOVE or SHOOT gene.
+  */
+  static Gene fromBits(const std::uint32_t *bits, int enemies);
+
+  /*!
+  * \brief Return the action this gene plays in state.
+  * \param state The state the action is played from.
+  * \return The action to simulate.
+  */
+  Action decode(const GameState &state) const;
+};
+
+/*!
+* \brief Rolling horizon evolutionary planner : a steady-state genetic
+* algorithm over fixed-length sequences of genes. The population is allocated
+* once with the planner and shifted by one gene at each turn, so the work of
+* a turn seeds the next one.
+*/
+class EvolutionPlanner {
+
+public:
+  /*!
+  * \brief The number of genes of a genome.
+  */
+  static const int HORIZON = 8;
+  static const int POPULATION = 24;
+  static const int TOURNAMENT = 3;
+
+  /*!
+  * \brief Initialize a planner with no turn.
+  * \param seed The seed of the random generator.
+  */
+  explicit EvolutionPlanner(unsigned seed = 0);
+
+  /*!
+  * \brief Start a new turn from root : shift by one gene the genomes that
+  * start with the action played, draw the others again, and evaluate them.
+  * \param root The state parsed this turn.
+  * \param played The action played the previous turn.
+  */
+  void reset(const GameState &root, const Action &played);
+
+  /*!
+  * \brief Start a new turn from root, after playing bestAction.
+  * \param root The state parsed this turn.
+  */
+  void reset(const GameState &root);
+
+  /*!
+  * \brief Breed one child from two parents picked by tournament, and replace
+  * the worst genome with it if it is better.
+  */
+  void iterate();
+
+  /*!
+  * \brief Return the first action of the best genome.
+  * \return The action to play this turn.
+  */
+  Action bestAction() const;
+
+  /*!
+  * \brief Return the value of the best genome.
+  * \return The value of the best genome.
+  */
+  float bestValue() const;
+
+  /*!
+  * \brief Return the number of genomes evaluated since the last reset.
+  * \return The number of genomes evaluated this turn.
+  */
+  unsigned long rollouts() const;
+
+  /*!
+  * \brief Write what the search knows about the actions of the root.
+  * \param out Receives the statistics.
+  * \param capacity The capacity of out.
+  * \return The number of actions written.
+  */
+  int rootStatistics(ActionStatistics *out, int capacity) const;
+
+private:
+  struct Genome {
+    Gene genes[HORIZON];
+    float value;
+  };
+
+  GameState root;
+  GameState scratch;
+  Genome population[POPULATION];
+  Genome child;
+  int best;
+  int worst;
+  bool initialized;
+  unsigned long rolloutCount;
+  FastRandom random;
+
+  /*!
+  * \brief Return a random gene.
+  * \return A random MOVE or SHOOT gene.
+  */
+  Gene randomGene();
+
+  /*!
+  * \brief Return the genome winning a tournament.
+  * \return The index of the winner in the population.
+  */
+  int tournament();
+
+  /*!
+  * \brief Play a genome from the root and store its value.
+  * \param genome The genome to evaluate.
+  */
+  void evaluate(Genome &genome);
+
+  /*!
+  * \brief Find the best and the worst genomes of the population.
+  */
+  void rank();
+};
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef INPUTREADER_H
+#define INPUTREADER_H
+
+#include "Simulator.hpp"
+#include "Vector2.hpp"
+#include <cstddef>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Read integers from a file descriptor through a fixed buffer, without
+* streams, locales or allocations.
+*/
+class InputReader {
+
+public:
+  static const std::size_t BUFFER_SIZE = 1 << 16;
+
+  /*!
+  * \brief Initialize to read from a file descriptor.
+  * \param fd The file descriptor to read from, stdin by default.
+  */
+  explicit InputReader(int fd = 0);
+
+  /*!
+  * \brief Skip the separators and wait until the next integer starts, so that
+  * reading the turn after it does not wait for the referee.
+  * \return false if the input ended.
+  */
+  bool waitInput();
+
+  /*!
+  * \brief Extract the next integer, skipping anything before it.
+  * \param value Receives the integer.
+  * \return false if the input ended before an integer was found.
+  */
+  bool readInt(int &value);
+
+  /*!
+  * \brief Extract the next two integers into the x and y components of v.
+  * \param v The vector receiving the components.
+  * \return false if the input ended before both components were found.
+  */
+  template <typename T> bool readVector2(Vector2<T> &v);
+
+  /*!
+  * \brief Extract a whole turn input into state : Wolff's position, the data
+  * points and the enemies. The counters of state are left untouched.
+  * \param state The state receiving the turn, cleared first.
+  * \return false if the input ended before the turn was complete, or if it
+  * holds more data points or enemies than a state, or a negative count.
+  */
+  bool readTurn(GameState &state);
+
+  /*!
+  * \brief Return true once the input ended.
+  * \return true if the input ended.
+  */
+  bool eof() const;
+
+  /*!
+  * \brief Extract the next integer into value.
+  * \param input The reader.
+  * \param value Receives the integer.
+  * \return The reader.
+  */
+  friend InputReader &operator>>(InputReader &input, int &value) {
+    input.readInt(value);
+    return input;
+  }
+
+  /*!
+  * \brief Extract the x and y components from the reader into v.
+  * \param input The reader.
+  * \param v The vector in which we insert x and y components.
+  * \return The reader.
+  */
+  template <typename T>
+  friend InputReader &operator>>(InputReader &input, Vector2<T> &v) {
+    input.readVector2(v);
+    return input;
+  }
+
+private:
+  int fd;
+  std::size_t position;
+  std::size_t end;
+  bool ended;
+  char buffer[BUFFER_SIZE];
+
+  /*!
+  * \brief Read the next chunk of input in the buffer.
+  * \return false if there is nothing left to read.
+  */
+  bool refill();
+};
+}
+
+#endif
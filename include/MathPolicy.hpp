@@ -0,0 +1,106 @@
+#ifndef MATHPOLICY_H
+#define MATHPOLICY_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#define FUZZY_HAS_RSQRTSS
+#endif
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Math functions of the standard library, as precise as the types
+* allow. The default policy of Vector2.
+*/
+struct PreciseMath {
+  /*!
+  * \brief Vectors are normalized by dividing by their length.
+  */
+  static constexpr bool PREFERS_RSQRT = false;
+
+  /*!
+  * \brief Return the square root of x.
+  */
+  static double sqrt(double x) { return std::sqrt(x); }
+
+  /*!
+  * \brief Return 1 / sqrt(x).
+  */
+  static double rsqrt(double x) { return 1 / std::sqrt(x); }
+
+  /*!
+  * \brief Return the arc cosine of x in radians.
+  */
+  static double acos(double x) { return std::acos(x); }
+
+  /*!
+  * \brief Return the angle of the vector (x, y) in radians, in [-pi, pi].
+  */
+  static double atan2(double y, double x) { return std::atan2(y, x); }
+};
+
+/*!
+* \brief Approximations for searches, where results only need to rank
+* correctly. Maximum errors :
+* - rsqrt : relative error below 2e-6 (rsqrtss and one Newton step, or the
+*   bit trick and two Newton steps without SSE).
+* - sqrt : relative error below 2e-6, exactly 0 for x <= 0.
+* - acos : absolute error below 7e-5 radians (Abramowitz and Stegun 4.4.45).
+* - atan2 : absolute error below 1e-5 radians (minimax polynomial of atan on
+*   [-1, 1]).
+*/
+struct FastMath {
+  static constexpr bool PREFERS_RSQRT = true;
+
+  static float rsqrt(float x) {
+#ifdef FUZZY_HAS_RSQRTSS
+    float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return r * (1.5f - 0.5f * x * r * r);
+#else
+    std::uint32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x5f375a86 - (i >> 1);
+    float r;
+    std::memcpy(&r, &i, sizeof(r));
+    r = r * (1.5f - 0.5f * x * r * r);
+    return r * (1.5f - 0.5f * x * r * r);
+#endif
+  }
+
+  static float sqrt(float x) { return x <= 0 ? 0 : x * rsqrt(x); }
+
+  static float acos(float x) {
+    float a = std::fabs(x);
+    float r = sqrt(1 - a) *
+              (1.5707288f + a * (-0.2121144f + a * (0.0742610f -
+                                                    a * 0.0187293f)));
+    return x < 0 ? 3.14159265f - r : r;
+  }
+
+  static float atan2(float y, float x) {
+    float ax = std::fabs(x);
+    float ay = std::fabs(y);
+    if (ax == 0 && ay == 0)
+      return 0;
+    // atan of the ratio in [0, 1], then unfolded to the right octant.
+    float z = ax > ay ? ay / ax : ax / ay;
+    float z2 = z * z;
+    float r =
+        z * (0.99997726f +
+             z2 * (-0.33262347f +
+                   z2 * (0.19354346f +
+                         z2 * (-0.11643287f +
+                               z2 * (0.05265332f + z2 * -0.01172120f)))));
+    if (ay > ax)
+      r = 1.57079633f - r;
+    if (x < 0)
+      r = 3.14159265f - r;
+    return y < 0 ? -r : r;
+  }
+};
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef MCTSPLANNER_H
+#define MCTSPLANNER_H
+
+#include "Arena.hpp"
+#include "Random.hpp"
+#include "Simulator.hpp"
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A node of the MCTS tree : the action leading to it and the
+* statistics of the playouts through it. States are not stored, they are
+* simulated again from the root along the path.
+*/
+struct MctsNode {
+  NodePool<MctsNode>::Index firstChild;
+  NodePool<MctsNode>::Index nextSibling;
+  Action action;
+
+  /*!
+  * \brief The angle the compass moves of the children are rotated by.
+  */
+  float rotation;
+
+  float valueSum;
+  int visits;
+
+  /*!
+  * \brief The number of candidate actions already added as children.
+  */
+  std::uint16_t expanded;
+};
+
+/*!
+* \brief Monte Carlo Tree Search with progressive widening : a node with n
+* visits has at most 1 + WIDENING * sqrt(n) children, added from a list of
+* candidates that interleaves a SHOOT at each alive enemy with MOVE samples :
+* away from and towards the closest enemy, the 8 compass directions rotated
+* by a random angle, then random points. Children are selected with UCB1 and
+* leaves are evaluated with a random playout. Nodes live in a NodePool, and
+* the subtree of the action played is kept for the next turn when no entity
+* left the game.
+*/
+class MctsPlanner {
+
+public:
+  /*!
+  * \brief The size of the arena reserved on the first turn.
+  */
+  static const std::size_t ARENA_BYTES = 64 << 20;
+  static const int PLAYOUT_DEPTH = 6;
+  static const int MAX_MOVES = 16;
+  static constexpr float WIDENING = 1.0f;
+  static constexpr float EXPLORATION = 0.7f;
+
+  /*!
+  * \brief Initialize a planner with no turn.
+  * \param arena The arena of the nodes, reserved on the first turn if it is
+  * not already.
+  * \param seed The seed of the random generator.
+  */
+  explicit MctsPlanner(Arena &arena, unsigned seed = 0);
+
+  /*!
+  * \brief Start a new turn from root, reusing the subtree of the action
+  * played when the root has a child for it and the slots of the entities did
+  * not change.
+  * \param root The state parsed this turn.
+  * \param played The action played the previous turn.
+  */
+  void reset(const GameState &root, const Action &played);
+
+  /*!
+  * \brief Start a new turn from root, after playing bestAction.
+  * \param root The state parsed this turn.
+  */
+  void reset(const GameState &root);
+
+  /*!
+  * \brief Select a leaf, expand it and back up the value of a playout.
+  */
+  void iterate();
+
+  /*!
+  * \brief Return the action of the most visited child of the root.
+  * \return The action to play this turn.
+  */
+  Action bestAction() const;
+
+  /*!
+  * \brief Return the mean value of the playouts of the best action.
+  * \return The value of the best action.
+  */
+  float bestValue() const;
+
+  /*!
+  * \brief Return the number of playouts since the last reset.
+  * \return The number of playouts done this turn.
+  */
+  unsigned long rollouts() const;
+
+  /*!
+  * \brief Write what the search knows about the actions of the root.
+  * \param out Receives the statistics.
+  * \param capacity The capacity of out.
+  * \return The number of actions written.
+  */
+  int rootStatistics(ActionStatistics *out, int capacity) const;
+
+  /*!
+  * \brief Return the deepest node selected since the last reset.
+  * \return The depth of the tree, the root being at depth 0.
+  */
+  int depth() const;
+
+  /*!
+  * \brief Return the number of nodes of the tree.
+  * \return The number of nodes.
+  */
+  int nodes() const;
+
+private:
+  typedef NodePool<MctsNode>::Index Index;
+
+  static const int MAX_DEPTH = 64;
+
+  Arena &arena;
+  NodePool<MctsNode> pool;
+  GameState root;
+  GameState scratch;
+  float valueScale;
+  unsigned long playoutCount;
+  int maxDepth;
+  bool hasTree;
+  FastRandom random;
+
+  /*!
+  * \brief Return the child of a node playing an action.
+  * \return The child, NONE if the node has none.
+  */
+  Index findChild(Index node, const Action &action) const;
+
+  /*!
+  * \brief Return the most visited child of a node.
+  * \return The child, NONE if the node has no child.
+  */
+  Index mostVisited(Index node) const;
+
+  /*!
+  * \brief Return the child with the best UCB1 score.
+  */
+  Index select(Index node) const;
+
+  /*!
+  * \brief Add the next candidate action of a node as a child.
+  * \param node The node to expand.
+  * \param state The state of the node.
+  * \return The child, NONE if the pool is full.
+  */
+  Index expand(Index node, const GameState &state);
+
+  /*!
+  * \brief Return the number of candidate actions in a state.
+  */
+  static int candidateCount(const GameState &state);
+
+  /*!
+  * \brief Return the candidate action of a state at an index.
+  * \param state The state the action is played from.
+  * \param index The index of the candidate, less than candidateCount.
+  * \param rotation The angle the compass moves are rotated by.
+  * \return The candidate action.
+  */
+  Action candidate(const GameState &state, int index, float rotation);
+
+  /*!
+  * \brief Return a random action playable in state, for playouts.
+  */
+  Action randomAction(const GameState &state);
+
+  /*!
+  * \brief Create a node with no child and no statistic.
+  */
+  Index createNode(const Action &action);
+};
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef PARALLELPLANNER_H
+#define PARALLELPLANNER_H
+
+#include "AnytimeSearch.hpp"
+#include "Arena.hpp"
+#include "Simulator.hpp"
+#include "TurnClock.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Root-parallel search : each thread runs its own Planner, with its own
+* random generator and arena, from the same root until the deadline, then
+* the statistics of the actions of their roots are merged. The action with
+* the most visits wins, the best mean value breaking ties. The threads are
+* started with the planner and parked on a condition variable between the
+* turns, the calling thread runs the first planner. Only built with
+* -DFUZZY_THREADS, the submission stays single-threaded.
+*/
+template <typename Planner> class ParallelPlanner {
+
+public:
+  static const int MAX_THREADS = 64;
+
+  /*!
+  * \brief The most root actions merged per thread.
+  */
+  static const int MAX_ACTIONS = 256;
+
+  /*!
+  * \brief Initialize the planners of the threads.
+  * \param threads The number of threads, clamped to [1, MAX_THREADS].
+  * \param seed The seed of the first planner, the others get the next ones.
+  */
+  explicit ParallelPlanner(int threads, unsigned seed = 0);
+
+  ~ParallelPlanner();
+
+  /*!
+  * \brief Return the number of threads.
+  * \return The number of threads.
+  */
+  int threads() const;
+
+  /*!
+  * \brief Start a new turn from root in every planner. Each planner keeps
+  * what it searched after the action played, which is not its own best
+  * action when the threads disagreed.
+  * \param root The state parsed this turn.
+  * \param played The action played the previous turn.
+  */
+  void reset(const GameState &root, const Action &played);
+
+  /*!
+  * \brief Start a new turn from root in every planner, after playing the
+  * merged bestAction.
+  * \param root The state parsed this turn.
+  */
+  void reset(const GameState &root);
+
+  /*!
+  * \brief Run every planner in its thread until the turn is over, then merge
+  * their root statistics.
+  * \param clock The clock of the current turn.
+  * \param config When the clock is read and how much time is kept.
+  * \return The number of iterations done by all threads.
+  */
+  unsigned long run(const TurnClock &clock,
+                    const AnytimeConfig &config = AnytimeConfig());
+
+  /*!
+  * \brief Return the merged action with the most visits.
+  * \return The action to play this turn.
+  */
+  Action bestAction() const;
+
+  /*!
+  * \brief Return the merged mean value of the best action.
+  * \return The value of the best action.
+  */
+  float bestValue() const;
+
+  /*!
+  * \brief Return the number of rollouts of all threads since the last reset.
+  * \return The number of rollouts done this turn.
+  */
+  unsigned long rollouts() const;
+
+private:
+  struct Worker;
+
+  /*!
+  * \brief What the threads do when they are woken up.
+  */
+  enum Task { RESET, RUN, STOP };
+
+  Worker *workers[MAX_THREADS];
+  int count;
+  ActionStatistics best;
+
+  /*!
+  * \brief The task of the threads and its arguments, guarded by mutex. Each
+  * task gets a new generation, and pending counts the threads still on it.
+  */
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  Task task;
+  unsigned generation;
+  int pending;
+  const GameState *taskRoot;
+  const Action *taskPlayed;
+  const TurnClock *taskClock;
+  const AnytimeConfig *taskConfig;
+
+  /*!
+  * \brief Give task to every thread, do it with the first planner, and
+  * wait for the other threads to be done.
+  */
+  void dispatch(Task task);
+
+  /*!
+  * \brief Do the current task with a planner.
+  * \param i The index of the planner.
+  */
+  void perform(int i);
+
+  /*!
+  * \brief The loop of a thread : wait for a task, do it, until STOP.
+  * \param i The index of the planner of the thread.
+  */
+  void work(int i);
+
+  /*!
+  * \brief Merge the root statistics of the planners into best.
+  */
+  void merge();
+};
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef PHASETRACE_H
+#define PHASETRACE_H
+
+/*!
+* \brief The phases of a turn and their tracing, only built with
+* -DFUZZY_TRACE. Without it FUZZY_PHASE expands to nothing, and nothing of it
+* is left in the submission.
+*/
+#ifdef FUZZY_TRACE
+
+#include "TurnClock.hpp"
+#include <cstdint>
+#include <ostream>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief The phases of the turn loop : reading the input, starting the
+* planner on it, which looks for the targets of the enemies, searching, and
+* printing the action.
+*/
+enum Phase { PHASE_PARSE, PHASE_RESET, PHASE_SEARCH, PHASE_OUTPUT, PHASE_COUNT };
+
+/*!
+* \brief Return the name of a phase.
+* \param phase The phase.
+* \return Its lowercase name.
+*/
+const char *phaseName(Phase phase);
+
+/*!
+* \brief Record the ticks of TurnClock::now at which each phase starts and
+* ends in a fixed ring buffer, keeping the last CAPACITY phases, and sum
+* them for the current turn.
+*/
+class PhaseTrace {
+
+public:
+  static const int CAPACITY = 4096;
+
+  /*!
+  * \brief A phase of a turn, between two ticks.
+  */
+  struct Event {
+    Phase phase;
+    int turn;
+    std::uint64_t start;
+    std::uint64_t end;
+  };
+
+  /*!
+  * \brief Initialize to no event, on the first turn.
+  */
+  PhaseTrace(void);
+
+  /*!
+  * \brief Record a phase of the current turn.
+  * \param phase The phase.
+  * \param start The tick at which it started.
+  * \param end The tick at which it ended.
+  */
+  void record(Phase phase, std::uint64_t start, std::uint64_t end);
+
+  /*!
+  * \brief Return the time spent in a phase during the current turn.
+  * \param phase The phase.
+  * \return The time in milliseconds.
+  */
+  double turnMs(Phase phase) const;
+
+  /*!
+  * \brief Write a line with the time of each phase of the current turn,
+  * then start the next turn.
+  * \param out Where the line is written.
+  */
+  void endTurn(std::ostream &out);
+
+  /*!
+  * \brief Return the number of events kept, at most CAPACITY.
+  * \return The number of events kept.
+  */
+  int size() const;
+
+  /*!
+  * \brief Return a kept event, the oldest first.
+  * \param i The index of the event, less than size().
+  * \return The event.
+  */
+  const Event &event(int i) const;
+
+  /*!
+  * \brief Write the kept events in the Chrome trace format, to open in
+  * chrome://tracing or Perfetto.
+  * \param path The path of the file.
+  * \return false if the file could not be written.
+  */
+  bool writeChromeTrace(const char *path) const;
+
+private:
+  Event events[CAPACITY];
+  long count;
+  int turns;
+  std::uint64_t turnTicks[PHASE_COUNT];
+};
+
+/*!
+* \brief Record the phase from its construction to the end of its scope.
+*/
+class ScopedPhase {
+
+public:
+  ScopedPhase(PhaseTrace &trace, Phase phase);
+  ~ScopedPhase();
+
+  ScopedPhase(const ScopedPhase &) = delete;
+  ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+private:
+  PhaseTrace &trace;
+  Phase phase;
+  std::uint64_t start;
+};
+}
+
+#define FUZZY_PHASE_JOIN(a, b) a##b
+#define FUZZY_PHASE_NAME(line) FUZZY_PHASE_JOIN(scopedPhase, line)
+#define FUZZY_PHASE(trace, phase)                                             \
+  fuzzyTelegram::ScopedPhase FUZZY_PHASE_NAME(__LINE__)(trace, phase)
+
+#else
+
+#define FUZZY_PHASE(trace, phase)
+
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include "Vector2.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return the next value of a splitmix64 sequence, to turn any seed into
+* well mixed generator states.
+* \param state The state of the sequence, advanced.
+* \return The next value.
+*/
+std::uint64_t splitMix64(std::uint64_t &state);
+
+/*!
+* \brief Rotate the bits of x left by k.
+*/
+inline std::uint32_t rotateLeft(std::uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+/*!
+* \brief Return the 24 high bits of x as a float in [0, 1).
+*/
+inline float unitFloat(std::uint32_t x) {
+  return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+/*!
+* \brief The xoshiro128** generator : 128 bits of state, a few shifts and two
+* multiplications per 32-bit number. Much faster than std::mt19937 with the
+* std distributions, whose results also differ between standard libraries,
+* while a FastRandom gives the same numbers everywhere for a seed. Can be
+* used as a std UniformRandomBitGenerator.
+*/
+class FastRandom {
+
+public:
+  typedef std::uint32_t result_type;
+
+  /*!
+  * \brief Initialize from a seed, expanded with splitMix64.
+  * \param seed The seed.
+  */
+  explicit FastRandom(std::uint64_t seed = 0);
+
+  /*!
+  * \brief Start the sequence of a seed again.
+  * \param seed The seed.
+  */
+  void seed(std::uint64_t seed);
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+  /*!
+  * \brief Return the next 32 random bits.
+  * \return A number in [0, 2^32).
+  */
+  std::uint32_t operator()();
+
+  /*!
+  * \brief Return a number in [0, bound) with a multiplication and a shift,
+  * without division nor rejection loop. Numbers are biased by less than
+  * bound / 2^32, nothing next to the noise of a rollout.
+  * \param bound The number of values, greater than 0.
+  * \return A number in [0, bound).
+  */
+  std::uint32_t below(std::uint32_t bound);
+
+  /*!
+  * \brief Return a number in [low, high].
+  * \param low The lowest value.
+  * \param high The highest value, not less than low.
+  * \return A number in [low, high].
+  */
+  int range(int low, int high);
+
+  /*!
+  * \brief Return a float in [0, 1) with 24 random bits.
+  * \return A number in [0, 1).
+  */
+  float unit();
+
+  /*!
+  * \brief Return true with probability 1/2.
+  * \return A random bool.
+  */
+  bool coin();
+
+  /*!
+  * \brief Return a vector of length 1 in a uniformly random direction.
+  * \return A unit vector.
+  */
+  Vector2f direction();
+
+  /*!
+  * \brief Return a point uniformly distributed in a disc centered on 0.
+  * \param radius The radius of the disc.
+  * \return A point at most radius away from 0.
+  */
+  Vector2f inDisc(float radius);
+
+private:
+  std::uint32_t s[4];
+};
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef RANDOMBATCH_H
+#define RANDOMBATCH_H
+
+#include "Random.hpp"
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Lanes xoshiro128** generators stepped together, each from its own
+* splitMix64 state, so that filling an array is a loop the compiler
+* vectorizes. At -O3 with AVX2 it fills about as fast as FastRandom, so the
+* planners draw with FastRandom and this one is left out of the submission,
+* for the tests and benchmarks.
+*/
+template <std::size_t Lanes = 8> class FastRandomBatch {
+
+public:
+  /*!
+  * \brief Initialize from a seed, expanded with splitMix64.
+  * \param seed The seed.
+  */
+  explicit FastRandomBatch(std::uint64_t seed = 0);
+
+  /*!
+  * \brief Start the sequences of a seed again.
+  * \param seed The seed.
+  */
+  void seed(std::uint64_t seed);
+
+  /*!
+  * \brief Fill out with random 32-bit numbers.
+  * \param out Receives the numbers.
+  * \param n The number of numbers.
+  */
+  void fill(std::uint32_t *out, std::size_t n);
+
+  /*!
+  * \brief Fill out with numbers in [0, bound), like FastRandom::below.
+  * \param out Receives the numbers.
+  * \param n The number of numbers.
+  * \param bound The number of values, greater than 0.
+  */
+  void fillBelow(std::uint32_t *out, std::size_t n, std::uint32_t bound);
+
+  /*!
+  * \brief Fill out with floats in [0, 1), like FastRandom::unit.
+  * \param out Receives the numbers.
+  * \param n The number of numbers.
+  */
+  void fillUnit(float *out, std::size_t n);
+
+  /*!
+  * \brief Fill xs and ys with points uniformly distributed in a disc. The
+  * random numbers are generated in batch, the cosines and sines one by one.
+  * \param xs Receives the x components.
+  * \param ys Receives the y components.
+  * \param n The number of points.
+  * \param center The center of the disc.
+  * \param radius The radius of the disc.
+  */
+  void fillInDisc(float *xs, float *ys, std::size_t n,
+                  const Vector2f &center, float radius);
+
+private:
+  std::uint32_t s0[Lanes];
+  std::uint32_t s1[Lanes];
+  std::uint32_t s2[Lanes];
+  std::uint32_t s3[Lanes];
+
+  /*!
+  * \brief Write the next number of every lane.
+  * \param out Receives Lanes numbers.
+  */
+  void step(std::uint32_t *out);
+};
+}
+
+#endif
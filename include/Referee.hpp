@@ -0,0 +1,235 @@
+#ifndef REFEREE_H
+#define REFEREE_H
+
+#include "Random.hpp"
+#include "ReplayLog.hpp"
+#include "Simulator.hpp"
+#include "TurnClock.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief How random maps are drawn. Ids follow the slots, like in the game,
+* and no enemy starts close enough to kill Wolff on the first turn.
+*/
+struct MapConfig {
+  int minDataPoints;
+  int maxDataPoints;
+  int minEnemies;
+  int maxEnemies;
+  int minLife;
+  int maxLife;
+
+  /*!
+  * \brief Initialize to 1 to 15 data points and 1 to 30 enemies with 5 to 30
+  * life.
+  */
+  MapConfig(void);
+};
+
+/*!
+* \brief How the referee runs a game.
+*/
+struct RefereeConfig {
+  /*!
+  * \brief The command starting the bot, run with /bin/sh -c.
+  */
+  std::string command;
+
+  /*!
+  * \brief The budgets of the first turn and of the others : 1000 ms and 100
+  * ms by default. A bot answering later loses the game.
+  */
+  double firstTurnBudgetMs;
+  double turnBudgetMs;
+
+  /*!
+  * \brief The number of turns after which the game is stopped.
+  */
+  int maxTurns;
+
+  /*!
+  * \brief Whether the stderr of the bot is kept, it goes to /dev/null
+  * otherwise.
+  */
+  bool showBotErrors;
+
+  /*!
+  * \brief Where playGames logs the turns of each game, as <seed>.rpl. Bots
+  * built with -DFUZZY_REPLAY log theirs as <seed>.bot.rpl. Nothing is logged
+  * when empty.
+  */
+  std::string replayDirectory;
+
+  /*!
+  * \brief Initialize to run ./bin/bot with the deadlines of the game, without
+  * logs.
+  */
+  RefereeConfig(void);
+};
+
+/*!
+* \brief What happened during a game, from the referee's point of view.
+*/
+struct GameResult {
+  enum Outcome { FINISHED, DEAD, TIMEOUT, INVALID, CRASHED, TURN_LIMIT };
+
+  unsigned seed;
+  Outcome outcome;
+  int score;
+  int turns;
+  int shots;
+  int kills;
+  int dataRemaining;
+
+  /*!
+  * \brief The time the bot took to answer each turn, from the end of the
+  * input to the end of its line.
+  */
+  std::vector<double> latenciesMs;
+
+  /*!
+  * \brief What the bot printed when its output was invalid.
+  */
+  std::string invalidOutput;
+
+  /*!
+  * \brief Initialize to a game not played.
+  */
+  GameResult(void);
+};
+
+/*!
+* \brief Return the name of an outcome, to print it.
+* \param outcome The outcome.
+* \return Its lowercase name.
+*/
+const char *outcomeName(GameResult::Outcome outcome);
+
+/*!
+* \brief Draw a map : Wolff, the data points and the enemies with their life,
+* all on integer coordinates.
+* \param random The generator drawing the map.
+* \param config The ranges of the map.
+* \return The first state of the game, with initialTotalLife set.
+*/
+GameState randomMap(FastRandom &random,
+                    const MapConfig &config = MapConfig());
+
+/*!
+* \brief Write the input of a turn in the format the bot reads : Wolff, then
+* the alive data points and the alive enemies, with their ids.
+* \param state The state of the game.
+* \param out Receives the text, replaced.
+*/
+void writeTurnInput(const GameState &state, std::string &out);
+
+/*!
+* \brief Read a line of the bot : MOVE x y or SHOOT id, anything after being
+* a message.
+* \param line The line, without its end of line.
+* \param state The state of the game, to find the slot of the enemy shot.
+* \param action Receives the action.
+* \return false if the line is not a valid action or shoots a dead enemy.
+*/
+bool parseAction(const char *line, const GameState &state, Action &action);
+
+/*!
+* \brief Play a turn with the rules of the game, written apart from
+* simulate so that the referee checks the bot's simulation rather than
+* repeating it : the enemies look for their closest data point every turn,
+* without any cache, and the distances and moves are computed in doubles
+* on the whole coordinates. A bug of simulate shows up in the divergence
+* the bot prints on its stderr. The enemy targets of state are not kept.
+* \param state The state of the game, updated.
+* \param action What Wolff does this turn, a SHOOT at an alive enemy.
+*/
+void playTurn(GameState &state, const Action &action);
+
+/*!
+* \brief A bot running in a child process, talking through pipes.
+*/
+class BotProcess {
+
+public:
+  /*!
+  * \brief Initialize to no process.
+  */
+  BotProcess(void);
+
+  /*!
+  * \brief Stop the process if it is still running.
+  */
+  ~BotProcess();
+
+  BotProcess(const BotProcess &) = delete;
+  BotProcess &operator=(const BotProcess &) = delete;
+
+  /*!
+  * \brief Start command with /bin/sh -c. SIGPIPE is ignored from then on, a
+  * write to a dead bot fails instead.
+  * \param command The command starting the bot.
+  * \param showErrors Whether the stderr of the bot is kept.
+  * \return false if the process could not be started.
+  */
+  bool start(const std::string &command, bool showErrors);
+
+  /*!
+  * \brief Write text to the stdin of the bot.
+  * \param text The text to write.
+  * \return false if the bot stopped reading.
+  */
+  bool send(const std::string &text);
+
+  /*!
+  * \brief Wait for the next line of the bot.
+  * \param line Receives the line, without its end of line.
+  * \param deadline The tick of TurnClock::now after which the wait stops.
+  * \return 1 if a line was read, 0 at the deadline, -1 if the output ended.
+  */
+  int readLine(std::string &line, std::uint64_t deadline);
+
+  /*!
+  * \brief Close the input of the process and wait for it, killing it when it
+  * does not exit within 200 ms.
+  */
+  void stop();
+
+private:
+  int pid;
+  int input;
+  int output;
+  std::string pending;
+};
+
+/*!
+* \brief Play a game of the bot on a map.
+* \param map The first state of the game.
+* \param config The bot and the deadlines.
+* \param replayPrefix Where the game is logged, as replayPrefix.rpl, and
+* where the bot logs it, as replayPrefix.bot.rpl. Nothing is logged when
+* empty.
+* \return The outcome, score and latencies of the game.
+*/
+GameResult playGame(const GameState &map, const RefereeConfig &config,
+                    const std::string &replayPrefix = std::string());
+
+/*!
+* \brief Play games on the maps drawn from seeds, threads games at a time.
+* Each map only depends on its seed, the same with every compiler and
+* standard library, so replays are the same.
+* \param seeds The seed of each game.
+* \param threads The number of games played at once.
+* \param config The bot and the deadlines.
+* \param mapConfig The ranges of the maps.
+* \return The results, in the order of seeds.
+*/
+std::vector<GameResult> playGames(const std::vector<unsigned> &seeds,
+                                  int threads, const RefereeConfig &config,
+                                  const MapConfig &mapConfig = MapConfig());
+}
+
+#endif
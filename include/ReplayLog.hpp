@@ -0,0 +1,230 @@
+#ifndef REPLAYLOG_H
+#define REPLAYLOG_H
+
+#include "Simulator.hpp"
+#include "Vector2.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief The version of the replay format, bumped whenever ReplayTurn or the
+* arrays following it change.
+*/
+const std::uint32_t REPLAY_VERSION = 1;
+
+/*!
+* \brief The action type of a turn the bot did not answer in time or
+* correctly.
+*/
+const std::int32_t REPLAY_NO_ACTION = -1;
+
+/*!
+* \brief The start of a replay file : "FZRP", the version and the size of a
+* ReplayTurn, to refuse files written with another layout. Files are written
+* in the byte order of the machine.
+*/
+struct ReplayHeader {
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t turnSize;
+  std::uint32_t reserved;
+};
+
+/*!
+* \brief A turn of a replay file. It is followed by the alive entities of
+* the input, in input order : the positions then the ids of the data points,
+* and the positions, ids and lives of the enemies. Everything is 4-byte
+* aligned, so that a mapped file is read in place.
+*/
+struct ReplayTurn {
+  /*!
+  * \brief The size of the turn, arrays included.
+  */
+  std::uint32_t size;
+
+  /*!
+  * \brief The number of turns written before this one.
+  */
+  std::int32_t turn;
+  Vector2i wolff;
+  std::int32_t dataCount;
+  std::int32_t enemyCount;
+
+  /*!
+  * \brief Action::MOVE, Action::SHOOT or REPLAY_NO_ACTION.
+  */
+  std::int32_t actionType;
+
+  /*!
+  * \brief The id of the enemy shot, -1 for a MOVE.
+  */
+  std::int32_t target;
+  Vector2i destination;
+
+  /*!
+  * \brief What the search said about the turn, 0 when it is not known.
+  */
+  std::uint32_t rollouts;
+  float value;
+
+  /*!
+  * \brief The time taken to answer.
+  */
+  float elapsedMs;
+};
+
+static_assert(std::is_trivially_copyable<ReplayTurn>::value &&
+                  sizeof(ReplayTurn) % 4 == 0 && alignof(ReplayTurn) == 4,
+              "ReplayTurn must be read in place from 4-byte aligned bytes");
+static_assert(sizeof(Vector2i) == 8 && alignof(Vector2i) == 4,
+              "Vector2i arrays must be read in place");
+
+/*!
+* \brief A turn read from a replay file, pointing into the mapped file.
+*/
+struct ReplayTurnView {
+  const ReplayTurn *turn;
+  const Vector2i *dataPositions;
+  const std::int32_t *dataIds;
+  const Vector2i *enemyPositions;
+  const std::int32_t *enemyIds;
+  const std::int32_t *enemyLives;
+
+  /*!
+  * \brief Rebuild the state the bot parsed this turn. The counters of state
+  * are left untouched, like InputReader::readTurn does.
+  * \param state Receives the turn, cleared first.
+  */
+  void toState(GameState &state) const;
+
+  /*!
+  * \brief Return the action played this turn.
+  * \param state The state of the turn, to find the slot of the enemy shot.
+  * \param action Receives the action.
+  * \return false if the bot did not play.
+  */
+  bool toAction(const GameState &state, Action &action) const;
+};
+
+/*!
+* \brief Append turns to a replay file through a fixed buffer, written when
+* full or when the writer is flushed or closed.
+*/
+class ReplayWriter {
+
+public:
+  static const std::size_t BUFFER_SIZE = 1 << 16;
+
+  /*!
+  * \brief Initialize to no file.
+  */
+  ReplayWriter(void);
+
+  /*!
+  * \brief Flush and close the file.
+  */
+  ~ReplayWriter();
+
+  ReplayWriter(const ReplayWriter &) = delete;
+  ReplayWriter &operator=(const ReplayWriter &) = delete;
+
+  /*!
+  * \brief Create a replay file, replacing any file at path, and write its
+  * header.
+  * \param path The path of the file.
+  * \return false if the file could not be created.
+  */
+  bool open(const char *path);
+
+  /*!
+  * \brief Return true if a file is open.
+  * \return true if turns are written.
+  */
+  bool isOpen() const;
+
+  /*!
+  * \brief Append a turn. Does nothing if no file is open.
+  * \param state The state parsed this turn.
+  * \param action The action played, nullptr if the bot did not play.
+  * \param rollouts The number of rollouts of the search.
+  * \param value The value of the action played.
+  * \param elapsedMs The time taken to answer.
+  * \return false if the buffer could not be written.
+  */
+  bool write(const GameState &state, const Action *action,
+             unsigned long rollouts, float value, double elapsedMs);
+
+  /*!
+  * \brief Write the buffer to the file.
+  * \return false if it could not be written.
+  */
+  bool flush();
+
+  /*!
+  * \brief Flush and close the file.
+  */
+  void close();
+
+private:
+  int fd;
+  int turns;
+  std::size_t used;
+  alignas(4) char buffer[BUFFER_SIZE];
+};
+
+/*!
+* \brief Read a replay file mapped in memory, turn by turn, without copying
+* it.
+*/
+class ReplayReader {
+
+public:
+  /*!
+  * \brief Initialize to no file.
+  */
+  ReplayReader(void);
+
+  /*!
+  * \brief Unmap the file.
+  */
+  ~ReplayReader();
+
+  ReplayReader(const ReplayReader &) = delete;
+  ReplayReader &operator=(const ReplayReader &) = delete;
+
+  /*!
+  * \brief Map a replay file and check its header.
+  * \param path The path of the file.
+  * \return false if the file could not be mapped, or is not a replay file
+  * of this version.
+  */
+  bool open(const char *path);
+
+  /*!
+  * \brief Unmap the file.
+  */
+  void close();
+
+  /*!
+  * \brief Read the next turn.
+  * \param view Receives the turn.
+  * \return false at the end of the file, or if the next turn is cut.
+  */
+  bool next(ReplayTurnView &view);
+
+  /*!
+  * \brief Go back to the first turn.
+  */
+  void rewind();
+
+private:
+  const char *data;
+  std::size_t size;
+  std::size_t offset;
+};
+}
+
+#endif
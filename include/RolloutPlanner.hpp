@@ -0,0 +1,126 @@
+#ifndef ROLLOUTPLANNER_H
+#define ROLLOUTPLANNER_H
+
+#include "Random.hpp"
+#include "Simulator.hpp"
+#include "ThreatMap.hpp"
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Monte Carlo planner : plays random sequences of actions forward with
+* the simulator and keeps the best one. The best sequence of a turn, shifted
+* by one action, is the first candidate of the next turn.
+*/
+class RolloutPlanner {
+
+public:
+  /*!
+  * \brief The number of actions of a sequence.
+  */
+  static const int DEPTH = 8;
+
+  /*!
+  * \brief The number of random first moves tried before keeping one that
+  * the threat map says is not safe.
+  */
+  static const int MOVE_TRIES = 3;
+
+  /*!
+  * \brief Initialize a planner with no turn.
+  * \param seed The seed of the random generator.
+  */
+  explicit RolloutPlanner(unsigned seed = 0);
+
+  /*!
+  * \brief Start a new turn from root, warm started with the best sequence of
+  * the previous turn if it starts with the action played.
+  * \param root The state parsed this turn.
+  * \param played The action played the previous turn.
+  */
+  void reset(const GameState &root, const Action &played);
+
+  /*!
+  * \brief Start a new turn from root, after playing bestAction.
+  * \param root The state parsed this turn.
+  */
+  void reset(const GameState &root);
+
+  /*!
+  * \brief Play one random sequence and keep it if it is the best so far.
+  */
+  void iterate();
+
+  /*!
+  * \brief Return the first action of the best sequence.
+  * \return The action to play this turn.
+  */
+  Action bestAction() const;
+
+  /*!
+  * \brief Return the value of the best sequence.
+  * \return The value of the best sequence.
+  */
+  float bestValue() const;
+
+  /*!
+  * \brief Return the number of actions of the best sequence, fewer than
+  * DEPTH when the game ends before.
+  * \return The number of actions played by the best sequence.
+  */
+  int bestSequenceLength() const;
+
+  /*!
+  * \brief Return the number of sequences played since the last reset.
+  * \return The number of sequences played this turn.
+  */
+  unsigned long rollouts() const;
+
+  /*!
+  * \brief Write what the search knows about the actions of the root.
+  * \param out Receives the statistics.
+  * \param capacity The capacity of out.
+  * \return The number of actions written.
+  */
+  int rootStatistics(ActionStatistics *out, int capacity) const;
+
+private:
+  GameState root;
+  GameState scratch;
+  Action best[DEPTH];
+  Action candidate[DEPTH];
+  float bestSequenceValue;
+  int bestLength;
+  bool hasBest;
+  unsigned long rolloutCount;
+  FastRandom random;
+
+  /*!
+  * \brief The threat map of the root, for the first action of the
+  * sequences.
+  */
+  ThreatMap threats;
+
+  /*!
+  * \brief Return a random action playable in state. A first move ending
+  * where an enemy can kill Wolff is drawn again.
+  * \param state The state the action is played from.
+  * \param turn The index of the action in its sequence.
+  * \return A random MOVE or SHOOT.
+  */
+  Action randomAction(const GameState &state, int turn);
+
+  /*!
+  * \brief Play sequence from the root, replacing actions that became invalid
+  * and the ones after index keep by random ones. The actions after the end
+  * of the game are left out of length and are not meaningful.
+  * \param sequence The actions to play, updated with the ones played.
+  * \param keep The number of actions of sequence kept as they are.
+  * \param length Receives the number of actions played.
+  * \return The value of the final state.
+  */
+  float rollout(Action *sequence, int keep, int &length);
+};
+}
+
+#endif
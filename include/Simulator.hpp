@@ -0,0 +1,355 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "AliveMask.hpp"
+#include "Damage.hpp"
+#include "SpatialGrid.hpp"
+#include "Vector2.hpp"
+#include "Vector2Batch.hpp"
+#include <type_traits>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Rules of the Accountant game.
+*/
+const int MAX_DATA_POINTS = 100;
+const int MAX_ENEMIES = 100;
+constexpr float MAP_WIDTH = 16000.0f;
+constexpr float MAP_HEIGHT = 9000.0f;
+const float WOLFF_STEP = 1000.0f;
+const float ENEMY_STEP = 500.0f;
+const float KILL_RANGE = 2000.0f;
+
+/*!
+* \brief How much closer to another data point than to its target an enemy
+* can get per turn : the straight move brings it as close to both, and the
+* truncation of each coordinate shifts it less than sqrt(2) from there, so
+* the difference of the distances drops by less than 2 * sqrt(2).
+*/
+const int TARGET_SLACK = 3;
+
+/*!
+* \brief Where removed entities are parked so that batch kernels never pick
+* them.
+*/
+const float REMOVED_POSITION = 1e6f;
+
+/*!
+* \brief The side of the cells of the data points grid, and the number of data
+* points from which looking for the closest one goes through the grid rather
+* than through all of them.
+*/
+const int DATA_GRID_CELL_SIZE = 1000;
+const int DATA_GRID_THRESHOLD = 64;
+
+typedef SpatialGrid<MAX_DATA_POINTS, static_cast<int>(MAP_WIDTH),
+                    static_cast<int>(MAP_HEIGHT), DATA_GRID_CELL_SIZE>
+    DataGrid;
+
+/*!
+* \brief An action Wolff can do during a turn : MOVE x y or SHOOT id.
+*/
+struct Action {
+  enum Type { MOVE, SHOOT };
+
+  Type type;
+
+  /*!
+  * \brief Where Wolff goes when type is MOVE.
+  */
+  Vector2f destination;
+
+  /*!
+  * \brief The slot of the enemy shot when type is SHOOT.
+  */
+  int enemy;
+
+  /*!
+  * \brief Initialize to MOVE to the Vector2(0, 0).
+  */
+  Action(void);
+
+  /*!
+  * \brief Return an action moving Wolff towards destination.
+  * \param destination Where Wolff goes.
+  * \return A MOVE action.
+  */
+  static Action move(const Vector2f &destination);
+
+  /*!
+  * \brief Return an action shooting an enemy.
+  * \param enemy The slot of the enemy in the GameState.
+  * \return A SHOOT action.
+  */
+  static Action shoot(int enemy);
+
+  /*!
+  * \brief Return true if both actions do the same thing : SHOOT the same
+  * enemy or MOVE to the same destination.
+  */
+  bool operator==(const Action &other) const;
+};
+
+/*!
+* \brief What a search knows about an action playable from its root : the
+* sum of the values of the playouts through it and their number.
+*/
+struct ActionStatistics {
+  Action action;
+  float valueSum;
+  int visits;
+};
+
+/*!
+* \brief Everything needed to simulate a turn, stored in fixed-size arrays so
+* that a state can be copied and simulated without touching the heap. A state
+* is one flat, trivially copyable block : a copy is a single memcpy.
+* Entities keep their slot for the whole game, dead ones are only flagged and
+* parked at REMOVED_POSITION. Slots follow the input order, which is the order
+* of the ids. Positions are whole, like the input and the moves, and the
+* targets of the enemies are looked for with exact distances.
+*/
+struct GameState {
+  Vector2f wolff;
+  bool wolffDead;
+  int turn;
+
+  int dataCount;
+  int dataRemaining;
+  Vector2Batch<float, MAX_DATA_POINTS> dataPositions;
+  int dataIds[MAX_DATA_POINTS];
+  AliveMask<MAX_DATA_POINTS> dataAlive;
+
+  /*!
+  * \brief The alive data points by cell, kept in sync by addDataPoint and
+  * removeDataPoint.
+  */
+  DataGrid dataGrid;
+
+  int enemyCount;
+  int enemiesRemaining;
+  Vector2Batch<float, MAX_ENEMIES> enemyPositions;
+  int enemyIds[MAX_ENEMIES];
+  int enemyLives[MAX_ENEMIES];
+  AliveMask<MAX_ENEMIES> enemyAlive;
+
+  /*!
+  * \brief The slot of the data point each enemy goes to, -1 when it must be
+  * looked for again. An enemy moving to its closest data point gets at most
+  * TARGET_SLACK closer to any other per turn, so a target changes when it is
+  * collected, when the margin to the second closest data point runs out, or
+  * when data points or enemies are changed by hand.
+  */
+  int enemyTargets[MAX_ENEMIES];
+
+  /*!
+  * \brief The last turn each target is sure to stay the closest data point
+  * of its enemy, from the margin to the second closest when it was looked
+  * for.
+  */
+  int enemyTargetTurns[MAX_ENEMIES];
+
+  /*!
+  * \brief The sum of the lives of all enemies at the start of the game.
+  */
+  int initialTotalLife;
+  int shots;
+  int kills;
+
+  /*!
+  * \brief Initialize to an empty state.
+  */
+  GameState(void);
+
+  /*!
+  * \brief Remove all data points and enemies and reset the counters.
+  */
+  void clear();
+
+  /*!
+  * \brief Add a data point in the next free slot.
+  * \param id The id of the data point.
+  * \param position The position of the data point.
+  * \return The slot of the data point.
+  */
+  int addDataPoint(int id, const Vector2f &position);
+
+  /*!
+  * \brief Add an enemy in the next free slot.
+  * \param id The id of the enemy.
+  * \param position The position of the enemy.
+  * \param life The life of the enemy.
+  * \return The slot of the enemy.
+  */
+  int addEnemy(int id, const Vector2f &position, int life);
+
+  /*!
+  * \brief Flag a data point as collected.
+  * \param slot The slot of the data point.
+  */
+  void removeDataPoint(int slot);
+
+  /*!
+  * \brief Flag an enemy as dead.
+  * \param slot The slot of the enemy.
+  */
+  void removeEnemy(int slot);
+
+  /*!
+  * \brief Bring a collected data point back, to undo removeDataPoint.
+  * \param slot The slot of the data point.
+  * \param position The position of the data point.
+  */
+  void restoreDataPoint(int slot, const Vector2f &position);
+
+  /*!
+  * \brief Bring a dead enemy back, to undo removeEnemy.
+  * \param slot The slot of the enemy.
+  * \param position The position of the enemy when it died.
+  */
+  void restoreEnemy(int slot, const Vector2f &position);
+
+  /*!
+  * \brief Forget the targets of all enemies, to call after moving an enemy
+  * or a data point by hand.
+  */
+  void invalidateTargets();
+
+  /*!
+  * \brief Return the slot of an alive enemy.
+  * \param id The id of the enemy.
+  * \return The slot of the enemy, -1 if there is no alive enemy with this id.
+  */
+  int findEnemy(int id) const;
+
+  /*!
+  * \brief Return true if Wolff is dead, or if there is no more data point or
+  * enemy.
+  * \return true if the game is over.
+  */
+  bool isOver() const;
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "GameState must be copied with memcpy");
+
+/*!
+* \brief The recorder of simulate when nothing has to be undone. A recorder
+* is told about every change before simulate does it, see UndoLog.
+*/
+struct NoRecorder {
+  void beginTurn(const GameState &) {}
+  void targetChanged(int, int, int) {}
+  void enemyMoved(int, const Vector2f &) {}
+  void enemyHit(int, int) {}
+  void enemyRemoved(int, const Vector2f &) {}
+  void dataRemoved(int, const Vector2f &) {}
+};
+
+/*!
+* \brief Return the alive data point closest to a position, by exact
+* distances, the first slot wins ties.
+* \param state The state holding the data points.
+* \param position Where the distance is computed from, a whole position.
+* \return The slot of the data point, -1 if there is no data point.
+*/
+int nearestDataPoint(const GameState &state, const Vector2f &position);
+
+/*!
+* \brief Look for the closest data point of the enemies whose target is
+* unknown, was collected or may no longer be the closest, and only of those.
+* \param state The state holding the enemies.
+* \return The number of targets looked for.
+*/
+int updateTargets(GameState &state);
+
+/*!
+* \brief updateTargets, telling recorder the targets it replaces.
+*/
+template <typename Recorder>
+int updateTargets(GameState &state, Recorder &recorder);
+
+/*!
+* \brief Check every cached target against a search through all the data
+* points. Slow, for tests and debug builds.
+* \param state The state holding the enemies, with updated targets.
+* \return true if every alive enemy goes to its closest data point, the first
+* slot on ties.
+*/
+bool verifyTargets(const GameState &state);
+
+/*!
+* \brief Return the closest point of the map.
+* \param position Any point.
+* \return The point of the map closest to position.
+*/
+Vector2f clampToMap(const Vector2f &position);
+
+/*!
+* \brief Return action if the referee accepts it in state, else a MOVE where
+* Wolff stands : a SHOOT must aim at an alive enemy.
+* \param state The state the action is played from.
+* \param action The action to check.
+* \return An action that can be played.
+*/
+Action playableAction(const GameState &state, const Action &action);
+
+/*!
+* \brief Move position towards destination by at most step units, on whole
+* coordinates like the referee : the positions are truncated, then moved by
+* stepTowards. Simulated positions stay integers, several turns ahead too.
+* \param position The position to move.
+* \param destination Where position goes.
+* \param step The maximum length of the move.
+* \return true if destination is reached.
+*/
+bool moveTowards(Vector2f &position, const Vector2f &destination, float step);
+
+/*!
+* \brief Play one turn of the game : enemies move to their target, Wolff
+* moves, Wolff dies if an enemy is within KILL_RANGE, Wolff shoots, dead
+* enemies are removed and enemies collect the data points they reached.
+* Targets are updated with updateTargets, and checked with verifyTargets
+* when FUZZY_DEBUG is defined.
+* \param state The state to update.
+* \param action What Wolff does this turn.
+*/
+void simulate(GameState &state, const Action &action);
+
+/*!
+* \brief simulate, telling recorder every change before it is done.
+*/
+template <typename Recorder>
+void simulate(GameState &state, const Action &action, Recorder &recorder);
+
+/*!
+* \brief Return the score of the game if it ended in this state :
+* 100 per data point saved, 10 per kill and a bonus of
+* dataRemaining * max(0, initialTotalLife - 3 * shots) * 3.
+* \param state The state to score.
+* \return The score, 0 if Wolff is dead.
+*/
+int score(const GameState &state);
+
+/*!
+* \brief Return how good a state is for a search : the score, plus a small
+* credit for the damage done to the enemies still alive.
+* \param state The state to evaluate.
+* \return The value of the state, 0 if Wolff is dead.
+*/
+float evaluate(const GameState &state);
+
+/*!
+* \brief Return evaluate(state) as if Wolff had shot shots times. The bonus
+* loses 3 * dataRemaining * 3 per shot at once, while the data the shots
+* save only counts once an enemy reaches it : a search pruning states early
+* ranks them with the shots of its root.
+* \param state The state to evaluate.
+* \param shots The shots counted in the bonus.
+* \return The value of the state, 0 if Wolff is dead.
+*/
+float evaluate(const GameState &state, int shots);
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "Vector2.hpp"
+#include "Vector2Batch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A uniform grid over a Width x Height map, indexing the entities of a
+* Vector2Batch by cell. Each cell holds a doubly linked list threaded through
+* fixed arrays, so inserting, removing and moving an entity are O(1) and
+* queries only visit the cells around them. Nothing is allocated.
+*/
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+class SpatialGrid {
+
+public:
+  static const int COLUMNS = (Width + CellSize - 1) / CellSize;
+  static const int ROWS = (Height + CellSize - 1) / CellSize;
+  static const int CELLS = COLUMNS * ROWS;
+
+  typedef typename std::conditional<(Capacity < 255), std::uint8_t,
+                                    std::uint16_t>::type Index;
+  typedef Vector2Batch<float, Capacity> Positions;
+
+  /*!
+  * \brief The index of no entity.
+  */
+  static const Index NONE = static_cast<Index>(-1);
+
+  /*!
+  * \brief Initialize to an empty grid.
+  */
+  SpatialGrid(void);
+
+  /*!
+  * \brief Remove all entities.
+  */
+  void clear();
+
+  /*!
+  * \brief Return the cell holding a position, clamped to the map.
+  * \param position Any position.
+  * \return The column and the row of the cell.
+  */
+  static Vector2i cellOf(const Vector2f &position);
+
+  /*!
+  * \brief Add an entity to the cell of its position.
+  * \param index The index of the entity in the batch.
+  * \param position The position of the entity.
+  */
+  void insert(std::size_t index, const Vector2f &position);
+
+  /*!
+  * \brief Remove an entity from its cell.
+  * \param index The index of the entity in the batch.
+  */
+  void remove(std::size_t index);
+
+  /*!
+  * \brief Move an entity to the cell of its new position, if it changed.
+  * \param index The index of the entity in the batch.
+  * \param position The new position of the entity.
+  */
+  void move(std::size_t index, const Vector2f &position);
+
+  /*!
+  * \brief Return true if the entity is in the grid.
+  * \param index The index of the entity in the batch.
+  * \return true if the entity was inserted and not removed.
+  */
+  bool contains(std::size_t index) const;
+
+  /*!
+  * \brief Find the entities at most radius away from center.
+  * \param positions The positions of the entities.
+  * \param center The center of the disc.
+  * \param radius The radius of the disc.
+  * \param out Receives the indices of the entities found.
+  * \param maxCount The capacity of out.
+  * \return The number of entities found, at most maxCount.
+  */
+  std::size_t within(const Positions &positions, const Vector2f &center,
+                     float radius, Index *out, std::size_t maxCount) const;
+
+  /*!
+  * \brief Find the k entities closest to center, sorted by distance, the
+  * smallest index first on ties.
+  * \param positions The positions of the entities.
+  * \param center Where the distances are computed from.
+  * \param k The number of entities wanted.
+  * \param out Receives the indices of at most k entities.
+  * \param squaredDistances Receives their squared distances.
+  * \return The number of entities found, less than k if the grid holds less.
+  */
+  std::size_t nearest(const Positions &positions, const Vector2f &center,
+                      std::size_t k, Index *out,
+                      float *squaredDistances) const;
+
+private:
+  Index heads[CELLS];
+  Index next[Capacity];
+  Index previous[Capacity];
+  std::uint16_t cells[Capacity];
+  bool inserted[Capacity];
+
+  /*!
+  * \brief Return the index of a cell in heads.
+  */
+  static int cellIndex(const Vector2i &cell);
+};
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef STATEHISTORY_H
+#define STATEHISTORY_H
+
+#include "Simulator.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Preallocated slots to save states and go back to them, each save and
+* restore being a single memcpy. The simplest way to branch from a state.
+*/
+template <std::size_t Depth> class SnapshotStack {
+
+public:
+  /*!
+  * \brief Initialize to no saved state.
+  */
+  SnapshotStack(void);
+
+  /*!
+  * \brief Return the number of saved states.
+  * \return The number of saved states.
+  */
+  std::size_t size() const;
+
+  /*!
+  * \brief Forget all saved states.
+  */
+  void clear();
+
+  /*!
+  * \brief Save a state on top of the stack.
+  * \param state The state to save, less than Depth states must be saved.
+  */
+  void push(const GameState &state);
+
+  /*!
+  * \brief Copy the state on top of the stack, which stays saved.
+  * \param state Receives the saved state.
+  */
+  void restore(GameState &state) const;
+
+  /*!
+  * \brief Forget the state on top of the stack.
+  */
+  void pop();
+
+private:
+  GameState slots[Depth];
+  std::size_t depth;
+};
+
+/*!
+* \brief A recorder of simulate that logs what each turn changes, so that
+* turns can be undone in reverse order. For deep searches, where logging the
+* few changes of a turn costs less than copying the whole state.
+*/
+class UndoLog {
+
+public:
+  /*!
+  * \brief The number of turns that can be recorded, and the most changes they
+  * can do : each enemy can change of target, move and collect a data point.
+  */
+  static const int MAX_TURNS = 32;
+  static const int MAX_ENTRIES = MAX_TURNS * (3 * MAX_ENEMIES + 2);
+
+  /*!
+  * \brief Initialize to no recorded turn.
+  */
+  UndoLog(void);
+
+  /*!
+  * \brief Forget all recorded turns.
+  */
+  void clear();
+
+  /*!
+  * \brief Return the number of recorded turns.
+  * \return The number of turns which can be undone.
+  */
+  int turns() const;
+
+  /*!
+  * \brief Undo the last recorded turn.
+  * \param state The state the turn was simulated on.
+  */
+  void undo(GameState &state);
+
+  void beginTurn(const GameState &state);
+  void targetChanged(int slot, int target, int targetTurn);
+  void enemyMoved(int slot, const Vector2f &position);
+  void enemyHit(int slot, int life);
+  void enemyRemoved(int slot, const Vector2f &position);
+  void dataRemoved(int slot, const Vector2f &position);
+
+private:
+  /*!
+  * \brief A change, with the value it replaced.
+  */
+  struct Entry {
+    enum Kind { TARGET, MOVE, LIFE, ENEMY_REMOVED, DATA_REMOVED };
+
+    std::uint8_t kind;
+    std::uint8_t slot;
+    int value;
+
+    /*!
+    * \brief The last turn of the target replaced, for TARGET entries.
+    */
+    int targetTurn;
+    Vector2f position;
+  };
+
+  /*!
+  * \brief What a turn changes outside the entities.
+  */
+  struct Turn {
+    Vector2f wolff;
+    bool wolffDead;
+    int turn;
+    int shots;
+    int kills;
+    int firstEntry;
+  };
+
+  Turn turnLog[MAX_TURNS];
+  Entry entries[MAX_ENTRIES];
+  int turnCount;
+  int entryCount;
+
+  void record(Entry::Kind kind, int slot, int value,
+              const Vector2f &position);
+};
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef THREATMAP_H
+#define THREATMAP_H
+
+#include "Simulator.hpp"
+#include "Vector2Batch.hpp"
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A coarse grid over the map holding, for each cell, the earliest turn
+* an enemy can kill Wolff standing anywhere in it : an enemy moves at most
+* ENEMY_STEP per turn, so after k turns it is within KILL_RANGE of every
+* point less than KILL_RANGE + k * ENEMY_STEP away from where it started.
+* Cells are measured from their center minus half their diagonal, so a cell
+* is never later than its points : a safe cell is safe, a dangerous one may
+* not be at its far corner. Built once per turn from the squared distances
+* of the cell centers to each enemy, then looking up a point is reading its
+* cell.
+*/
+class ThreatMap {
+
+public:
+  static const int CELL_SIZE = 250;
+  static const int COLUMNS =
+      (static_cast<int>(MAP_WIDTH) + CELL_SIZE - 1) / CELL_SIZE;
+  static const int ROWS =
+      (static_cast<int>(MAP_HEIGHT) + CELL_SIZE - 1) / CELL_SIZE;
+  static const int CELLS = COLUMNS * ROWS;
+
+  /*!
+  * \brief The turn of the cells no enemy can reach, with no enemy left.
+  */
+  static const int NEVER = 255;
+
+  /*!
+  * \brief Initialize to a map with no enemy.
+  */
+  ThreatMap(void);
+
+  /*!
+  * \brief Compute the turns of every cell from the alive enemies of state.
+  * \param state The state holding the enemies.
+  */
+  void build(const GameState &state);
+
+  /*!
+  * \brief Remove an enemy which died after the build, in a simulation or a
+  * search : only the cells it was the closest to are computed again, from
+  * the positions of the other enemies at the build. The turns still count
+  * from the build, and stay conservative.
+  * \param slot The slot of the enemy in the state the map was built from.
+  * \return The number of cells computed again.
+  */
+  int enemyRemoved(int slot);
+
+  /*!
+  * \brief Return the earliest turn an enemy can kill Wolff at position, 1
+  * being the end of the next turn.
+  * \param position Any point, clamped to the map.
+  * \return The turn of the cell of position, in [1, NEVER].
+  */
+  int earliestTurn(const Vector2f &position) const;
+
+  /*!
+  * \brief Return true if no enemy can kill Wolff at position during the
+  * next turns turns.
+  * \param position Any point, clamped to the map.
+  * \param turns The number of turns.
+  * \return true if the cell of position is safe that long.
+  */
+  bool isSafe(const Vector2f &position, int turns) const;
+
+  /*!
+  * \brief Return the turn of a cell.
+  * \param column The column of the cell.
+  * \param row The row of the cell.
+  * \return The turn of the cell, in [1, NEVER].
+  */
+  int cellTurn(int column, int row) const;
+
+private:
+  /*!
+  * \brief The centers of the cells, row by row.
+  */
+  Vector2Batch<float, CELLS> centers;
+
+  /*!
+  * \brief The positions of the enemies at the build, the removed ones
+  * parked at REMOVED_POSITION.
+  */
+  Vector2Batch<float, MAX_ENEMIES> origins;
+  int enemies;
+
+  /*!
+  * \brief The squared distance from each center to its closest enemy.
+  */
+  float closest[CELLS];
+
+  std::uint8_t turns[CELLS];
+
+  /*!
+  * \brief The squared distances of the centers to one enemy.
+  */
+  float scratch[CELLS];
+
+  /*!
+  * \brief Return the index of the cell of position, clamped to the map.
+  */
+  static int cellIndex(const Vector2f &position);
+
+  /*!
+  * \brief Return the turn of a cell from the squared distance of its center
+  * to the closest enemy.
+  */
+  static std::uint8_t turnOf(float squaredDistance);
+};
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef TURNCLOCK_H
+#define TURNCLOCK_H
+
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Measure the time spent in the current turn against its budget : 1000
+* ms for the first turn, 100 ms for the others. Reads the time stamp counter
+* when available, calibrated once against std::chrono::steady_clock, and
+* std::chrono::steady_clock otherwise.
+*/
+class TurnClock {
+
+public:
+  static constexpr double FIRST_TURN_BUDGET_MS = 1000;
+  static constexpr double TURN_BUDGET_MS = 100;
+
+  /*!
+  * \brief Initialize a clock with no turn started. The first clock created
+  * calibrates the counter, better done before the first turn input arrives.
+  * \param firstTurnBudgetMs The budget of the first turn in milliseconds.
+  * \param turnBudgetMs The budget of the other turns in milliseconds.
+  */
+  TurnClock(double firstTurnBudgetMs = FIRST_TURN_BUDGET_MS,
+            double turnBudgetMs = TURN_BUDGET_MS);
+
+  /*!
+  * \brief Start the next turn now.
+  */
+  void startTurn();
+
+  /*!
+  * \brief Return the number of turns started.
+  * \return The number of turns started.
+  */
+  int turn() const;
+
+  /*!
+  * \brief Return the budget of the current turn.
+  * \return The budget of the current turn in milliseconds.
+  */
+  double budgetMs() const;
+
+  /*!
+  * \brief Return the time elapsed since the start of the turn.
+  * \return The time elapsed in milliseconds.
+  */
+  double elapsedMs() const;
+
+  /*!
+  * \brief Return the time left before the end of the budget.
+  * \return The time left in milliseconds, negative once over budget.
+  */
+  double remainingMs() const;
+
+  /*!
+  * \brief Return true if less than marginMs are left in the turn.
+  * \param marginMs The time kept to answer.
+  * \return true if the turn is over, margin included.
+  */
+  bool expired(double marginMs = 0) const;
+
+  /*!
+  * \brief Return the current tick of the clock.
+  * \return The current tick.
+  */
+  static std::uint64_t now();
+
+  /*!
+  * \brief Return the number of ticks in a millisecond, calibrated on the
+  * first call.
+  * \return The number of ticks in a millisecond.
+  */
+  static double ticksPerMs();
+
+private:
+  double firstTurnBudget;
+  double turnBudget;
+  double ticks;
+  int turns;
+  std::uint64_t start;
+  std::uint64_t deadline;
+};
+}
+
+#endif
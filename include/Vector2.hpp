@@ -1,10 +1,24 @@
 #ifndef VECTOR2_H
 #define VECTOR2_H
 
+#include "MathPolicy.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 namespace fuzzyTelegram {
 
+/*!
+* \brief A 2D vector. The members needing a square root or a trigonometric
+* function take a math policy, PreciseMath by default, FastMath when only the
+* ordering of the results matters.
+*/
 template <typename T> class Vector2 {
 
 public:
@@ -14,45 +28,45 @@ public:
   /*!
   * \brief Initialize to a Vector2(0, 0).
   */
-  Vector2(void);
+  constexpr Vector2(void) noexcept;
 
   /*!
   * \brief Initiliaze to a Vector2(x, y).
   * \param x The x value of the vector.
   * \param y The y value of the vector;
   */
-  Vector2(const T x, const T y);
+  constexpr Vector2(const T x, const T y) noexcept;
 
   /*!
   * \brief Initiliaze to a Vector2(xy, xy).
   * \param xy The value of x and y components.
   */
-  Vector2(const T xy);
+  constexpr Vector2(const T xy) noexcept;
 
   /*!
   * \brief Make a copy of the vector given (could be an other type).
   * \param v A reference to the vector to copy.
   */
-  template <typename U> explicit Vector2(const Vector2<U> &vector);
-
-  ~Vector2(void);
+  template <typename U>
+  constexpr explicit Vector2(const Vector2<U> &vector) noexcept;
 
   /*!
   * \brief Return the length of this vector.
   * \return The length of this vector.
   */
-  float magnitude() const;
+  template <typename Math = PreciseMath> float magnitude() const;
 
   /*!
   * \brief Return the square length of this vector.
   * \return The square length of this vector.
   */
-  float squaredMagnitude() const;
+  constexpr float squaredMagnitude() const noexcept;
 
   /*!
-  * \brief Normalize this vector;
+  * \brief Normalize this vector; integer vectors end up with truncated
+  * components, move them with stepTowards.
   */
-  void normalize();
+  template <typename Math = PreciseMath> void normalize();
 
   /*!
   * \brief Return a string representation of a vector : "(x, y)".
@@ -64,50 +78,51 @@ public:
   * \brief Return A copy of this vector with a magnitude of 1.
   * \return A copy of this vector with a magnitude of 1.
   */
-  Vector2 normalized() const;
+  template <typename Math = PreciseMath> Vector2 normalized() const;
 
   /*!
   * \brief Set the x and y value of this vector.
   * \param xValue The x value of the vector.
   * \param yValue The y value of the vector.
   */
-  template <typename U, typename V> void set(U xValue, V yValue);
+  template <typename U, typename V>
+  constexpr void set(U xValue, V yValue) noexcept;
 
   /*!
   * \brief Return a Vector2(0, 1).
   * \return A Vector2(0, 1).
   */
-  static Vector2 up();
+  static constexpr Vector2 up() noexcept;
 
   /*!
   * \brief Return a Vector2(0, -1).
   * \return A Vector2(0, -1).
   */
-  static Vector2 down();
+  static constexpr Vector2 down() noexcept;
 
   /*!
   * \brief Return a Vector2(-1, 0).
   * \return A Vector2(-1, 0).
   */
-  static Vector2 left();
+  static constexpr Vector2 left() noexcept;
 
   /*!
   * \brief Return a Vector2(1, 0).
   * \return A Vector2(1, 0).
   */
-  static Vector2 right();
+  static constexpr Vector2 right() noexcept;
 
   /*!
   * \brief Return a Vector(0, 0).
   * \return A Vector2(0, 0).
   */
-  static Vector2 zero();
+  static constexpr Vector2 zero() noexcept;
 
   /*!
   * \brief Return a Vector2(1, 1).
   * \return A Vector2(1, 1).
   */
-  static Vector2 one();
+  static constexpr Vector2 one() noexcept;
 
   /*!
   * \brief Return the dot product of two vectors.
@@ -115,7 +130,8 @@ public:
   * \param vector2 The second vector.
   * \return The dot product of vector1 and vector 2
   */
-  static float dot(const Vector2 &vector1, const Vector2 &vector2);
+  static constexpr float dot(const Vector2 &vector1,
+                             const Vector2 &vector2) noexcept;
 
   /*!
   * \brief Return the angle in degrees between two vectors.
@@ -123,6 +139,7 @@ public:
   * \param to Where the angle ends.
   * \return The angle in degrees between from and to.
   */
+  template <typename Math = PreciseMath>
   static float angle(const Vector2 &from, const Vector2 &to);
 
   /*!
@@ -132,6 +149,7 @@ public:
   * \param maxLength The maximum length magnitude.
   * \return A copy of vector with its magnitude clamped to maxLength.
   */
+  template <typename Math = PreciseMath>
   static Vector2 clampMagnitude(const Vector2 &vector, float maxLength);
 
   /*!
@@ -140,8 +158,39 @@ public:
   * \param u The second vector.
   * \return The distance between v and u.
   */
+  template <typename Math = PreciseMath>
   static float distance(const Vector2 &v, const Vector2 &u);
 
+  /*!
+  * \brief Return the squared distance between two vectors, to compare
+  * distances without a square root.
+  * \param v The first vector.
+  * \param u The second vector.
+  * \return The squared distance between v and u.
+  */
+  static constexpr float squaredDistance(const Vector2 &v,
+                                         const Vector2 &u) noexcept;
+
+  /*!
+  * \brief Return true if v and u are at most distance apart.
+  * \param v The first vector.
+  * \param u The second vector.
+  * \param distance The maximum distance.
+  * \return true if the distance between v and u is at most distance.
+  */
+  static constexpr bool isWithin(const Vector2 &v, const Vector2 &u,
+                                 float distance) noexcept;
+
+  /*!
+  * \brief Return true if a is strictly closer to origin than b.
+  * \param origin Where the distances are computed from.
+  * \param a The first vector.
+  * \param b The second vector.
+  * \return true if a is closer to origin than b.
+  */
+  static constexpr bool isCloser(const Vector2 &origin, const Vector2 &a,
+                                 const Vector2 &b) noexcept;
+
   /*!
   * \brief Linearly interpolate between vectorA and vectorB by t.
   * \param vectorA The first vector.
@@ -153,7 +202,8 @@ public:
   * of vectorA and vectorB.
   * \return A vector interpolated.
   */
-  static Vector2 lerp(const Vector2 &vectorA, const Vector2 &vectorB, float t);
+  static constexpr Vector2 lerp(const Vector2 &vectorA,
+                                const Vector2 &vectorB, float t) noexcept;
 
   /*!
   * \brief Insert into the output stream the vector's representation "(x, y)".
@@ -183,147 +233,532 @@ public:
   * \return The x component if i == 0, y if i == 1.
   * \exception std::out_of_range Index i is out of range if i > 1 or i < 0.
   */
-  const T operator[](const std::size_t i) const;
+  constexpr const T operator[](const std::size_t i) const;
 
   /*!
   * \brief Set x and y of this to x and y of the given vector.
   * \param v The vector this is assigned.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator=(const Vector2<U> &v);
+  template <typename U>
+  constexpr Vector2 &operator=(const Vector2<U> &v) noexcept;
 
   /*!
   * \brief Set x and y of this to the given value.
   * \param f The new value of x and y of this.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator=(const U &value);
+  template <typename U>
+  constexpr Vector2 &operator=(const U &value) noexcept;
 
   /*!
   * \brief Return the inverse of this vector "(-x, -y)".
   * \return The inverse of this vector..
   */
-  Vector2 operator-(void) const;
+  constexpr Vector2 operator-(void) const noexcept;
 
   /*!
   * \brief Check if this vector is equal to another.
   * \return true if x and y components of both vectors are equal.
   */
-  template <typename U> bool operator==(const Vector2<U> &v) const;
+  template <typename U>
+  constexpr bool operator==(const Vector2<U> &v) const noexcept;
 
   /*!
   * \brief Check if this vector is different from another.
   * \return true if x and y components of both vectors are different.
   */
-  template <typename U> bool operator!=(const Vector2<U> &v) const;
+  template <typename U>
+  constexpr bool operator!=(const Vector2<U> &v) const noexcept;
 
   /*!
   * \brief Add this vector to another.
   * \return A vector with x and y components of this vector added to x and y
   * components of the other.
   */
-  const Vector2 operator+(const Vector2 &v) const;
+  constexpr const Vector2 operator+(const Vector2 &v) const noexcept;
 
   /*!
   * \brief Substract this vector to another.
   * \return A vector with x and y components of this vector substracted from x
   * and y components of the other.
   */
-  const Vector2 operator-(const Vector2 &v) const;
+  constexpr const Vector2 operator-(const Vector2 &v) const noexcept;
 
   /*!
   * \brief Multiply this vector to another.
   * \return A vector with x and y components of this vector multiplied by x
   * and y components of the other.
   */
-  const Vector2 operator*(const Vector2 &v) const;
+  constexpr const Vector2 operator*(const Vector2 &v) const noexcept;
 
   /*!
   * \brief Divide this vector to another.
   * \return A vector with x and y components of this vector divided by x
   * and y components of the other.
   */
-  const Vector2 operator/(const Vector2 &v) const;
+  constexpr const Vector2 operator/(const Vector2 &v) const noexcept;
 
   /*!
   * \brief Add x and y components of the other vector to x and y components of
   * this vector.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator+=(const Vector2<U> &v);
+  template <typename U>
+  constexpr Vector2 &operator+=(const Vector2<U> &v) noexcept;
 
   /*!
   * \brief Substract x and y components of the other vector from x and y
   * components of this vector.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator-=(const Vector2<U> &v);
+  template <typename U>
+  constexpr Vector2 &operator-=(const Vector2<U> &v) noexcept;
 
   /*!
   * \brief Multiply x and y components of the this vector by x and y
   * components of the other vector.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator*=(const Vector2<U> &v);
+  template <typename U>
+  constexpr Vector2 &operator*=(const Vector2<U> &v) noexcept;
 
   /*!
   * \brief Divide x and y components of the this vector by x and y
   * components of the other vector.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator/=(const Vector2<U> &v);
+  template <typename U>
+  constexpr Vector2 &operator/=(const Vector2<U> &v) noexcept;
 
   /*!
   * \brief Return a copy of this vector with v added to x and y components.
   * \return A copy of this vector with v added to x and y components.
   */
-  template <typename U> const Vector2 operator+(U value) const;
+  template <typename U>
+  constexpr const Vector2 operator+(U value) const noexcept;
 
   /*!
   * \brief Return a copy of this vector with v substracted from x and y
   * components.
   * \return A copy of this vector with v substracted from x and y components.
   */
-  template <typename U> const Vector2 operator-(U value) const;
+  template <typename U>
+  constexpr const Vector2 operator-(U value) const noexcept;
 
   /*!
   * \brief Return a copy of this vector with x and y components multiplied by
   * v.
   * \return A copy of this vector with x and y components multiplied by v.
   */
-  template <typename U> const Vector2 operator*(U v) const;
+  template <typename U>
+  constexpr const Vector2 operator*(U v) const noexcept;
 
   /*!
   * \brief Return a copy of this vector with x and y components divided by v.
   * \return A copy of this vector with x and y components divided by v.
   */
-  template <typename U> const Vector2 operator/(U v) const;
+  template <typename U>
+  constexpr const Vector2 operator/(U v) const noexcept;
 
   /*!
   * \brief Add the given value to x and y components of this vector.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator+=(U v);
+  template <typename U> constexpr Vector2 &operator+=(U v) noexcept;
 
   /*!
   * \brief Substract the given value from x and y components of this vector.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator-=(U v);
+  template <typename U> constexpr Vector2 &operator-=(U v) noexcept;
 
   /*!
   * \brief Multiply x and y components of this vector by the given value.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator*=(U v);
+  template <typename U> constexpr Vector2 &operator*=(U v) noexcept;
 
   /*!
   * \brief Divide x and y components of this vector by the given value.
   * \return This vector.
   */
-  template <typename U> Vector2 &operator/=(U v);
+  template <typename U> constexpr Vector2 &operator/=(U v) noexcept;
 };
 
+template <typename T>
+constexpr Vector2<T>::Vector2(void) noexcept : x(0), y(0) {}
+
+template <typename T>
+constexpr Vector2<T>::Vector2(const T xValue, const T yValue) noexcept
+    : x(xValue), y(yValue) {}
+
+template <typename T>
+constexpr Vector2<T>::Vector2(const T xy) noexcept : x(xy), y(xy) {}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T>::Vector2(const Vector2<U> &vector) noexcept
+    : x(static_cast<T>(vector.x)), y(static_cast<T>(vector.y)) {}
+
+template <typename T>
+template <typename Math>
+float Vector2<T>::magnitude() const {
+  return Math::sqrt(x * x + y * y);
+}
+
+template <typename T>
+constexpr float Vector2<T>::squaredMagnitude() const noexcept {
+  return x * x + y * y;
+}
+
+template <typename T> template <typename Math> void Vector2<T>::normalize() {
+  if (Math::PREFERS_RSQRT) {
+    float inverseLength = Math::rsqrt(x * x + y * y);
+    x = x * inverseLength;
+    y = y * inverseLength;
+  } else {
+    float length = this->template magnitude<Math>();
+    x = x / length;
+    y = y / length;
+  }
+  assert(x <= 1 && x >= -1);
+  assert(y <= 1 && y >= -1);
+}
+
+template <typename T> std::string Vector2<T>::toString() const {
+  std::stringstream s;
+  s << *this;
+  return s.str();
+}
+
+template <typename T>
+template <typename U, typename V>
+constexpr void Vector2<T>::set(U xValue, V yValue) noexcept {
+  x = static_cast<T>(xValue);
+  y = static_cast<T>(yValue);
+}
+
+template <typename T>
+template <typename Math>
+Vector2<T> Vector2<T>::normalized() const {
+  Vector2<T> v(*this);
+  v.template normalize<Math>();
+  return v;
+}
+
+template <typename T> constexpr Vector2<T> Vector2<T>::up() noexcept {
+  return Vector2<T>(0, 1);
+}
+
+template <typename T> constexpr Vector2<T> Vector2<T>::down() noexcept {
+  return Vector2<T>(0, -1);
+}
+
+template <typename T> constexpr Vector2<T> Vector2<T>::left() noexcept {
+  return Vector2<T>(-1, 0);
+}
+
+template <typename T> constexpr Vector2<T> Vector2<T>::right() noexcept {
+  return Vector2<T>(1, 0);
+}
+
+template <typename T> constexpr Vector2<T> Vector2<T>::zero() noexcept {
+  return Vector2<T>(0, 0);
+}
+
+template <typename T> constexpr Vector2<T> Vector2<T>::one() noexcept {
+  return Vector2<T>(1, 1);
+}
+
+template <typename T>
+constexpr float Vector2<T>::dot(const Vector2 &vector1,
+                               const Vector2 &vector2) noexcept {
+  return vector1.x * vector2.x + vector1.y * vector2.y;
+}
+
+template <typename T>
+template <typename Math>
+float Vector2<T>::angle(const Vector2 &from, const Vector2 &to) {
+  return Math::acos(Vector2<T>::dot(from.template normalized<Math>(),
+                                    to.template normalized<Math>())) *
+         180 / M_PI;
+}
+
+template <typename T>
+template <typename Math>
+float Vector2<T>::distance(const Vector2 &v, const Vector2 &u) {
+  return (v - u).template magnitude<Math>();
+}
+
+template <typename T>
+constexpr float Vector2<T>::squaredDistance(const Vector2 &v,
+                                            const Vector2 &u) noexcept {
+  return (v - u).squaredMagnitude();
+}
+
+template <typename T>
+constexpr bool Vector2<T>::isWithin(const Vector2 &v, const Vector2 &u,
+                                    float distance) noexcept {
+  return squaredDistance(v, u) <= distance * distance;
+}
+
+template <typename T>
+constexpr bool Vector2<T>::isCloser(const Vector2 &origin, const Vector2 &a,
+                                    const Vector2 &b) noexcept {
+  return squaredDistance(origin, a) < squaredDistance(origin, b);
+}
+
+template <typename T>
+template <typename Math>
+Vector2<T> Vector2<T>::clampMagnitude(const Vector2 &vector, float maxLength) {
+  float length = vector.template magnitude<Math>();
+  if (length <= maxLength)
+    return vector;
+  float ratio = maxLength / length;
+  return Vector2<T>(static_cast<T>(vector.x * ratio),
+                    static_cast<T>(vector.y * ratio));
+}
+
+template <typename T>
+constexpr Vector2<T> Vector2<T>::lerp(const Vector2 &vectorA,
+                                      const Vector2 &vectorB,
+                                      float t) noexcept {
+  t = t < 0 ? 0 : (t > 1 ? 1 : t);
+  return Vector2<T>(static_cast<T>(vectorA.x + (vectorB.x - vectorA.x) * t),
+                    static_cast<T>(vectorA.y + (vectorB.y - vectorA.y) * t));
+}
+
+template <typename T>
+constexpr const T Vector2<T>::operator[](const std::size_t i) const {
+  if (i == 0)
+    return x;
+  else if (i == 1)
+    return y;
+  else
+    throw std::out_of_range("Index should be 0 or 1.");
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator=(const Vector2<U> &v) noexcept {
+  x = static_cast<T>(v.x);
+  y = static_cast<T>(v.y);
+  return *this;
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator=(const U &value) noexcept {
+  x = static_cast<T>(value);
+  y = static_cast<T>(value);
+  return *this;
+}
+
+template <typename T>
+constexpr Vector2<T> Vector2<T>::operator-(void) const noexcept {
+  return Vector2<T>(-x, -y);
+}
+
+template <typename T>
+template <typename U>
+constexpr bool Vector2<T>::operator==(const Vector2<U> &v) const noexcept {
+  return static_cast<T>(v.x) == x && static_cast<T>(v.y) == y;
+}
+
+template <typename T>
+template <typename U>
+constexpr bool Vector2<T>::operator!=(const Vector2<U> &v) const noexcept {
+  return static_cast<T>(v.x) != x || static_cast<T>(v.y) != y;
+}
+
+template <typename T>
+constexpr const Vector2<T>
+Vector2<T>::operator+(const Vector2<T> &v) const noexcept {
+  return Vector2<T>(x + v.x, y + v.y);
+}
+
+template <typename T>
+constexpr const Vector2<T>
+Vector2<T>::operator-(const Vector2<T> &v) const noexcept {
+  return Vector2<T>(x - v.x, y - v.y);
+}
+
+template <typename T>
+constexpr const Vector2<T>
+Vector2<T>::operator*(const Vector2<T> &v) const noexcept {
+  return Vector2<T>(x * v.x, y * v.y);
+}
+
+template <typename T>
+constexpr const Vector2<T>
+Vector2<T>::operator/(const Vector2<T> &v) const noexcept {
+  return Vector2<T>(x / v.x, y / v.y);
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator+=(const Vector2<U> &v) noexcept {
+  x += v.x;
+  y += v.y;
+  return *this;
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator-=(const Vector2<U> &v) noexcept {
+  x -= v.x;
+  y -= v.y;
+  return *this;
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator*=(const Vector2<U> &v) noexcept {
+  x *= v.x;
+  y *= v.y;
+  return *this;
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator/=(const Vector2<U> &v) noexcept {
+  x /= v.x;
+  y /= v.y;
+  return *this;
+}
+
+template <typename T>
+template <typename U>
+constexpr const Vector2<T> Vector2<T>::operator+(U value) const noexcept {
+  return Vector2<T>(x + static_cast<T>(value), y + static_cast<T>(value));
+}
+
+template <typename T>
+template <typename U>
+constexpr const Vector2<T> Vector2<T>::operator-(U value) const noexcept {
+  return Vector2<T>(x - static_cast<T>(value), y - static_cast<T>(value));
+}
+
+template <typename T>
+template <typename U>
+constexpr const Vector2<T> Vector2<T>::operator*(U value) const noexcept {
+  return Vector2<T>(x * static_cast<T>(value), y * static_cast<T>(value));
+}
+
+template <typename T>
+template <typename U>
+constexpr const Vector2<T> Vector2<T>::operator/(U value) const noexcept {
+  assert(value != 0);
+  return Vector2<T>(x / static_cast<T>(value), y / static_cast<T>(value));
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator+=(const U value) noexcept {
+  x += static_cast<T>(value);
+  y += static_cast<T>(value);
+  return *this;
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator-=(const U value) noexcept {
+  x -= static_cast<T>(value);
+  y -= static_cast<T>(value);
+  return *this;
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator*=(const U value) noexcept {
+  x *= static_cast<T>(value);
+  y *= static_cast<T>(value);
+  return *this;
+}
+
+template <typename T>
+template <typename U>
+constexpr Vector2<T> &Vector2<T>::operator/=(const U value) noexcept {
+  x /= static_cast<T>(value);
+  y /= static_cast<T>(value);
+  return *this;
+}
+
+/*!
+* \brief Return floor(sqrt(n)), exact for every n below 2^52.
+* \param n The number.
+* \return The integer square root of n.
+*/
+inline std::uint64_t integerSqrt(std::uint64_t n) {
+  std::uint64_t root =
+      static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+  // The double square root is at most one away, either side.
+  while (root * root > n)
+    --root;
+  while ((root + 1) * (root + 1) <= n)
+    ++root;
+  return root;
+}
+
+/*!
+* \brief Move an integer position towards destination by step, rounded down
+* like the referee truncates the positive coordinates after a move : the
+* components become floor(position + direction * step / |direction|), exactly.
+* Computed in floats, off by 1e-3 at most, and with integers for the moves
+* this close to whole numbers, which floats round either way : along the
+* axes, on 3-4-5 triangles... The move ends less than sqrt(2) from the
+* straight one, so it gets less than 2 * sqrt(2) closer to any other point
+* than to destination, see TARGET_SLACK.
+* \param position The position to move, its components less than 2^15 apart
+* from those of destination.
+* \param destination Where position goes.
+* \param step The maximum length of the move, at most 2^11.
+* \return true if destination is reached.
+*/
+template <typename T>
+bool stepTowards(Vector2<T> &position, const Vector2<T> &destination,
+                 T step) {
+  static_assert(std::is_integral<T>::value,
+                "stepTowards moves integer vectors.");
+  const std::int32_t dx = static_cast<std::int32_t>(destination.x - position.x);
+  const std::int32_t dy = static_cast<std::int32_t>(destination.y - position.y);
+  assert(dx > -(1 << 15) && dx < 1 << 15 && dy > -(1 << 15) && dy < 1 << 15);
+  const std::int32_t squaredLength = dx * dx + dy * dy;
+  const std::int32_t squaredStep = static_cast<std::int32_t>(step) * step;
+  if (squaredLength <= squaredStep) {
+    position = destination;
+    return true;
+  }
+  // The moves are shifted to positive numbers, whose truncation is the
+  // floor. When the floors a little below and a little above differ, the
+  // move is next to the whole number r : r is the floor if r * length is at
+  // most d * step, compared exactly on the squares.
+  const std::int32_t offset = 4096;
+  const float scale = step / std::sqrt(static_cast<float>(squaredLength));
+  const float x = dx * scale + offset;
+  const float y = dy * scale + offset;
+  std::int32_t moveX = static_cast<std::int32_t>(x - 2e-3f);
+  std::int32_t moveY = static_cast<std::int32_t>(y - 2e-3f);
+  if (moveX != static_cast<std::int32_t>(x + 2e-3f) ||
+      moveY != static_cast<std::int32_t>(y + 2e-3f)) {
+    auto exact = [squaredLength, squaredStep](std::int64_t d, float move) {
+      const std::int64_t r = static_cast<std::int32_t>(move + 0.5f) - offset;
+      const std::int64_t scaled = r * r * squaredLength;
+      const std::int64_t target = d * d * squaredStep;
+      const bool below = d >= 0 ? scaled <= target : scaled >= target;
+      return static_cast<std::int32_t>(below ? r : r - 1) + offset;
+    };
+    moveX = exact(dx, x);
+    moveY = exact(dy, y);
+  }
+  position.x = static_cast<T>(position.x + (moveX - offset));
+  position.y = static_cast<T>(position.y + (moveY - offset));
+  return false;
+}
+
+// template class Vector2<int>;
+
 typedef Vector2<char> Vector2c;
 typedef Vector2<short int> Vector2si;
 typedef Vector2<int> Vector2i;
@@ -335,6 +770,9 @@ typedef Vector2<unsigned char> Vector2uc;
 typedef Vector2<unsigned short int> Vector2usi;
 typedef Vector2<unsigned int> Vector2ui;
 typedef Vector2<unsigned long int> Vector2uli;
+
+static_assert(std::is_trivially_copyable<Vector2f>::value,
+              "Vector2 must stay trivially copyable to be memcpy'd in states.");
 }
 
 #endif
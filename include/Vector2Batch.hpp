@@ -0,0 +1,101 @@
+#ifndef VECTOR2BATCH_H
+#define VECTOR2BATCH_H
+
+#include "Vector2.hpp"
+#include <cstddef>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A fixed-capacity batch of vectors stored as a structure of arrays :
+* all x components are contiguous, then all y components. The kernels work on
+* the whole batch at once with SSE2 or AVX when the compiler targets them, and
+* fall back to scalar loops otherwise.
+*/
+template <typename T, std::size_t Capacity> class Vector2Batch {
+
+public:
+  /*!
+  * \brief The capacity rounded up to a full AVX register of floats.
+  */
+  static const std::size_t PADDED_CAPACITY = (Capacity + 7) / 8 * 8;
+
+  alignas(32) T xs[PADDED_CAPACITY];
+  alignas(32) T ys[PADDED_CAPACITY];
+
+  /*!
+  * \brief Initialize to an empty batch.
+  */
+  Vector2Batch(void);
+
+  /*!
+  * \brief Return the number of vectors in the batch.
+  * \return The number of vectors in the batch.
+  */
+  std::size_t size() const;
+
+  /*!
+  * \brief Remove all vectors from the batch.
+  */
+  void clear();
+
+  /*!
+  * \brief Add a vector at the end of the batch.
+  * \param v The vector to add.
+  * \return The index of the vector in the batch.
+  */
+  std::size_t push(const Vector2<T> &v);
+
+  /*!
+  * \brief Replace the vector at index i.
+  * \param i The index of the vector.
+  * \param v The new value of the vector.
+  */
+  void set(std::size_t i, const Vector2<T> &v);
+
+  /*!
+  * \brief Return a copy of the vector at index i.
+  * \param i The index of the vector.
+  * \return The vector at index i.
+  */
+  Vector2<T> operator[](std::size_t i) const;
+
+  /*!
+  * \brief Compute the squared distance from point to every vector.
+  * \param point Where the distances are computed from.
+  * \param out An array of at least size() elements receiving the distances.
+  */
+  void squaredDistances(const Vector2<T> &point, T *out) const;
+
+  /*!
+  * \brief Compute the dot product of v with every vector.
+  * \param v The other vector of the dot products.
+  * \param out An array of at least size() elements receiving the products.
+  */
+  void dots(const Vector2<T> &v, T *out) const;
+
+  /*!
+  * \brief Return the index of the vector closest to point, the smallest index
+  * wins ties.
+  * \param point Where the distances are computed from.
+  * \param squaredDistance If not null, receives the squared distance to the
+  * closest vector.
+  * \return The index of the closest vector, size() if the batch is empty.
+  */
+  std::size_t nearest(const Vector2<T> &point,
+                      T *squaredDistance = nullptr) const;
+
+  /*!
+  * \brief Return true if a vector is at most radius away from point.
+  * \param point The center of the disc.
+  * \param radius The radius of the disc.
+  * \return true if a vector lies in the disc.
+  */
+  bool anyWithin(const Vector2<T> &point, T radius) const;
+
+private:
+  std::size_t count;
+};
+}
+
+#endif
@@ -1,15 +1,108 @@
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("O3,unroll-loops")
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(FUZZY_NO_AVX2)
+#pragma GCC target("avx2,fma")
+#define FUZZY_TARGET_AVX2
+#endif
+#endif
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <immintrin.h>
+#include <iosfwd>
 #include <iostream>
+#include <limits>
+#include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
 #include <vector>
+#include <x86intrin.h>
+#include <xmmintrin.h>
+#ifndef MATHPOLICY_H
+#define MATHPOLICY_H
+
+#if defined(__SSE__) || defined(__x86_64__)
+#define FUZZY_HAS_RSQRTSS
+#endif
+
+namespace fuzzyTelegram {
+
+struct PreciseMath {
+  static constexpr bool PREFERS_RSQRT = false;
+
+  static double sqrt(double x) { return std::sqrt(x); }
+
+  static double rsqrt(double x) { return 1 / std::sqrt(x); }
+
+  static double acos(double x) { return std::acos(x); }
+
+  static double atan2(double y, double x) { return std::atan2(y, x); }
+};
+
+struct FastMath {
+  static constexpr bool PREFERS_RSQRT = true;
+
+  static float rsqrt(float x) {
+#ifdef FUZZY_HAS_RSQRTSS
+    float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return r * (1.5f - 0.5f * x * r * r);
+#else
+    std::uint32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x5f375a86 - (i >> 1);
+    float r;
+    std::memcpy(&r, &i, sizeof(r));
+    r = r * (1.5f - 0.5f * x * r * r);
+    return r * (1.5f - 0.5f * x * r * r);
+#endif
+  }
+
+  static float sqrt(float x) { return x <= 0 ? 0 : x * rsqrt(x); }
+
+  static float acos(float x) {
+    float a = std::fabs(x);
+    float r = sqrt(1 - a) *
+              (1.5707288f + a * (-0.2121144f + a * (0.0742610f -
+                                                    a * 0.0187293f)));
+    return x < 0 ? 3.14159265f - r : r;
+  }
+
+  static float atan2(float y, float x) {
+    float ax = std::fabs(x);
+    float ay = std::fabs(y);
+    if (ax == 0 && ay == 0)
+      return 0;
+    float z = ax > ay ? ay / ax : ax / ay;
+    float z2 = z * z;
+    float r =
+        z * (0.99997726f +
+             z2 * (-0.33262347f +
+                   z2 * (0.19354346f +
+                         z2 * (-0.11643287f +
+                               z2 * (0.05265332f + z2 * -0.01172120f)))));
+    if (ay > ax)
+      r = 1.57079633f - r;
+    if (x < 0)
+      r = 3.14159265f - r;
+    return y < 0 ? -r : r;
+  }
+};
+}
+
+#endif
 #ifndef VECTOR2_H
 #define VECTOR2_H
 
-
 namespace fuzzyTelegram {
 
 template <typename T> class Vector2 {
@@ -18,362 +111,167 @@ public:
   T x;
   T y;
 
-  /*!
-  * \brief Initialize to a Vector2(0, 0).
-  */
-  Vector2(void);
-
-  /*!
-  * \brief Initiliaze to a Vector2(x, y).
-  * \param x The x value of the vector.
-  * \param y The y value of the vector;
-  */
-  Vector2(const T x, const T y);
-
-  /*!
-  * \brief Initiliaze to a Vector2(xy, xy).
-  * \param xy The value of x and y components.
-  */
-  Vector2(const T xy);
-
-  /*!
-  * \brief Make a copy of the vector given (could be an other type).
-  * \param v A reference to the vector to copy.
-  */
-  template <typename U> explicit Vector2(const Vector2<U> &vector);
-
-  ~Vector2(void);
-
-  /*!
-  * \brief Return the length of this vector.
-  * \return The length of this vector.
-  */
-  float magnitude() const;
-
-  /*!
-  * \brief Return the square length of this vector.
-  * \return The square length of this vector.
-  */
-  float squaredMagnitude() const;
-
-  /*!
-  * \brief Normalize this vector;
-  */
-  void normalize();
-
-  /*!
-  * \brief Return a string representation of a vector : "(x, y)".
-  * \return A string representation of a vector : "(x, y)".
-  */
+  constexpr Vector2(void) noexcept;
+
+  constexpr Vector2(const T x, const T y) noexcept;
+
+  constexpr Vector2(const T xy) noexcept;
+
+  template <typename U>
+  constexpr explicit Vector2(const Vector2<U> &vector) noexcept;
+
+  template <typename Math = PreciseMath> float magnitude() const;
+
+  constexpr float squaredMagnitude() const noexcept;
+
+  template <typename Math = PreciseMath> void normalize();
+
   std::string toString() const;
 
-  /*!
-  * \brief Return A copy of this vector with a magnitude of 1.
-  * \return A copy of this vector with a magnitude of 1.
-  */
-  Vector2 normalized() const;
-
-  /*!
-  * \brief Set the x and y value of this vector.
-  * \param xValue The x value of the vector.
-  * \param yValue The y value of the vector.
-  */
-  template <typename U, typename V> void set(U xValue, V yValue);
-
-  /*!
-  * \brief Return a Vector2(0, 1).
-  * \return A Vector2(0, 1).
-  */
-  static Vector2 up();
-
-  /*!
-  * \brief Return a Vector2(0, -1).
-  * \return A Vector2(0, -1).
-  */
-  static Vector2 down();
-
-  /*!
-  * \brief Return a Vector2(-1, 0).
-  * \return A Vector2(-1, 0).
-  */
-  static Vector2 left();
-
-  /*!
-  * \brief Return a Vector2(1, 0).
-  * \return A Vector2(1, 0).
-  */
-  static Vector2 right();
-
-  /*!
-  * \brief Return a Vector(0, 0).
-  * \return A Vector2(0, 0).
-  */
-  static Vector2 zero();
-
-  /*!
-  * \brief Return a Vector2(1, 1).
-  * \return A Vector2(1, 1).
-  */
-  static Vector2 one();
-
-  /*!
-  * \brief Return the dot product of two vectors.
-  * \param vector1 The first vector.
-  * \param vector2 The second vector.
-  * \return The dot product of vector1 and vector 2
-  */
-  static float dot(const Vector2 &vector1, const Vector2 &vector2);
-
-  /*!
-  * \brief Return the angle in degrees between two vectors.
-  * \param from Where the angle starts.
-  * \param to Where the angle ends.
-  * \return The angle in degrees between from and to.
-  */
+  template <typename Math = PreciseMath> Vector2 normalized() const;
+
+  template <typename U, typename V>
+  constexpr void set(U xValue, V yValue) noexcept;
+
+  static constexpr Vector2 up() noexcept;
+
+  static constexpr Vector2 down() noexcept;
+
+  static constexpr Vector2 left() noexcept;
+
+  static constexpr Vector2 right() noexcept;
+
+  static constexpr Vector2 zero() noexcept;
+
+  static constexpr Vector2 one() noexcept;
+
+  static constexpr float dot(const Vector2 &vector1,
+                             const Vector2 &vector2) noexcept;
+
+  template <typename Math = PreciseMath>
   static float angle(const Vector2 &from, const Vector2 &to);
 
-  /*!
-  * \brief Return A copy of the vector with its magnitude clamped to
-  * maxLength.
-  * \param vector The vector we want to clamp.
-  * \param maxLength The maximum length magnitude.
-  * \return A copy of vector with its magnitude clamped to maxLength.
-  */
+  template <typename Math = PreciseMath>
   static Vector2 clampMagnitude(const Vector2 &vector, float maxLength);
 
-  /*!
-  * \brief Return the distance between two vectors.
-  * \param v The first vector.
-  * \param u The second vector.
-  * \return The distance between v and u.
-  */
+  template <typename Math = PreciseMath>
   static float distance(const Vector2 &v, const Vector2 &u);
 
-  /*!
-  * \brief Linearly interpolate between vectorA and vectorB by t.
-  * \param vectorA The first vector.
-  * \param vectorB The second vector.
-  * \param t How far interpolation is done. Clamped between 0 and 1. When t =
-  * 0,
-  * return vectorA,  when t = 1 return vectorB, when t = 0.5 return the
-  * midpoint
-  * of vectorA and vectorB.
-  * \return A vector interpolated.
-  */
-  static Vector2 lerp(const Vector2 &vectorA, const Vector2 &vectorB, float t);
-
-  /*!
-  * \brief Insert into the output stream the vector's representation "(x, y)".
-  * \param output The output stream.
-  * \param v The vector to insert into output.
-  * \return A The output stream.
-  */
+  static constexpr float squaredDistance(const Vector2 &v,
+                                         const Vector2 &u) noexcept;
+
+  static constexpr bool isWithin(const Vector2 &v, const Vector2 &u,
+                                 float distance) noexcept;
+
+  static constexpr bool isCloser(const Vector2 &origin, const Vector2 &a,
+                                 const Vector2 &b) noexcept;
+
+  static constexpr Vector2 lerp(const Vector2 &vectorA,
+                                const Vector2 &vectorB, float t) noexcept;
+
   friend std::ostream &operator<<(std::ostream &output, const Vector2 &v) {
     output << '(' << v.x << ", " << v.y << ')';
     return output;
   }
 
-  /*!
-  * \brief Extract the x and y components from the input stream into v.
-  * \param input The input stream.
-  * \param v The vector in which we insert x and y components.
-  * \return The input stream.
-  */
   friend std::istream &operator>>(std::istream &input, Vector2 &v) {
     input >> v.x >> v.y;
     return input;
   }
 
-  /*!
-  * \brief Return the x (i == 0) or y (i == 1) components.
-  * \param i L'index.
-  * \return The x component if i == 0, y if i == 1.
-  * \exception std::out_of_range Index i is out of range if i > 1 or i < 0.
-  */
-  const T operator[](const std::size_t i) const;
-
-  /*!
-  * \brief Set x and y of this to x and y of the given vector.
-  * \param v The vector this is assigned.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator=(const Vector2<U> &v);
-
-  /*!
-  * \brief Set x and y of this to the given value.
-  * \param f The new value of x and y of this.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator=(const U &value);
-
-  /*!
-  * \brief Return the inverse of this vector "(-x, -y)".
-  * \return The inverse of this vector..
-  */
-  Vector2 operator-(void) const;
-
-  /*!
-  * \brief Check if this vector is equal to another.
-  * \return true if x and y components of both vectors are equal.
-  */
-  template <typename U> bool operator==(const Vector2<U> &v) const;
-
-  /*!
-  * \brief Check if this vector is different from another.
-  * \return true if x and y components of both vectors are different.
-  */
-  template <typename U> bool operator!=(const Vector2<U> &v) const;
-
-  /*!
-  * \brief Add this vector to another.
-  * \return A vector with x and y components of this vector added to x and y
-  * components of the other.
-  */
-  const Vector2 operator+(const Vector2 &v) const;
-
-  /*!
-  * \brief Substract this vector to another.
-  * \return A vector with x and y components of this vector substracted from x
-  * and y components of the other.
-  */
-  const Vector2 operator-(const Vector2 &v) const;
-
-  /*!
-  * \brief Multiply this vector to another.
-  * \return A vector with x and y components of this vector multiplied by x
-  * and y components of the other.
-  */
-  const Vector2 operator*(const Vector2 &v) const;
-
-  /*!
-  * \brief Divide this vector to another.
-  * \return A vector with x and y components of this vector divided by x
-  * and y components of the other.
-  */
-  const Vector2 operator/(const Vector2 &v) const;
-
-  /*!
-  * \brief Add x and y components of the other vector to x and y components of
-  * this vector.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator+=(const Vector2<U> &v);
-
-  /*!
-  * \brief Substract x and y components of the other vector from x and y
-  * components of this vector.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator-=(const Vector2<U> &v);
-
-  /*!
-  * \brief Multiply x and y components of the this vector by x and y
-  * components of the other vector.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator*=(const Vector2<U> &v);
-
-  /*!
-  * \brief Divide x and y components of the this vector by x and y
-  * components of the other vector.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator/=(const Vector2<U> &v);
-
-  /*!
-  * \brief Return a copy of this vector with v added to x and y components.
-  * \return A copy of this vector with v added to x and y components.
-  */
-  template <typename U> const Vector2 operator+(U value) const;
-
-  /*!
-  * \brief Return a copy of this vector with v substracted from x and y
-  * components.
-  * \return A copy of this vector with v substracted from x and y components.
-  */
-  template <typename U> const Vector2 operator-(U value) const;
-
-  /*!
-  * \brief Return a copy of this vector with x and y components multiplied by
-  * v.
-  * \return A copy of this vector with x and y components multiplied by v.
-  */
-  template <typename U> const Vector2 operator*(U v) const;
-
-  /*!
-  * \brief Return a copy of this vector with x and y components divided by v.
-  * \return A copy of this vector with x and y components divided by v.
-  */
-  template <typename U> const Vector2 operator/(U v) const;
-
-  /*!
-  * \brief Add the given value to x and y components of this vector.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator+=(U v);
-
-  /*!
-  * \brief Substract the given value from x and y components of this vector.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator-=(U v);
-
-  /*!
-  * \brief Multiply x and y components of this vector by the given value.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator*=(U v);
-
-  /*!
-  * \brief Divide x and y components of this vector by the given value.
-  * \return This vector.
-  */
-  template <typename U> Vector2 &operator/=(U v);
-};
+  constexpr const T operator[](const std::size_t i) const;
 
-typedef Vector2<char> Vector2c;
-typedef Vector2<short int> Vector2si;
-typedef Vector2<int> Vector2i;
-typedef Vector2<long int> Vector2li;
-typedef Vector2<float> Vector2f;
-typedef Vector2<double> Vector2d;
-typedef Vector2<long double> Vector2ld;
-typedef Vector2<unsigned char> Vector2uc;
-typedef Vector2<unsigned short int> Vector2usi;
-typedef Vector2<unsigned int> Vector2ui;
-typedef Vector2<unsigned long int> Vector2uli;
-}
+  template <typename U>
+  constexpr Vector2 &operator=(const Vector2<U> &v) noexcept;
 
-#endif
+  template <typename U>
+  constexpr Vector2 &operator=(const U &value) noexcept;
 
-namespace fuzzyTelegram {
+  constexpr Vector2 operator-(void) const noexcept;
+
+  template <typename U>
+  constexpr bool operator==(const Vector2<U> &v) const noexcept;
+
+  template <typename U>
+  constexpr bool operator!=(const Vector2<U> &v) const noexcept;
+
+  constexpr const Vector2 operator+(const Vector2 &v) const noexcept;
+
+  constexpr const Vector2 operator-(const Vector2 &v) const noexcept;
 
-template <typename T> Vector2<T>::Vector2(void) : x(0), y(0) {}
+  constexpr const Vector2 operator*(const Vector2 &v) const noexcept;
+
+  constexpr const Vector2 operator/(const Vector2 &v) const noexcept;
+
+  template <typename U>
+  constexpr Vector2 &operator+=(const Vector2<U> &v) noexcept;
+
+  template <typename U>
+  constexpr Vector2 &operator-=(const Vector2<U> &v) noexcept;
+
+  template <typename U>
+  constexpr Vector2 &operator*=(const Vector2<U> &v) noexcept;
+
+  template <typename U>
+  constexpr Vector2 &operator/=(const Vector2<U> &v) noexcept;
+
+  template <typename U>
+  constexpr const Vector2 operator+(U value) const noexcept;
+
+  template <typename U>
+  constexpr const Vector2 operator-(U value) const noexcept;
+
+  template <typename U>
+  constexpr const Vector2 operator*(U v) const noexcept;
+
+  template <typename U>
+  constexpr const Vector2 operator/(U v) const noexcept;
+
+  template <typename U> constexpr Vector2 &operator+=(U v) noexcept;
+
+  template <typename U> constexpr Vector2 &operator-=(U v) noexcept;
+
+  template <typename U> constexpr Vector2 &operator*=(U v) noexcept;
+
+  template <typename U> constexpr Vector2 &operator/=(U v) noexcept;
+};
+
+template <typename T>
+constexpr Vector2<T>::Vector2(void) noexcept : x(0), y(0) {}
 
 template <typename T>
-Vector2<T>::Vector2(const T xValue, const T yValue) : x(xValue), y(yValue) {}
+constexpr Vector2<T>::Vector2(const T xValue, const T yValue) noexcept
+    : x(xValue), y(yValue) {}
 
-template <typename T> Vector2<T>::Vector2(const T xy) : x(xy), y(xy) {}
+template <typename T>
+constexpr Vector2<T>::Vector2(const T xy) noexcept : x(xy), y(xy) {}
 
 template <typename T>
 template <typename U>
-Vector2<T>::Vector2(const Vector2<U> &vector)
+constexpr Vector2<T>::Vector2(const Vector2<U> &vector) noexcept
     : x(static_cast<T>(vector.x)), y(static_cast<T>(vector.y)) {}
 
-template <typename T> Vector2<T>::~Vector2<T>() {}
-
-template <typename T> float Vector2<T>::magnitude() const {
-  return sqrt(x * x + y * y);
+template <typename T>
+template <typename Math>
+float Vector2<T>::magnitude() const {
+  return Math::sqrt(x * x + y * y);
 }
 
-template <typename T> float Vector2<T>::squaredMagnitude() const {
+template <typename T>
+constexpr float Vector2<T>::squaredMagnitude() const noexcept {
   return x * x + y * y;
 }
 
-template <typename T> void Vector2<T>::normalize() {
-  float length = this->magnitude();
-  x = x / length;
-  y = y / length;
+template <typename T> template <typename Math> void Vector2<T>::normalize() {
+  if (Math::PREFERS_RSQRT) {
+    float inverseLength = Math::rsqrt(x * x + y * y);
+    x = x * inverseLength;
+    y = y * inverseLength;
+  } else {
+    float length = this->template magnitude<Math>();
+    x = x / length;
+    y = y / length;
+  }
   assert(x <= 1 && x >= -1);
   assert(y <= 1 && y >= -1);
 }
@@ -386,53 +284,103 @@ template <typename T> std::string Vector2<T>::toString() const {
 
 template <typename T>
 template <typename U, typename V>
-void Vector2<T>::set(U xValue, V yValue) {
+constexpr void Vector2<T>::set(U xValue, V yValue) noexcept {
   x = static_cast<T>(xValue);
   y = static_cast<T>(yValue);
 }
 
-template <typename T> Vector2<T> Vector2<T>::normalized() const {
+template <typename T>
+template <typename Math>
+Vector2<T> Vector2<T>::normalized() const {
   Vector2<T> v(*this);
-  v.normalize();
+  v.template normalize<Math>();
   return v;
 }
 
-template <typename T> Vector2<T> Vector2<T>::up() { return Vector2<T>(0, 1); }
+template <typename T> constexpr Vector2<T> Vector2<T>::up() noexcept {
+  return Vector2<T>(0, 1);
+}
 
-template <typename T> Vector2<T> Vector2<T>::down() {
+template <typename T> constexpr Vector2<T> Vector2<T>::down() noexcept {
   return Vector2<T>(0, -1);
 }
 
-template <typename T> Vector2<T> Vector2<T>::left() {
+template <typename T> constexpr Vector2<T> Vector2<T>::left() noexcept {
   return Vector2<T>(-1, 0);
 }
 
-template <typename T> Vector2<T> Vector2<T>::right() {
+template <typename T> constexpr Vector2<T> Vector2<T>::right() noexcept {
   return Vector2<T>(1, 0);
 }
 
-template <typename T> Vector2<T> Vector2<T>::zero() { return Vector2<T>(0, 0); }
+template <typename T> constexpr Vector2<T> Vector2<T>::zero() noexcept {
+  return Vector2<T>(0, 0);
+}
 
-template <typename T> Vector2<T> Vector2<T>::one() { return Vector2<T>(1, 1); }
+template <typename T> constexpr Vector2<T> Vector2<T>::one() noexcept {
+  return Vector2<T>(1, 1);
+}
 
 template <typename T>
-float Vector2<T>::dot(const Vector2 &vector1, const Vector2 &vector2) {
+constexpr float Vector2<T>::dot(const Vector2 &vector1,
+                               const Vector2 &vector2) noexcept {
   return vector1.x * vector2.x + vector1.y * vector2.y;
 }
 
 template <typename T>
+template <typename Math>
 float Vector2<T>::angle(const Vector2 &from, const Vector2 &to) {
-  return acosf(Vector2<T>::dot(from.normalized(), to.normalized())) * 180 /
-         M_PI;
+  return Math::acos(Vector2<T>::dot(from.template normalized<Math>(),
+                                    to.template normalized<Math>())) *
+         180 / M_PI;
 }
 
 template <typename T>
+template <typename Math>
 float Vector2<T>::distance(const Vector2 &v, const Vector2 &u) {
-  return (v - u).magnitude();
+  return (v - u).template magnitude<Math>();
+}
+
+template <typename T>
+constexpr float Vector2<T>::squaredDistance(const Vector2 &v,
+                                            const Vector2 &u) noexcept {
+  return (v - u).squaredMagnitude();
+}
+
+template <typename T>
+constexpr bool Vector2<T>::isWithin(const Vector2 &v, const Vector2 &u,
+                                    float distance) noexcept {
+  return squaredDistance(v, u) <= distance * distance;
+}
+
+template <typename T>
+constexpr bool Vector2<T>::isCloser(const Vector2 &origin, const Vector2 &a,
+                                    const Vector2 &b) noexcept {
+  return squaredDistance(origin, a) < squaredDistance(origin, b);
+}
+
+template <typename T>
+template <typename Math>
+Vector2<T> Vector2<T>::clampMagnitude(const Vector2 &vector, float maxLength) {
+  float length = vector.template magnitude<Math>();
+  if (length <= maxLength)
+    return vector;
+  float ratio = maxLength / length;
+  return Vector2<T>(static_cast<T>(vector.x * ratio),
+                    static_cast<T>(vector.y * ratio));
+}
+
+template <typename T>
+constexpr Vector2<T> Vector2<T>::lerp(const Vector2 &vectorA,
+                                      const Vector2 &vectorB,
+                                      float t) noexcept {
+  t = t < 0 ? 0 : (t > 1 ? 1 : t);
+  return Vector2<T>(static_cast<T>(vectorA.x + (vectorB.x - vectorA.x) * t),
+                    static_cast<T>(vectorA.y + (vectorB.y - vectorA.y) * t));
 }
 
 template <typename T>
-const T Vector2<T>::operator[](const std::size_t i) const {
+constexpr const T Vector2<T>::operator[](const std::size_t i) const {
   if (i == 0)
     return x;
   else if (i == 1)
@@ -443,8 +391,7 @@ const T Vector2<T>::operator[](const std::size_t i) const {
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator=(const Vector2<U> &v) {
-  assert(v != NULL);
+constexpr Vector2<T> &Vector2<T>::operator=(const Vector2<U> &v) noexcept {
   x = static_cast<T>(v.x);
   y = static_cast<T>(v.y);
   return *this;
@@ -452,51 +399,56 @@ Vector2<T> &Vector2<T>::operator=(const Vector2<U> &v) {
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator=(const U &value) {
+constexpr Vector2<T> &Vector2<T>::operator=(const U &value) noexcept {
   x = static_cast<T>(value);
   y = static_cast<T>(value);
   return *this;
 }
 
-template <typename T> Vector2<T> Vector2<T>::operator-(void) const {
+template <typename T>
+constexpr Vector2<T> Vector2<T>::operator-(void) const noexcept {
   return Vector2<T>(-x, -y);
 }
 
 template <typename T>
 template <typename U>
-bool Vector2<T>::operator==(const Vector2<U> &v) const {
-  return static_cast<T>(v.x) == x && static_cast<T>(v.y) == v.y;
+constexpr bool Vector2<T>::operator==(const Vector2<U> &v) const noexcept {
+  return static_cast<T>(v.x) == x && static_cast<T>(v.y) == y;
 }
 
 template <typename T>
 template <typename U>
-bool Vector2<T>::operator!=(const Vector2<U> &v) const {
-  return static_cast<T>(v.x) != x || static_cast<T>(v.y) != v.y;
+constexpr bool Vector2<T>::operator!=(const Vector2<U> &v) const noexcept {
+  return static_cast<T>(v.x) != x || static_cast<T>(v.y) != y;
 }
 
 template <typename T>
-const Vector2<T> Vector2<T>::operator+(const Vector2<T> &v) const {
+constexpr const Vector2<T>
+Vector2<T>::operator+(const Vector2<T> &v) const noexcept {
   return Vector2<T>(x + v.x, y + v.y);
 }
 
 template <typename T>
-const Vector2<T> Vector2<T>::operator-(const Vector2<T> &v) const {
+constexpr const Vector2<T>
+Vector2<T>::operator-(const Vector2<T> &v) const noexcept {
   return Vector2<T>(x - v.x, y - v.y);
 }
 
 template <typename T>
-const Vector2<T> Vector2<T>::operator*(const Vector2<T> &v) const {
+constexpr const Vector2<T>
+Vector2<T>::operator*(const Vector2<T> &v) const noexcept {
   return Vector2<T>(x * v.x, y * v.y);
 }
 
 template <typename T>
-const Vector2<T> Vector2<T>::operator/(const Vector2<T> &v) const {
+constexpr const Vector2<T>
+Vector2<T>::operator/(const Vector2<T> &v) const noexcept {
   return Vector2<T>(x / v.x, y / v.y);
 }
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator+=(const Vector2<U> &v) {
+constexpr Vector2<T> &Vector2<T>::operator+=(const Vector2<U> &v) noexcept {
   x += v.x;
   y += v.y;
   return *this;
@@ -504,7 +456,7 @@ Vector2<T> &Vector2<T>::operator+=(const Vector2<U> &v) {
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator-=(const Vector2<U> &v) {
+constexpr Vector2<T> &Vector2<T>::operator-=(const Vector2<U> &v) noexcept {
   x -= v.x;
   y -= v.y;
   return *this;
@@ -512,7 +464,7 @@ Vector2<T> &Vector2<T>::operator-=(const Vector2<U> &v) {
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator*=(const Vector2<U> &v) {
+constexpr Vector2<T> &Vector2<T>::operator*=(const Vector2<U> &v) noexcept {
   x *= v.x;
   y *= v.y;
   return *this;
@@ -520,7 +472,7 @@ Vector2<T> &Vector2<T>::operator*=(const Vector2<U> &v) {
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator/=(const Vector2<U> &v) {
+constexpr Vector2<T> &Vector2<T>::operator/=(const Vector2<U> &v) noexcept {
   x /= v.x;
   y /= v.y;
   return *this;
@@ -528,32 +480,32 @@ Vector2<T> &Vector2<T>::operator/=(const Vector2<U> &v) {
 
 template <typename T>
 template <typename U>
-const Vector2<T> Vector2<T>::operator+(U value) const {
+constexpr const Vector2<T> Vector2<T>::operator+(U value) const noexcept {
   return Vector2<T>(x + static_cast<T>(value), y + static_cast<T>(value));
 }
 
 template <typename T>
 template <typename U>
-const Vector2<T> Vector2<T>::operator-(U value) const {
+constexpr const Vector2<T> Vector2<T>::operator-(U value) const noexcept {
   return Vector2<T>(x - static_cast<T>(value), y - static_cast<T>(value));
 }
 
 template <typename T>
 template <typename U>
-const Vector2<T> Vector2<T>::operator*(U value) const {
+constexpr const Vector2<T> Vector2<T>::operator*(U value) const noexcept {
   return Vector2<T>(x * static_cast<T>(value), y * static_cast<T>(value));
 }
 
 template <typename T>
 template <typename U>
-const Vector2<T> Vector2<T>::operator/(U value) const {
+constexpr const Vector2<T> Vector2<T>::operator/(U value) const noexcept {
   assert(value != 0);
   return Vector2<T>(x / static_cast<T>(value), y / static_cast<T>(value));
 }
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator+=(const U value) {
+constexpr Vector2<T> &Vector2<T>::operator+=(const U value) noexcept {
   x += static_cast<T>(value);
   y += static_cast<T>(value);
   return *this;
@@ -561,7 +513,7 @@ Vector2<T> &Vector2<T>::operator+=(const U value) {
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator-=(const U value) {
+constexpr Vector2<T> &Vector2<T>::operator-=(const U value) noexcept {
   x -= static_cast<T>(value);
   y -= static_cast<T>(value);
   return *this;
@@ -569,7 +521,7 @@ Vector2<T> &Vector2<T>::operator-=(const U value) {
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator*=(const U value) {
+constexpr Vector2<T> &Vector2<T>::operator*=(const U value) noexcept {
   x *= static_cast<T>(value);
   y *= static_cast<T>(value);
   return *this;
@@ -577,56 +529,3429 @@ Vector2<T> &Vector2<T>::operator*=(const U value) {
 
 template <typename T>
 template <typename U>
-Vector2<T> &Vector2<T>::operator/=(const U value) {
+constexpr Vector2<T> &Vector2<T>::operator/=(const U value) noexcept {
   x /= static_cast<T>(value);
   y /= static_cast<T>(value);
   return *this;
 }
 
-// template class Vector2<int>;
-// template class Vector2<float>;
+inline std::uint64_t integerSqrt(std::uint64_t n) {
+  std::uint64_t root =
+      static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+  while (root * root > n)
+    --root;
+  while ((root + 1) * (root + 1) <= n)
+    ++root;
+  return root;
+}
+
+template <typename T>
+bool stepTowards(Vector2<T> &position, const Vector2<T> &destination,
+                 T step) {
+  static_assert(std::is_integral<T>::value,
+                "stepTowards moves integer vectors.");
+  const std::int32_t dx = static_cast<std::int32_t>(destination.x - position.x);
+  const std::int32_t dy = static_cast<std::int32_t>(destination.y - position.y);
+  assert(dx > -(1 << 15) && dx < 1 << 15 && dy > -(1 << 15) && dy < 1 << 15);
+  const std::int32_t squaredLength = dx * dx + dy * dy;
+  const std::int32_t squaredStep = static_cast<std::int32_t>(step) * step;
+  if (squaredLength <= squaredStep) {
+    position = destination;
+    return true;
+  }
+  const std::int32_t offset = 4096;
+  const float scale = step / std::sqrt(static_cast<float>(squaredLength));
+  const float x = dx * scale + offset;
+  const float y = dy * scale + offset;
+  std::int32_t moveX = static_cast<std::int32_t>(x - 2e-3f);
+  std::int32_t moveY = static_cast<std::int32_t>(y - 2e-3f);
+  if (moveX != static_cast<std::int32_t>(x + 2e-3f) ||
+      moveY != static_cast<std::int32_t>(y + 2e-3f)) {
+    auto exact = [squaredLength, squaredStep](std::int64_t d, float move) {
+      const std::int64_t r = static_cast<std::int32_t>(move + 0.5f) - offset;
+      const std::int64_t scaled = r * r * squaredLength;
+      const std::int64_t target = d * d * squaredStep;
+      const bool below = d >= 0 ? scaled <= target : scaled >= target;
+      return static_cast<std::int32_t>(below ? r : r - 1) + offset;
+    };
+    moveX = exact(dx, x);
+    moveY = exact(dy, y);
+  }
+  position.x = static_cast<T>(position.x + (moveX - offset));
+  position.y = static_cast<T>(position.y + (moveY - offset));
+  return false;
+}
+
+typedef Vector2<char> Vector2c;
+typedef Vector2<short int> Vector2si;
+typedef Vector2<int> Vector2i;
+typedef Vector2<long int> Vector2li;
+typedef Vector2<float> Vector2f;
+typedef Vector2<double> Vector2d;
+typedef Vector2<long double> Vector2ld;
+typedef Vector2<unsigned char> Vector2uc;
+typedef Vector2<unsigned short int> Vector2usi;
+typedef Vector2<unsigned int> Vector2ui;
+typedef Vector2<unsigned long int> Vector2uli;
+
+static_assert(std::is_trivially_copyable<Vector2f>::value,
+              "Vector2 must stay trivially copyable to be memcpy'd in states.");
+}
+
+#endif
+#ifndef VECTOR2BATCH_H
+#define VECTOR2BATCH_H
+
+namespace fuzzyTelegram {
+
+template <typename T, std::size_t Capacity> class Vector2Batch {
+
+public:
+  static const std::size_t PADDED_CAPACITY = (Capacity + 7) / 8 * 8;
+
+  alignas(32) T xs[PADDED_CAPACITY];
+  alignas(32) T ys[PADDED_CAPACITY];
+
+  Vector2Batch(void);
+
+  std::size_t size() const;
+
+  void clear();
+
+  std::size_t push(const Vector2<T> &v);
+
+  void set(std::size_t i, const Vector2<T> &v);
+
+  Vector2<T> operator[](std::size_t i) const;
+
+  void squaredDistances(const Vector2<T> &point, T *out) const;
+
+  void dots(const Vector2<T> &v, T *out) const;
+
+  std::size_t nearest(const Vector2<T> &point,
+                      T *squaredDistance = nullptr) const;
+
+  bool anyWithin(const Vector2<T> &point, T radius) const;
+
+private:
+  std::size_t count;
+};
+}
+
+#endif
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+namespace fuzzyTelegram {
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+class SpatialGrid {
+
+public:
+  static const int COLUMNS = (Width + CellSize - 1) / CellSize;
+  static const int ROWS = (Height + CellSize - 1) / CellSize;
+  static const int CELLS = COLUMNS * ROWS;
+
+  typedef typename std::conditional<(Capacity < 255), std::uint8_t,
+                                    std::uint16_t>::type Index;
+  typedef Vector2Batch<float, Capacity> Positions;
+
+  static const Index NONE = static_cast<Index>(-1);
+
+  SpatialGrid(void);
+
+  void clear();
+
+  static Vector2i cellOf(const Vector2f &position);
+
+  void insert(std::size_t index, const Vector2f &position);
+
+  void remove(std::size_t index);
+
+  void move(std::size_t index, const Vector2f &position);
+
+  bool contains(std::size_t index) const;
+
+  std::size_t within(const Positions &positions, const Vector2f &center,
+                     float radius, Index *out, std::size_t maxCount) const;
+
+  std::size_t nearest(const Positions &positions, const Vector2f &center,
+                      std::size_t k, Index *out,
+                      float *squaredDistances) const;
+
+private:
+  Index heads[CELLS];
+  Index next[Capacity];
+  Index previous[Capacity];
+  std::uint16_t cells[Capacity];
+  bool inserted[Capacity];
+
+  static int cellIndex(const Vector2i &cell);
 };
+}
 
-using namespace std;
+#endif
+#ifndef ALIVEMASK_H
+#define ALIVEMASK_H
 
-/**
- * Shoot enemies before they collect all the incriminating data!
- * The closer you are to an enemy, the more damage you do but don't get too
- *close or you'll get killed.
- **/
-int main() {
+namespace fuzzyTelegram {
 
-  // game loop
-  while (1) {
-    int x;
-    int y;
-    cin >> x >> y;
-    cin.ignore();
-    int dataCount;
-    cin >> dataCount;
-    cin.ignore();
-    for (int i = 0; i < dataCount; i++) {
-      int dataId;
-      int dataX;
-      int dataY;
-      cin >> dataId >> dataX >> dataY;
-      cin.ignore();
-    }
-    int enemyCount;
-    cin >> enemyCount;
-    cin.ignore();
-    for (int i = 0; i < enemyCount; i++) {
-      int enemyId;
-      int enemyX;
-      int enemyY;
-      int enemyLife;
-      cin >> enemyId >> enemyX >> enemyY >> enemyLife;
-      cin.ignore();
-    }
+template <std::size_t Capacity> class AliveMask {
 
-    // Write an action using cout. DON'T FORGET THE "<< endl"
-    // To debug: cerr << "Debug messages..." << endl;
+public:
+  static const std::size_t WORDS = (Capacity + 63) / 64;
 
-    cout << "MOVE 0 0" << endl; // MOVE x y or SHOOT id
-  }
+  std::uint64_t words[WORDS];
+
+  AliveMask(void);
+
+  void clear();
+
+  void set(std::size_t i);
+
+  void reset(std::size_t i);
+
+  bool operator[](std::size_t i) const;
+
+  std::size_t count() const;
+
+  std::size_t next(std::size_t from) const;
+};
+}
+
+#endif
+#ifndef DAMAGE_H
+#define DAMAGE_H
+
+namespace fuzzyTelegram {
+
+int shotDamage(float distance);
+
+class DamageTable {
+
+public:
+  static const int MIN_EXPONENT = 16;
+  static const int MAX_EXPONENT = 29;
+  static const int SUBDIVISION_BITS = 8;
+  static const int BUCKETS = (MAX_EXPONENT - MIN_EXPONENT) << SUBDIVISION_BITS;
+
+  static const int MAX_DAMAGE = 255;
+
+  DamageTable();
+
+  int damage(float squaredDistance) const;
+
+  float reach(int damage) const;
+
+private:
+  std::uint8_t buckets[BUCKETS];
+
+  float thresholds[MAX_DAMAGE + 2];
+};
+
+int shotDamageSquared(float squaredDistance);
+
+int shotsToKill(int life, float squaredDistance);
+}
+
+#endif
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+namespace fuzzyTelegram {
+
+const int MAX_DATA_POINTS = 100;
+const int MAX_ENEMIES = 100;
+constexpr float MAP_WIDTH = 16000.0f;
+constexpr float MAP_HEIGHT = 9000.0f;
+const float WOLFF_STEP = 1000.0f;
+const float ENEMY_STEP = 500.0f;
+const float KILL_RANGE = 2000.0f;
+
+const int TARGET_SLACK = 3;
+
+const float REMOVED_POSITION = 1e6f;
+
+const int DATA_GRID_CELL_SIZE = 1000;
+const int DATA_GRID_THRESHOLD = 64;
+
+typedef SpatialGrid<MAX_DATA_POINTS, static_cast<int>(MAP_WIDTH),
+                    static_cast<int>(MAP_HEIGHT), DATA_GRID_CELL_SIZE>
+    DataGrid;
+
+struct Action {
+  enum Type { MOVE, SHOOT };
+
+  Type type;
+
+  Vector2f destination;
+
+  int enemy;
+
+  Action(void);
+
+  static Action move(const Vector2f &destination);
+
+  static Action shoot(int enemy);
+
+  bool operator==(const Action &other) const;
+};
+
+struct ActionStatistics {
+  Action action;
+  float valueSum;
+  int visits;
+};
+
+struct GameState {
+  Vector2f wolff;
+  bool wolffDead;
+  int turn;
+
+  int dataCount;
+  int dataRemaining;
+  Vector2Batch<float, MAX_DATA_POINTS> dataPositions;
+  int dataIds[MAX_DATA_POINTS];
+  AliveMask<MAX_DATA_POINTS> dataAlive;
+
+  DataGrid dataGrid;
+
+  int enemyCount;
+  int enemiesRemaining;
+  Vector2Batch<float, MAX_ENEMIES> enemyPositions;
+  int enemyIds[MAX_ENEMIES];
+  int enemyLives[MAX_ENEMIES];
+  AliveMask<MAX_ENEMIES> enemyAlive;
+
+  int enemyTargets[MAX_ENEMIES];
+
+  int enemyTargetTurns[MAX_ENEMIES];
+
+  int initialTotalLife;
+  int shots;
+  int kills;
+
+  GameState(void);
+
+  void clear();
+
+  int addDataPoint(int id, const Vector2f &position);
+
+  int addEnemy(int id, const Vector2f &position, int life);
+
+  void removeDataPoint(int slot);
+
+  void removeEnemy(int slot);
+
+  void restoreDataPoint(int slot, const Vector2f &position);
+
+  void restoreEnemy(int slot, const Vector2f &position);
+
+  void invalidateTargets();
+
+  int findEnemy(int id) const;
+
+  bool isOver() const;
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+              "GameState must be copied with memcpy");
+
+struct NoRecorder {
+  void beginTurn(const GameState &) {}
+  void targetChanged(int, int, int) {}
+  void enemyMoved(int, const Vector2f &) {}
+  void enemyHit(int, int) {}
+  void enemyRemoved(int, const Vector2f &) {}
+  void dataRemoved(int, const Vector2f &) {}
+};
+
+int nearestDataPoint(const GameState &state, const Vector2f &position);
+
+int updateTargets(GameState &state);
+
+template <typename Recorder>
+int updateTargets(GameState &state, Recorder &recorder);
+
+bool verifyTargets(const GameState &state);
+
+Vector2f clampToMap(const Vector2f &position);
+
+Action playableAction(const GameState &state, const Action &action);
+
+bool moveTowards(Vector2f &position, const Vector2f &destination, float step);
+
+void simulate(GameState &state, const Action &action);
+
+template <typename Recorder>
+void simulate(GameState &state, const Action &action, Recorder &recorder);
+
+int score(const GameState &state);
+
+float evaluate(const GameState &state);
+
+float evaluate(const GameState &state, int shots);
+}
+
+#endif
+#ifndef DIVERGENCE_H
+#define DIVERGENCE_H
+
+namespace fuzzyTelegram {
+
+struct Divergence {
+  float wolffError;
+
+  int enemies;
+
+  int enemiesMoved;
+
+  float maxEnemyError;
+
+  int livesChanged;
+
+  int enemiesMissed;
+
+  int dataMissed;
+
+  Divergence(void);
+
+  bool exact() const;
+};
+
+class DivergenceTracker {
+
+public:
+  static const int MAX_PRINTED_ENEMIES = 4;
+
+  DivergenceTracker(void);
+
+  void predict(const GameState &root, const Action &action);
+
+  bool hasPrediction() const;
+
+  const Divergence &compare(const GameState &observed);
+
+  const GameState &prediction() const;
+
+  void printTurn(std::ostream &output) const;
+
+  void printTotals(std::ostream &output) const;
+
+  int turns() const;
+
+  int exactTurns() const;
+
+private:
+  GameState predicted;
+  bool pending;
+  Divergence last;
+
+  int printedIds[MAX_PRINTED_ENEMIES];
+  Vector2f printedPredicted[MAX_PRINTED_ENEMIES];
+  Vector2f printedObserved[MAX_PRINTED_ENEMIES];
+  int printedLives[MAX_PRINTED_ENEMIES][2];
+  int printed;
+
+  int compared;
+  int exactCount;
+  int wolffErrors;
+  int enemiesMoved;
+  int livesChanged;
+  int entitiesMissed;
+  float maxEnemyError;
+};
+}
+
+#endif
+#ifndef THREATMAP_H
+#define THREATMAP_H
+
+namespace fuzzyTelegram {
+
+class ThreatMap {
+
+public:
+  static const int CELL_SIZE = 250;
+  static const int COLUMNS =
+      (static_cast<int>(MAP_WIDTH) + CELL_SIZE - 1) / CELL_SIZE;
+  static const int ROWS =
+      (static_cast<int>(MAP_HEIGHT) + CELL_SIZE - 1) / CELL_SIZE;
+  static const int CELLS = COLUMNS * ROWS;
+
+  static const int NEVER = 255;
+
+  ThreatMap(void);
+
+  void build(const GameState &state);
+
+  int enemyRemoved(int slot);
+
+  int earliestTurn(const Vector2f &position) const;
+
+  bool isSafe(const Vector2f &position, int turns) const;
+
+  int cellTurn(int column, int row) const;
+
+private:
+  Vector2Batch<float, CELLS> centers;
+
+  Vector2Batch<float, MAX_ENEMIES> origins;
+  int enemies;
+
+  float closest[CELLS];
+
+  std::uint8_t turns[CELLS];
+
+  float scratch[CELLS];
+
+  static int cellIndex(const Vector2f &position);
+
+  static std::uint8_t turnOf(float squaredDistance);
+};
+}
+
+#endif
+#ifndef INPUTREADER_H
+#define INPUTREADER_H
+
+namespace fuzzyTelegram {
+
+class InputReader {
+
+public:
+  static const std::size_t BUFFER_SIZE = 1 << 16;
+
+  explicit InputReader(int fd = 0);
+
+  bool waitInput();
+
+  bool readInt(int &value);
+
+  template <typename T> bool readVector2(Vector2<T> &v);
+
+  bool readTurn(GameState &state);
+
+  bool eof() const;
+
+  friend InputReader &operator>>(InputReader &input, int &value) {
+    input.readInt(value);
+    return input;
+  }
+
+  template <typename T>
+  friend InputReader &operator>>(InputReader &input, Vector2<T> &v) {
+    input.readVector2(v);
+    return input;
+  }
+
+private:
+  int fd;
+  std::size_t position;
+  std::size_t end;
+  bool ended;
+  char buffer[BUFFER_SIZE];
+
+  bool refill();
+};
+}
+
+#endif
+#ifndef TURNCLOCK_H
+#define TURNCLOCK_H
+
+namespace fuzzyTelegram {
+
+class TurnClock {
+
+public:
+  static constexpr double FIRST_TURN_BUDGET_MS = 1000;
+  static constexpr double TURN_BUDGET_MS = 100;
+
+  TurnClock(double firstTurnBudgetMs = FIRST_TURN_BUDGET_MS,
+            double turnBudgetMs = TURN_BUDGET_MS);
+
+  void startTurn();
+
+  int turn() const;
+
+  double budgetMs() const;
+
+  double elapsedMs() const;
+
+  double remainingMs() const;
+
+  bool expired(double marginMs = 0) const;
+
+  static std::uint64_t now();
+
+  static double ticksPerMs();
+
+private:
+  double firstTurnBudget;
+  double turnBudget;
+  double ticks;
+  int turns;
+  std::uint64_t start;
+  std::uint64_t deadline;
+};
+}
+
+#endif
+#ifndef ANYTIMESEARCH_H
+#define ANYTIMESEARCH_H
+
+namespace fuzzyTelegram {
+
+struct AnytimeConfig {
+  unsigned checkInterval;
+
+  double safetyMarginMs;
+
+  AnytimeConfig(unsigned checkInterval = 64, double safetyMarginMs = 10);
+};
+
+template <typename Search>
+unsigned long runAnytime(Search &search, const TurnClock &clock,
+                         const AnytimeConfig &config = AnytimeConfig());
+}
+
+#endif
+#ifndef RANDOM_H
+#define RANDOM_H
+
+namespace fuzzyTelegram {
+
+std::uint64_t splitMix64(std::uint64_t &state);
+
+inline std::uint32_t rotateLeft(std::uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+inline float unitFloat(std::uint32_t x) {
+  return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+class FastRandom {
+
+public:
+  typedef std::uint32_t result_type;
+
+  explicit FastRandom(std::uint64_t seed = 0);
+
+  void seed(std::uint64_t seed);
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+  std::uint32_t operator()();
+
+  std::uint32_t below(std::uint32_t bound);
+
+  int range(int low, int high);
+
+  float unit();
+
+  bool coin();
+
+  Vector2f direction();
+
+  Vector2f inDisc(float radius);
+
+private:
+  std::uint32_t s[4];
+};
+}
+
+#endif
+#ifndef ROLLOUTPLANNER_H
+#define ROLLOUTPLANNER_H
+
+namespace fuzzyTelegram {
+
+class RolloutPlanner {
+
+public:
+  static const int DEPTH = 8;
+
+  static const int MOVE_TRIES = 3;
+
+  explicit RolloutPlanner(unsigned seed = 0);
+
+  void reset(const GameState &root, const Action &played);
+
+  void reset(const GameState &root);
+
+  void iterate();
+
+  Action bestAction() const;
+
+  float bestValue() const;
+
+  int bestSequenceLength() const;
+
+  unsigned long rollouts() const;
+
+  int rootStatistics(ActionStatistics *out, int capacity) const;
+
+private:
+  GameState root;
+  GameState scratch;
+  Action best[DEPTH];
+  Action candidate[DEPTH];
+  float bestSequenceValue;
+  int bestLength;
+  bool hasBest;
+  unsigned long rolloutCount;
+  FastRandom random;
+
+  ThreatMap threats;
+
+  Action randomAction(const GameState &state, int turn);
+
+  float rollout(Action *sequence, int keep, int &length);
+};
+}
+
+#endif
+#ifndef EVOLUTIONPLANNER_H
+#define EVOLUTIONPLANNER_H
+
+namespace fuzzyTelegram {
+
+struct Gene {
+  enum Kind { MOVE, SHOOT };
+
+  std::uint8_t kind;
+  std::uint8_t enemy;
+
+  std::uint16_t angle;
+
+  std::uint16_t distance;
+
+  static Gene fromBits(const std::uint32_t *bits, int enemies);
+
+  Action decode(const GameState &state) const;
+};
+
+class EvolutionPlanner {
+
+public:
+  static const int HORIZON = 8;
+  static const int POPULATION = 24;
+  static const int TOURNAMENT = 3;
+
+  explicit EvolutionPlanner(unsigned seed = 0);
+
+  void reset(const GameState &root, const Action &played);
+
+  void reset(const GameState &root);
+
+  void iterate();
+
+  Action bestAction() const;
+
+  float bestValue() const;
+
+  unsigned long rollouts() const;
+
+  int rootStatistics(ActionStatistics *out, int capacity) const;
+
+private:
+  struct Genome {
+    Gene genes[HORIZON];
+    float value;
+  };
+
+  GameState root;
+  GameState scratch;
+  Genome population[POPULATION];
+  Genome child;
+  int best;
+  int worst;
+  bool initialized;
+  unsigned long rolloutCount;
+  FastRandom random;
+
+  Gene randomGene();
+
+  int tournament();
+
+  void evaluate(Genome &genome);
+
+  void rank();
+};
+}
+
+#endif
+#ifndef ARENA_H
+#define ARENA_H
+
+namespace fuzzyTelegram {
+
+class Arena {
+
+public:
+  Arena(void);
+
+  ~Arena();
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  void reserve(std::size_t bytes);
+
+  void *allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  std::size_t mark() const;
+
+  void release(std::size_t mark);
+
+  void reset();
+
+  std::size_t capacity() const;
+  std::size_t used() const;
+
+  std::size_t peak() const;
+
+private:
+  unsigned char *buffer;
+  std::size_t size;
+  std::size_t offset;
+  std::size_t highWater;
+};
+
+template <typename Node> class NodePool {
+
+public:
+  typedef std::int32_t Index;
+
+  static const Index NONE = -1;
+
+  explicit NodePool(Arena &arena);
+
+  Index size() const;
+
+  void clear();
+
+  Index create();
+
+  Node &operator[](Index i);
+  const Node &operator[](Index i) const;
+
+  Index keepSubtree(Index root);
+
+private:
+  Arena &arena;
+  Node *nodes;
+  Index count;
+};
+}
+
+#endif
+#ifndef MCTSPLANNER_H
+#define MCTSPLANNER_H
+
+namespace fuzzyTelegram {
+
+struct MctsNode {
+  NodePool<MctsNode>::Index firstChild;
+  NodePool<MctsNode>::Index nextSibling;
+  Action action;
+
+  float rotation;
+
+  float valueSum;
+  int visits;
+
+  std::uint16_t expanded;
+};
+
+class MctsPlanner {
+
+public:
+  static const std::size_t ARENA_BYTES = 64 << 20;
+  static const int PLAYOUT_DEPTH = 6;
+  static const int MAX_MOVES = 16;
+  static constexpr float WIDENING = 1.0f;
+  static constexpr float EXPLORATION = 0.7f;
+
+  explicit MctsPlanner(Arena &arena, unsigned seed = 0);
+
+  void reset(const GameState &root, const Action &played);
+
+  void reset(const GameState &root);
+
+  void iterate();
+
+  Action bestAction() const;
+
+  float bestValue() const;
+
+  unsigned long rollouts() const;
+
+  int rootStatistics(ActionStatistics *out, int capacity) const;
+
+  int depth() const;
+
+  int nodes() const;
+
+private:
+  typedef NodePool<MctsNode>::Index Index;
+
+  static const int MAX_DEPTH = 64;
+
+  Arena &arena;
+  NodePool<MctsNode> pool;
+  GameState root;
+  GameState scratch;
+  float valueScale;
+  unsigned long playoutCount;
+  int maxDepth;
+  bool hasTree;
+  FastRandom random;
+
+  Index findChild(Index node, const Action &action) const;
+
+  Index mostVisited(Index node) const;
+
+  Index select(Index node) const;
+
+  Index expand(Index node, const GameState &state);
+
+  static int candidateCount(const GameState &state);
+
+  Action candidate(const GameState &state, int index, float rotation);
+
+  Action randomAction(const GameState &state);
+
+  Index createNode(const Action &action);
+};
+}
+
+#endif
+#ifndef BEAMPLANNER_H
+#define BEAMPLANNER_H
+
+namespace fuzzyTelegram {
+
+class BeamPlanner {
+
+public:
+  static const int DEFAULT_WIDTH = 64;
+  static const int DEFAULT_DEPTH = 6;
+  static const int MIN_WIDTH = 8;
+  static const int RADII = 3;
+  static const int MOVES = 8 * RADII;
+
+  explicit BeamPlanner(unsigned seed = 0, int width = DEFAULT_WIDTH,
+                       int depth = DEFAULT_DEPTH);
+
+  void reset(const GameState &root, const Action &played);
+
+  void reset(const GameState &root);
+
+  void iterate();
+
+  Action bestAction() const;
+
+  float bestValue() const;
+
+  unsigned long rollouts() const;
+
+  int rootStatistics(ActionStatistics *out, int capacity) const;
+
+  int width() const;
+
+  bool isDone() const;
+
+  unsigned long duplicates() const;
+
+private:
+  struct Node {
+    GameState state;
+    Action first;
+
+    float value;
+  };
+
+  const int maxWidth;
+  const int depth;
+  Vector2f moves[MOVES];
+
+  GameState root;
+  GameState scratch;
+
+  std::vector<Node> layers[2];
+  int current;
+  int currentCount;
+  int nextCount;
+
+  int nextWorst;
+
+  std::vector<int> order;
+
+  int searchWidth;
+  int layer;
+  int parent;
+  int child;
+  bool done;
+
+  std::vector<std::uint64_t> seenHashes;
+  std::vector<std::uint32_t> seenStamps;
+  std::uint32_t stamp;
+
+  Action best;
+  float bestSequenceValue;
+  Action searchBest;
+  float searchBestValue;
+  int searchBestLayer;
+
+  unsigned long rolloutCount;
+  unsigned long duplicateCount;
+
+  void startSearch();
+
+  void nextLayer();
+
+  void offer(const GameState &state, const Action &first);
+
+  bool insertSeen(std::uint64_t hash);
+
+  static std::uint64_t hashState(const GameState &state);
+};
+}
+
+#endif
+#ifndef PHASETRACE_H
+#define PHASETRACE_H
+
+#ifdef FUZZY_TRACE
+
+namespace fuzzyTelegram {
+
+enum Phase { PHASE_PARSE, PHASE_RESET, PHASE_SEARCH, PHASE_OUTPUT, PHASE_COUNT };
+
+const char *phaseName(Phase phase);
+
+class PhaseTrace {
+
+public:
+  static const int CAPACITY = 4096;
+
+  struct Event {
+    Phase phase;
+    int turn;
+    std::uint64_t start;
+    std::uint64_t end;
+  };
+
+  PhaseTrace(void);
+
+  void record(Phase phase, std::uint64_t start, std::uint64_t end);
+
+  double turnMs(Phase phase) const;
+
+  void endTurn(std::ostream &out);
+
+  int size() const;
+
+  const Event &event(int i) const;
+
+  bool writeChromeTrace(const char *path) const;
+
+private:
+  Event events[CAPACITY];
+  long count;
+  int turns;
+  std::uint64_t turnTicks[PHASE_COUNT];
+};
+
+class ScopedPhase {
+
+public:
+  ScopedPhase(PhaseTrace &trace, Phase phase);
+  ~ScopedPhase();
+
+  ScopedPhase(const ScopedPhase &) = delete;
+  ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+private:
+  PhaseTrace &trace;
+  Phase phase;
+  std::uint64_t start;
+};
+}
+
+#define FUZZY_PHASE_JOIN(a, b) a##b
+#define FUZZY_PHASE_NAME(line) FUZZY_PHASE_JOIN(scopedPhase, line)
+#define FUZZY_PHASE(trace, phase)                                             \
+  fuzzyTelegram::ScopedPhase FUZZY_PHASE_NAME(__LINE__)(trace, phase)
+
+#else
+
+#define FUZZY_PHASE(trace, phase)
+
+#endif
+
+#endif
+#if defined(__AVX__) || defined(FUZZY_TARGET_AVX2)
+#define FUZZY_BATCH_AVX
+#endif
+#if defined(__SSE2__) || defined(FUZZY_BATCH_AVX)
+#endif
+
+namespace fuzzyTelegram {
+
+namespace batchKernels {
+
+template <typename T>
+void squaredDistances(const T *xs, const T *ys, std::size_t n, T px, T py,
+                      T *out) {
+  for (std::size_t i = 0; i < n; ++i) {
+    T dx = xs[i] - px;
+    T dy = ys[i] - py;
+    out[i] = dx * dx + dy * dy;
+  }
+}
+
+template <typename T>
+void dots(const T *xs, const T *ys, std::size_t n, T vx, T vy, T *out) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = xs[i] * vx + ys[i] * vy;
+}
+
+template <typename T>
+std::size_t nearest(const T *xs, const T *ys, std::size_t begin,
+                    std::size_t n, T px, T py, std::size_t best,
+                    T &bestDistance) {
+  for (std::size_t i = begin; i < n; ++i) {
+    T dx = xs[i] - px;
+    T dy = ys[i] - py;
+    T distance = dx * dx + dy * dy;
+    if (best == n || distance < bestDistance) {
+      best = i;
+      bestDistance = distance;
+    }
+  }
+  return best;
+}
+
+template <typename T>
+bool anyWithin(const T *xs, const T *ys, std::size_t begin, std::size_t n,
+               T px, T py, T squaredRadius) {
+  for (std::size_t i = begin; i < n; ++i) {
+    T dx = xs[i] - px;
+    T dy = ys[i] - py;
+    if (dx * dx + dy * dy <= squaredRadius)
+      return true;
+  }
+  return false;
+}
+
+#if defined(FUZZY_BATCH_AVX)
+
+inline void squaredDistances(const float *xs, const float *ys, std::size_t n,
+                             float px, float py, float *out) {
+  const __m256 x = _mm256_set1_ps(px);
+  const __m256 y = _mm256_set1_ps(py);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_load_ps(xs + i), x);
+    __m256 dy = _mm256_sub_ps(_mm256_load_ps(ys + i), y);
+    _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(dx, dx),
+                                            _mm256_mul_ps(dy, dy)));
+  }
+  squaredDistances<float>(xs + i, ys + i, n - i, px, py, out + i);
+}
+
+inline void dots(const float *xs, const float *ys, std::size_t n, float vx,
+                 float vy, float *out) {
+  const __m256 x = _mm256_set1_ps(vx);
+  const __m256 y = _mm256_set1_ps(vy);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(out + i,
+                     _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(xs + i), x),
+                                   _mm256_mul_ps(_mm256_load_ps(ys + i), y)));
+  dots<float>(xs + i, ys + i, n - i, vx, vy, out + i);
+}
+
+inline std::size_t nearest(const float *xs, const float *ys, std::size_t n,
+                           float px, float py, float &bestDistance) {
+  const __m256 x = _mm256_set1_ps(px);
+  const __m256 y = _mm256_set1_ps(py);
+  __m256 index = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256 step = _mm256_set1_ps(8);
+  __m256 lanesDistance = _mm256_set1_ps(std::numeric_limits<float>::max());
+  __m256 lanesIndex = _mm256_set1_ps(-1);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_load_ps(xs + i), x);
+    __m256 dy = _mm256_sub_ps(_mm256_load_ps(ys + i), y);
+    __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    __m256 closer = _mm256_cmp_ps(d, lanesDistance, _CMP_LT_OQ);
+    lanesDistance = _mm256_blendv_ps(lanesDistance, d, closer);
+    lanesIndex = _mm256_blendv_ps(lanesIndex, index, closer);
+    index = _mm256_add_ps(index, step);
+  }
+  alignas(32) float distances[8];
+  alignas(32) float indices[8];
+  _mm256_store_ps(distances, lanesDistance);
+  _mm256_store_ps(indices, lanesIndex);
+  std::size_t best = n;
+  for (int lane = 0; lane < 8; ++lane) {
+    if (indices[lane] < 0)
+      continue;
+    std::size_t laneBest = static_cast<std::size_t>(indices[lane]);
+    if (best == n || distances[lane] < bestDistance ||
+        (distances[lane] == bestDistance && laneBest < best)) {
+      best = laneBest;
+      bestDistance = distances[lane];
+    }
+  }
+  return nearest<float>(xs, ys, i, n, px, py, best, bestDistance);
+}
+
+inline bool anyWithin(const float *xs, const float *ys, std::size_t n,
+                      float px, float py, float squaredRadius) {
+  const __m256 x = _mm256_set1_ps(px);
+  const __m256 y = _mm256_set1_ps(py);
+  const __m256 r = _mm256_set1_ps(squaredRadius);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_load_ps(xs + i), x);
+    __m256 dy = _mm256_sub_ps(_mm256_load_ps(ys + i), y);
+    __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    if (_mm256_movemask_ps(_mm256_cmp_ps(d, r, _CMP_LE_OQ)))
+      return true;
+  }
+  return anyWithin<float>(xs, ys, i, n, px, py, squaredRadius);
+}
+
+#elif defined(__SSE2__)
+
+inline void squaredDistances(const float *xs, const float *ys, std::size_t n,
+                             float px, float py, float *out) {
+  const __m128 x = _mm_set1_ps(px);
+  const __m128 y = _mm_set1_ps(py);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 dx = _mm_sub_ps(_mm_load_ps(xs + i), x);
+    __m128 dy = _mm_sub_ps(_mm_load_ps(ys + i), y);
+    _mm_storeu_ps(out + i,
+                  _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+  }
+  squaredDistances<float>(xs + i, ys + i, n - i, px, py, out + i);
+}
+
+inline void dots(const float *xs, const float *ys, std::size_t n, float vx,
+                 float vy, float *out) {
+  const __m128 x = _mm_set1_ps(vx);
+  const __m128 y = _mm_set1_ps(vy);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(xs + i), x),
+                                      _mm_mul_ps(_mm_load_ps(ys + i), y)));
+  dots<float>(xs + i, ys + i, n - i, vx, vy, out + i);
+}
+
+inline std::size_t nearest(const float *xs, const float *ys, std::size_t n,
+                           float px, float py, float &bestDistance) {
+  const __m128 x = _mm_set1_ps(px);
+  const __m128 y = _mm_set1_ps(py);
+  __m128 index = _mm_setr_ps(0, 1, 2, 3);
+  const __m128 step = _mm_set1_ps(4);
+  __m128 lanesDistance = _mm_set1_ps(std::numeric_limits<float>::max());
+  __m128 lanesIndex = _mm_set1_ps(-1);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 dx = _mm_sub_ps(_mm_load_ps(xs + i), x);
+    __m128 dy = _mm_sub_ps(_mm_load_ps(ys + i), y);
+    __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    __m128 closer = _mm_cmplt_ps(d, lanesDistance);
+    lanesDistance = _mm_or_ps(_mm_and_ps(closer, d),
+                              _mm_andnot_ps(closer, lanesDistance));
+    lanesIndex = _mm_or_ps(_mm_and_ps(closer, index),
+                           _mm_andnot_ps(closer, lanesIndex));
+    index = _mm_add_ps(index, step);
+  }
+  alignas(16) float distances[4];
+  alignas(16) float indices[4];
+  _mm_store_ps(distances, lanesDistance);
+  _mm_store_ps(indices, lanesIndex);
+  std::size_t best = n;
+  for (int lane = 0; lane < 4; ++lane) {
+    if (indices[lane] < 0)
+      continue;
+    std::size_t laneBest = static_cast<std::size_t>(indices[lane]);
+    if (best == n || distances[lane] < bestDistance ||
+        (distances[lane] == bestDistance && laneBest < best)) {
+      best = laneBest;
+      bestDistance = distances[lane];
+    }
+  }
+  return nearest<float>(xs, ys, i, n, px, py, best, bestDistance);
+}
+
+inline bool anyWithin(const float *xs, const float *ys, std::size_t n,
+                      float px, float py, float squaredRadius) {
+  const __m128 x = _mm_set1_ps(px);
+  const __m128 y = _mm_set1_ps(py);
+  const __m128 r = _mm_set1_ps(squaredRadius);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 dx = _mm_sub_ps(_mm_load_ps(xs + i), x);
+    __m128 dy = _mm_sub_ps(_mm_load_ps(ys + i), y);
+    __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    if (_mm_movemask_ps(_mm_cmple_ps(d, r)))
+      return true;
+  }
+  return anyWithin<float>(xs, ys, i, n, px, py, squaredRadius);
+}
+
+#endif
+
+template <typename T>
+std::size_t nearest(const T *xs, const T *ys, std::size_t n, T px, T py,
+                    T &bestDistance) {
+  return nearest<T>(xs, ys, 0, n, px, py, n, bestDistance);
+}
+
+template <typename T>
+bool anyWithin(const T *xs, const T *ys, std::size_t n, T px, T py,
+               T squaredRadius) {
+  return anyWithin<T>(xs, ys, 0, n, px, py, squaredRadius);
+}
+}
+
+template <typename T, std::size_t Capacity>
+Vector2Batch<T, Capacity>::Vector2Batch(void) : count(0) {}
+
+template <typename T, std::size_t Capacity>
+std::size_t Vector2Batch<T, Capacity>::size() const {
+  return count;
+}
+
+template <typename T, std::size_t Capacity>
+void Vector2Batch<T, Capacity>::clear() {
+  count = 0;
+}
+
+template <typename T, std::size_t Capacity>
+std::size_t Vector2Batch<T, Capacity>::push(const Vector2<T> &v) {
+  assert(count < Capacity);
+  xs[count] = v.x;
+  ys[count] = v.y;
+  return count++;
+}
+
+template <typename T, std::size_t Capacity>
+void Vector2Batch<T, Capacity>::set(std::size_t i, const Vector2<T> &v) {
+  assert(i < count);
+  xs[i] = v.x;
+  ys[i] = v.y;
+}
+
+template <typename T, std::size_t Capacity>
+Vector2<T> Vector2Batch<T, Capacity>::operator[](std::size_t i) const {
+  assert(i < count);
+  return Vector2<T>(xs[i], ys[i]);
+}
+
+template <typename T, std::size_t Capacity>
+void Vector2Batch<T, Capacity>::squaredDistances(const Vector2<T> &point,
+                                                 T *out) const {
+  batchKernels::squaredDistances(xs, ys, count, point.x, point.y, out);
+}
+
+template <typename T, std::size_t Capacity>
+void Vector2Batch<T, Capacity>::dots(const Vector2<T> &v, T *out) const {
+  batchKernels::dots(xs, ys, count, v.x, v.y, out);
+}
+
+template <typename T, std::size_t Capacity>
+std::size_t Vector2Batch<T, Capacity>::nearest(const Vector2<T> &point,
+                                               T *squaredDistance) const {
+  T bestDistance = T();
+  std::size_t best =
+      batchKernels::nearest(xs, ys, count, point.x, point.y, bestDistance);
+  if (squaredDistance != nullptr)
+    *squaredDistance = bestDistance;
+  return best;
+}
+
+template <typename T, std::size_t Capacity>
+bool Vector2Batch<T, Capacity>::anyWithin(const Vector2<T> &point,
+                                          T radius) const {
+  return batchKernels::anyWithin(xs, ys, count, point.x, point.y,
+                                 radius * radius);
+}
+}
+
+namespace fuzzyTelegram {
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+const int SpatialGrid<Capacity, Width, Height, CellSize>::COLUMNS;
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+const int SpatialGrid<Capacity, Width, Height, CellSize>::ROWS;
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+const int SpatialGrid<Capacity, Width, Height, CellSize>::CELLS;
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+const typename SpatialGrid<Capacity, Width, Height, CellSize>::Index
+    SpatialGrid<Capacity, Width, Height, CellSize>::NONE;
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+SpatialGrid<Capacity, Width, Height, CellSize>::SpatialGrid(void) {
+  clear();
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+void SpatialGrid<Capacity, Width, Height, CellSize>::clear() {
+  std::fill(heads, heads + CELLS, NONE);
+  std::fill(inserted, inserted + Capacity, false);
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+Vector2i SpatialGrid<Capacity, Width, Height, CellSize>::cellOf(
+    const Vector2f &position) {
+  int column = static_cast<int>(position.x) / CellSize;
+  int row = static_cast<int>(position.y) / CellSize;
+  return Vector2i(std::min(std::max(column, 0), COLUMNS - 1),
+                  std::min(std::max(row, 0), ROWS - 1));
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+int SpatialGrid<Capacity, Width, Height, CellSize>::cellIndex(
+    const Vector2i &cell) {
+  return cell.y * COLUMNS + cell.x;
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+void SpatialGrid<Capacity, Width, Height, CellSize>::insert(
+    std::size_t index, const Vector2f &position) {
+  assert(index < Capacity && !inserted[index]);
+  int cell = cellIndex(cellOf(position));
+  Index head = heads[cell];
+  next[index] = head;
+  previous[index] = NONE;
+  if (head != NONE)
+    previous[head] = static_cast<Index>(index);
+  heads[cell] = static_cast<Index>(index);
+  cells[index] = static_cast<std::uint16_t>(cell);
+  inserted[index] = true;
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+void SpatialGrid<Capacity, Width, Height, CellSize>::remove(
+    std::size_t index) {
+  assert(index < Capacity && inserted[index]);
+  if (previous[index] != NONE)
+    next[previous[index]] = next[index];
+  else
+    heads[cells[index]] = next[index];
+  if (next[index] != NONE)
+    previous[next[index]] = previous[index];
+  inserted[index] = false;
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+void SpatialGrid<Capacity, Width, Height, CellSize>::move(
+    std::size_t index, const Vector2f &position) {
+  if (cells[index] == cellIndex(cellOf(position)))
+    return;
+  remove(index);
+  insert(index, position);
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+bool SpatialGrid<Capacity, Width, Height, CellSize>::contains(
+    std::size_t index) const {
+  return index < Capacity && inserted[index];
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+std::size_t SpatialGrid<Capacity, Width, Height, CellSize>::within(
+    const Positions &positions, const Vector2f &center, float radius,
+    Index *out, std::size_t maxCount) const {
+  Vector2i low = cellOf(center - Vector2f(radius));
+  Vector2i high = cellOf(center + Vector2f(radius));
+  float squaredRadius = radius * radius;
+  std::size_t count = 0;
+  for (int row = low.y; row <= high.y; ++row) {
+    for (int column = low.x; column <= high.x; ++column) {
+      Index i = heads[cellIndex(Vector2i(column, row))];
+      for (; i != NONE; i = next[i]) {
+        if (Vector2f::squaredDistance(positions[i], center) > squaredRadius)
+          continue;
+        if (count == maxCount)
+          return count;
+        out[count++] = i;
+      }
+    }
+  }
+  return count;
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+std::size_t SpatialGrid<Capacity, Width, Height, CellSize>::nearest(
+    const Positions &positions, const Vector2f &center, std::size_t k,
+    Index *out, float *squaredDistances) const {
+  if (k == 0)
+    return 0;
+  Vector2i origin = cellOf(center);
+  std::size_t count = 0;
+  for (int ring = 0; ring < std::max(COLUMNS, ROWS); ++ring) {
+    Vector2i low(std::max(origin.x - ring, 0), std::max(origin.y - ring, 0));
+    Vector2i high(std::min(origin.x + ring, COLUMNS - 1),
+                  std::min(origin.y + ring, ROWS - 1));
+    for (int row = low.y; row <= high.y; ++row) {
+      bool edge = row == origin.y - ring || row == origin.y + ring;
+      int step = edge ? 1 : std::max(2 * ring, 1);
+      for (int column = origin.x - ring; column <= origin.x + ring;
+           column += step) {
+        if (column < low.x || column > high.x)
+          continue;
+        Index i = heads[cellIndex(Vector2i(column, row))];
+        for (; i != NONE; i = next[i]) {
+          float distance = Vector2f::squaredDistance(positions[i], center);
+          std::size_t slot = count;
+          while (slot > 0 &&
+                 (distance < squaredDistances[slot - 1] ||
+                  (distance == squaredDistances[slot - 1] &&
+                   i < out[slot - 1]))) {
+            if (slot < k) {
+              out[slot] = out[slot - 1];
+              squaredDistances[slot] = squaredDistances[slot - 1];
+            }
+            --slot;
+          }
+          if (slot < k) {
+            out[slot] = i;
+            squaredDistances[slot] = distance;
+            count = std::min(count + 1, k);
+          }
+        }
+      }
+    }
+    float bound = static_cast<float>(ring) * CellSize;
+    if (count == k && squaredDistances[k - 1] < bound * bound)
+      break;
+  }
+  return count;
+}
+}
+
+namespace fuzzyTelegram {
+
+template <std::size_t Capacity> AliveMask<Capacity>::AliveMask(void) {
+  clear();
+}
+
+template <std::size_t Capacity> void AliveMask<Capacity>::clear() {
+  for (std::size_t w = 0; w < WORDS; ++w)
+    words[w] = 0;
+}
+
+template <std::size_t Capacity> void AliveMask<Capacity>::set(std::size_t i) {
+  assert(i < Capacity);
+  words[i / 64] |= std::uint64_t(1) << (i % 64);
+}
+
+template <std::size_t Capacity>
+void AliveMask<Capacity>::reset(std::size_t i) {
+  assert(i < Capacity);
+  words[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+}
+
+template <std::size_t Capacity>
+bool AliveMask<Capacity>::operator[](std::size_t i) const {
+  assert(i < Capacity);
+  return (words[i / 64] >> (i % 64)) & 1;
+}
+
+template <std::size_t Capacity> std::size_t AliveMask<Capacity>::count() const {
+  std::size_t total = 0;
+  for (std::size_t w = 0; w < WORDS; ++w)
+    total += __builtin_popcountll(words[w]);
+  return total;
+}
+
+template <std::size_t Capacity>
+std::size_t AliveMask<Capacity>::next(std::size_t from) const {
+  if (from >= Capacity)
+    return Capacity;
+  std::size_t w = from / 64;
+  std::uint64_t word = words[w] & (~std::uint64_t(0) << (from % 64));
+  while (word == 0) {
+    if (++w == WORDS)
+      return Capacity;
+    word = words[w];
+  }
+  return w * 64 + __builtin_ctzll(word);
+}
+}
+
+namespace fuzzyTelegram {
+
+const int DamageTable::MIN_EXPONENT;
+const int DamageTable::MAX_EXPONENT;
+const int DamageTable::SUBDIVISION_BITS;
+const int DamageTable::BUCKETS;
+const int DamageTable::MAX_DAMAGE;
+
+int shotDamage(float distance) {
+  if (distance <= 1.0f)
+    return 125000;
+  return static_cast<int>(std::round(125000.0 / std::pow(distance, 1.2)));
+}
+
+static const int BUCKET_SHIFT = 23 - DamageTable::SUBDIVISION_BITS;
+
+static const std::uint32_t FIRST_BUCKET_KEY =
+    static_cast<std::uint32_t>(127 + DamageTable::MIN_EXPONENT)
+    << DamageTable::SUBDIVISION_BITS;
+
+static inline std::uint32_t floatBits(float x) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+static inline float bitsFloat(std::uint32_t bits) {
+  float x;
+  std::memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+static inline int referenceDamage(float squaredDistance) {
+  return shotDamage(
+      static_cast<float>(std::sqrt(static_cast<double>(squaredDistance))));
+}
+
+DamageTable::DamageTable() {
+  thresholds[0] = INFINITY;
+  for (int damage = 1; damage <= MAX_DAMAGE + 1; ++damage) {
+    std::uint32_t low = 0;
+    std::uint32_t high = floatBits(INFINITY);
+    while (low + 1 < high) {
+      std::uint32_t middle = low + (high - low) / 2;
+      if (referenceDamage(bitsFloat(middle)) >= damage)
+        low = middle;
+      else
+        high = middle;
+    }
+    thresholds[damage] = bitsFloat(low);
+  }
+  for (int i = 0; i < BUCKETS; ++i) {
+    float largest = bitsFloat(((FIRST_BUCKET_KEY + i + 1) << BUCKET_SHIFT) - 1);
+    int damage = referenceDamage(largest);
+    assert(damage >= 0 && damage < MAX_DAMAGE);
+    buckets[i] = static_cast<std::uint8_t>(damage);
+  }
+}
+
+int DamageTable::damage(float squaredDistance) const {
+  std::uint32_t bucket =
+      (floatBits(squaredDistance) >> BUCKET_SHIFT) - FIRST_BUCKET_KEY;
+  if (bucket >= static_cast<std::uint32_t>(BUCKETS))
+    return referenceDamage(squaredDistance);
+  int damage = buckets[bucket];
+  while (squaredDistance <= thresholds[damage + 1])
+    ++damage;
+  return damage;
+}
+
+float DamageTable::reach(int damage) const { return thresholds[damage]; }
+
+int shotDamageSquared(float squaredDistance) {
+  static const DamageTable table;
+  return table.damage(squaredDistance);
+}
+
+int shotsToKill(int life, float squaredDistance) {
+  if (life <= 0)
+    return 0;
+  int damage = shotDamageSquared(squaredDistance);
+  if (damage == 0)
+    return -1;
+  return (life + damage - 1) / damage;
+}
+}
+
+namespace fuzzyTelegram {
+
+Action::Action(void) : type(MOVE), destination(), enemy(-1) {}
+
+Action Action::move(const Vector2f &destination) {
+  Action action;
+  action.type = MOVE;
+  action.destination = destination;
+  return action;
+}
+
+Action Action::shoot(int enemy) {
+  Action action;
+  action.type = SHOOT;
+  action.enemy = enemy;
+  return action;
+}
+
+bool Action::operator==(const Action &other) const {
+  if (type != other.type)
+    return false;
+  return type == SHOOT ? enemy == other.enemy
+                       : destination == other.destination;
+}
+
+GameState::GameState(void) { clear(); }
+
+void GameState::clear() {
+  wolff = Vector2f::zero();
+  wolffDead = false;
+  turn = 0;
+  dataCount = 0;
+  dataRemaining = 0;
+  dataPositions.clear();
+  dataGrid.clear();
+  dataAlive.clear();
+  enemyCount = 0;
+  enemyPositions.clear();
+  enemyAlive.clear();
+  enemiesRemaining = 0;
+  initialTotalLife = 0;
+  shots = 0;
+  kills = 0;
+}
+
+int GameState::addDataPoint(int id, const Vector2f &position) {
+  int slot = dataCount++;
+  dataPositions.push(position);
+  dataGrid.insert(slot, position);
+  dataIds[slot] = id;
+  dataAlive.set(slot);
+  ++dataRemaining;
+  invalidateTargets();
+  return slot;
+}
+
+int GameState::addEnemy(int id, const Vector2f &position, int life) {
+  int slot = enemyCount++;
+  enemyPositions.push(position);
+  enemyIds[slot] = id;
+  enemyLives[slot] = life;
+  enemyAlive.set(slot);
+  enemyTargets[slot] = -1;
+  enemyTargetTurns[slot] = 0;
+  ++enemiesRemaining;
+  return slot;
+}
+
+void GameState::removeDataPoint(int slot) {
+  dataAlive.reset(slot);
+  dataGrid.remove(slot);
+  dataPositions.set(slot, Vector2f(REMOVED_POSITION));
+  --dataRemaining;
+}
+
+void GameState::removeEnemy(int slot) {
+  enemyAlive.reset(slot);
+  enemyPositions.set(slot, Vector2f(REMOVED_POSITION));
+  --enemiesRemaining;
+}
+
+void GameState::restoreDataPoint(int slot, const Vector2f &position) {
+  dataAlive.set(slot);
+  dataGrid.insert(slot, position);
+  dataPositions.set(slot, position);
+  ++dataRemaining;
+}
+
+void GameState::restoreEnemy(int slot, const Vector2f &position) {
+  enemyAlive.set(slot);
+  enemyPositions.set(slot, position);
+  ++enemiesRemaining;
+}
+
+void GameState::invalidateTargets() {
+  std::fill(enemyTargets, enemyTargets + enemyCount, -1);
+}
+
+int GameState::findEnemy(int id) const {
+  for (int i = 0; i < enemyCount; ++i)
+    if (enemyAlive[i] && enemyIds[i] == id)
+      return i;
+  return -1;
+}
+
+bool GameState::isOver() const {
+  return wolffDead || dataRemaining == 0 || enemiesRemaining == 0;
+}
+
+static inline std::uint64_t exactSquaredDistance(const Vector2f &a,
+                                                 const Vector2f &b) {
+  std::int64_t dx = static_cast<std::int64_t>(a.x - b.x);
+  std::int64_t dy = static_cast<std::int64_t>(a.y - b.y);
+  return static_cast<std::uint64_t>(dx * dx + dy * dy);
+}
+
+template <typename Index>
+static int closestExactly(const GameState &state, const Vector2f &position,
+                          const Index *candidates, std::size_t count) {
+  int best = -1;
+  std::uint64_t bestDistance = 0;
+  for (std::size_t c = 0; c < count; ++c) {
+    int j = static_cast<int>(candidates[c]);
+    std::uint64_t distance =
+        exactSquaredDistance(state.dataPositions[j], position);
+    if (best == -1 || distance < bestDistance ||
+        (distance == bestDistance && j < best)) {
+      best = j;
+      bestDistance = distance;
+    }
+  }
+  return best;
+}
+
+int nearestDataPoint(const GameState &state, const Vector2f &position) {
+  if (state.dataRemaining == 0)
+    return -1;
+  const float tolerance = 1 + 1.0f / (1 << 20);
+  if (state.dataRemaining < DATA_GRID_THRESHOLD) {
+    float distances[MAX_DATA_POINTS];
+    int candidates[MAX_DATA_POINTS];
+    std::size_t count = 0;
+    state.dataPositions.squaredDistances(position, distances);
+    float closest = *std::min_element(distances, distances + state.dataCount);
+    for (int j = 0; j < state.dataCount; ++j)
+      if (state.dataAlive[j] && distances[j] <= closest * tolerance)
+        candidates[count++] = j;
+    return closestExactly(state, position, candidates, count);
+  }
+  DataGrid::Index slots[MAX_DATA_POINTS];
+  float squaredDistance;
+  if (state.dataGrid.nearest(state.dataPositions, position, 1, slots,
+                             &squaredDistance) == 0)
+    return -1;
+  std::size_t count = state.dataGrid.within(state.dataPositions, position,
+      std::sqrt(squaredDistance) * tolerance + 1, slots, MAX_DATA_POINTS);
+  return closestExactly(state, position, slots, count);
+}
+
+static int targetTurn(const GameState &state, const Vector2f &position,
+                      int target) {
+  std::uint64_t second = std::numeric_limits<std::uint64_t>::max();
+  for (std::size_t j = state.dataAlive.next(0);
+       j < static_cast<std::size_t>(state.dataCount);
+       j = state.dataAlive.next(j + 1))
+    if (static_cast<int>(j) != target)
+      second = std::min(
+          second, exactSquaredDistance(state.dataPositions[j], position));
+  if (second == std::numeric_limits<std::uint64_t>::max())
+    return std::numeric_limits<int>::max();
+  std::int64_t margin =
+      static_cast<std::int64_t>(integerSqrt(second)) -
+      static_cast<std::int64_t>(integerSqrt(exactSquaredDistance(
+          state.dataPositions[target], position))) -
+      1;
+  return state.turn + static_cast<int>(std::max<std::int64_t>(
+                          0, (margin - 1) / TARGET_SLACK));
+}
+
+template <typename Recorder>
+int updateTargets(GameState &state, Recorder &recorder) {
+  int updated = 0;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    int target = state.enemyTargets[i];
+    if (!state.enemyAlive[i] ||
+        (target != -1 && state.dataAlive[target] &&
+         state.turn <= state.enemyTargetTurns[i]))
+      continue;
+    recorder.targetChanged(i, target, state.enemyTargetTurns[i]);
+    Vector2f position = state.enemyPositions[i];
+    target = nearestDataPoint(state, position);
+    state.enemyTargets[i] = target;
+    if (target != -1)
+      state.enemyTargetTurns[i] = targetTurn(state, position, target);
+    ++updated;
+  }
+  return updated;
+}
+
+int updateTargets(GameState &state) {
+  NoRecorder recorder;
+  return updateTargets(state, recorder);
+}
+
+bool verifyTargets(const GameState &state) {
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    int target = state.enemyTargets[i];
+    if (target == -1) {
+      if (state.dataRemaining > 0)
+        return false;
+      continue;
+    }
+    if (!state.dataAlive[target])
+      return false;
+    Vector2f position = state.enemyPositions[i];
+    std::uint64_t cached =
+        exactSquaredDistance(state.dataPositions[target], position);
+    for (int j = 0; j < state.dataCount; ++j) {
+      if (!state.dataAlive[j])
+        continue;
+      std::uint64_t squaredDistance =
+          exactSquaredDistance(state.dataPositions[j], position);
+      if (squaredDistance < cached || (squaredDistance == cached && j < target))
+        return false;
+    }
+  }
+  return true;
+}
+
+Vector2f clampToMap(const Vector2f &position) {
+  return Vector2f(std::min(std::max(position.x, 0.0f), MAP_WIDTH - 1),
+                  std::min(std::max(position.y, 0.0f), MAP_HEIGHT - 1));
+}
+
+Action playableAction(const GameState &state, const Action &action) {
+  if (action.type == Action::SHOOT &&
+      (action.enemy < 0 || action.enemy >= state.enemyCount ||
+       !state.enemyAlive[action.enemy]))
+    return Action::move(state.wolff);
+  return action;
+}
+
+bool moveTowards(Vector2f &position, const Vector2f &destination,
+                 float step) {
+  Vector2i moved(position);
+  bool arrived = stepTowards(moved, Vector2i(destination),
+                             static_cast<int>(step));
+  position = Vector2f(moved);
+  return arrived;
+}
+
+template <typename Recorder>
+void simulate(GameState &state, const Action &action, Recorder &recorder) {
+  bool arrived[MAX_ENEMIES];
+  recorder.beginTurn(state);
+
+  updateTargets(state, recorder);
+#ifdef FUZZY_DEBUG
+  assert(verifyTargets(state));
+#endif
+  const int *targets = state.enemyTargets;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    Vector2f position = state.enemyPositions[i];
+    recorder.enemyMoved(i, position);
+    arrived[i] = targets[i] != -1 &&
+                 moveTowards(position, state.dataPositions[targets[i]],
+                             ENEMY_STEP);
+    state.enemyPositions.set(i, position);
+  }
+
+  if (action.type == Action::MOVE)
+    moveTowards(state.wolff, clampToMap(action.destination), WOLFF_STEP);
+
+  if (state.enemyPositions.anyWithin(state.wolff, KILL_RANGE)) {
+    state.wolffDead = true;
+    ++state.turn;
+    return;
+  }
+
+  if (action.type == Action::SHOOT && action.enemy >= 0 &&
+      action.enemy < state.enemyCount && state.enemyAlive[action.enemy]) {
+    int target = action.enemy;
+    ++state.shots;
+    recorder.enemyHit(target, state.enemyLives[target]);
+    state.enemyLives[target] -= shotDamageSquared(
+        Vector2f::squaredDistance(state.enemyPositions[target], state.wolff));
+    if (state.enemyLives[target] <= 0) {
+      recorder.enemyRemoved(target, state.enemyPositions[target]);
+      state.removeEnemy(target);
+      ++state.kills;
+    }
+  }
+
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    if (arrived[i] && state.dataAlive[targets[i]]) {
+      recorder.dataRemoved(targets[i], state.dataPositions[targets[i]]);
+      state.removeDataPoint(targets[i]);
+    }
+  }
+
+  ++state.turn;
+}
+
+void simulate(GameState &state, const Action &action) {
+  NoRecorder recorder;
+  simulate(state, action, recorder);
+}
+
+static int scoreWithShots(const GameState &state, int shots) {
+  if (state.wolffDead)
+    return 0;
+  int bonus =
+      state.dataRemaining * std::max(0, state.initialTotalLife - 3 * shots) * 3;
+  return state.dataRemaining * 100 + state.kills * 10 + bonus;
+}
+
+int score(const GameState &state) { return scoreWithShots(state, state.shots); }
+
+float evaluate(const GameState &state) { return evaluate(state, state.shots); }
+
+float evaluate(const GameState &state, int shots) {
+  if (state.wolffDead)
+    return 0;
+  int life = 0;
+  for (int i = 0; i < state.enemyCount; ++i)
+    if (state.enemyAlive[i])
+      life += state.enemyLives[i];
+  return scoreWithShots(state, shots) +
+         0.1f * std::max(0, state.initialTotalLife - life);
+}
+}
+
+namespace fuzzyTelegram {
+
+const int DivergenceTracker::MAX_PRINTED_ENEMIES;
+
+Divergence::Divergence(void)
+    : wolffError(0), enemies(0), enemiesMoved(0), maxEnemyError(0),
+      livesChanged(0), enemiesMissed(0), dataMissed(0) {}
+
+bool Divergence::exact() const {
+  return wolffError == 0 && enemiesMoved == 0 && livesChanged == 0 &&
+         enemiesMissed == 0 && dataMissed == 0;
+}
+
+DivergenceTracker::DivergenceTracker(void)
+    : pending(false), printed(0), compared(0), exactCount(0), wolffErrors(0),
+      enemiesMoved(0), livesChanged(0), entitiesMissed(0), maxEnemyError(0) {}
+
+void DivergenceTracker::predict(const GameState &root, const Action &action) {
+  predicted = root;
+  simulate(predicted, action);
+  pending = true;
+}
+
+bool DivergenceTracker::hasPrediction() const { return pending; }
+
+const Divergence &DivergenceTracker::compare(const GameState &observed) {
+  pending = false;
+  last = Divergence();
+  printed = 0;
+  last.wolffError = Vector2f::distance(predicted.wolff, observed.wolff);
+
+  int p = 0;
+  int o = 0;
+  while (true) {
+    while (p < predicted.enemyCount && !predicted.enemyAlive[p])
+      ++p;
+    while (o < observed.enemyCount && !observed.enemyAlive[o])
+      ++o;
+    if (p == predicted.enemyCount || o == observed.enemyCount) {
+      for (; p < predicted.enemyCount; ++p)
+        last.enemiesMissed += predicted.enemyAlive[p];
+      for (; o < observed.enemyCount; ++o)
+        last.enemiesMissed += observed.enemyAlive[o];
+      break;
+    }
+    if (predicted.enemyIds[p] != observed.enemyIds[o]) {
+      ++last.enemiesMissed;
+      ++(predicted.enemyIds[p] < observed.enemyIds[o] ? p : o);
+      continue;
+    }
+    ++last.enemies;
+    float error = Vector2f::distance(predicted.enemyPositions[p],
+                                     observed.enemyPositions[o]);
+    bool lifeChanged = predicted.enemyLives[p] != observed.enemyLives[o];
+    last.enemiesMoved += error != 0;
+    last.livesChanged += lifeChanged;
+    last.maxEnemyError = std::max(last.maxEnemyError, error);
+    if ((error != 0 || lifeChanged) && printed < MAX_PRINTED_ENEMIES) {
+      printedIds[printed] = observed.enemyIds[o];
+      printedPredicted[printed] = predicted.enemyPositions[p];
+      printedObserved[printed] = observed.enemyPositions[o];
+      printedLives[printed][0] = predicted.enemyLives[p];
+      printedLives[printed][1] = observed.enemyLives[o];
+      ++printed;
+    }
+    ++p;
+    ++o;
+  }
+
+  p = 0;
+  o = 0;
+  while (true) {
+    while (p < predicted.dataCount && !predicted.dataAlive[p])
+      ++p;
+    while (o < observed.dataCount && !observed.dataAlive[o])
+      ++o;
+    if (p == predicted.dataCount || o == observed.dataCount) {
+      for (; p < predicted.dataCount; ++p)
+        last.dataMissed += predicted.dataAlive[p];
+      for (; o < observed.dataCount; ++o)
+        last.dataMissed += observed.dataAlive[o];
+      break;
+    }
+    if (predicted.dataIds[p] != observed.dataIds[o]) {
+      ++last.dataMissed;
+      ++(predicted.dataIds[p] < observed.dataIds[o] ? p : o);
+      continue;
+    }
+    ++p;
+    ++o;
+  }
+
+  ++compared;
+  exactCount += last.exact();
+  wolffErrors += last.wolffError != 0;
+  enemiesMoved += last.enemiesMoved;
+  livesChanged += last.livesChanged;
+  entitiesMissed += last.enemiesMissed + last.dataMissed;
+  maxEnemyError = std::max(maxEnemyError, last.maxEnemyError);
+  return last;
+}
+
+const GameState &DivergenceTracker::prediction() const { return predicted; }
+
+void DivergenceTracker::printTurn(std::ostream &output) const {
+  if (last.exact()) {
+    output << "prediction exact, " << last.enemies << " enemies" << std::endl;
+    return;
+  }
+  output << "prediction off : wolff " << last.wolffError << " enemies moved "
+         << last.enemiesMoved << '/' << last.enemies << " (max "
+         << last.maxEnemyError << ") lives " << last.livesChanged
+         << " missed enemies " << last.enemiesMissed << " data "
+         << last.dataMissed << std::endl;
+  for (int i = 0; i < printed; ++i)
+    output << "  enemy " << printedIds[i] << " predicted "
+           << printedPredicted[i] << " life " << printedLives[i][0]
+           << " parsed " << printedObserved[i] << " life "
+           << printedLives[i][1] << std::endl;
+}
+
+void DivergenceTracker::printTotals(std::ostream &output) const {
+  output << "predictions exact " << exactCount << '/' << compared
+         << " wolff off " << wolffErrors << " enemies moved " << enemiesMoved
+         << " (max " << maxEnemyError << ") lives " << livesChanged
+         << " missed " << entitiesMissed << std::endl;
+}
+
+int DivergenceTracker::turns() const { return compared; }
+
+int DivergenceTracker::exactTurns() const { return exactCount; }
+}
+
+namespace fuzzyTelegram {
+
+const int ThreatMap::CELL_SIZE;
+const int ThreatMap::COLUMNS;
+const int ThreatMap::ROWS;
+const int ThreatMap::CELLS;
+const int ThreatMap::NEVER;
+
+ThreatMap::ThreatMap(void) : enemies(0) {
+  for (int row = 0; row < ROWS; ++row)
+    for (int column = 0; column < COLUMNS; ++column)
+      centers.push(Vector2f((column + 0.5f) * CELL_SIZE,
+                            (row + 0.5f) * CELL_SIZE));
+  std::fill(closest, closest + CELLS, std::numeric_limits<float>::max());
+  std::fill(turns, turns + CELLS, static_cast<std::uint8_t>(NEVER));
+}
+
+void ThreatMap::build(const GameState &state) {
+  std::fill(closest, closest + CELLS, std::numeric_limits<float>::max());
+  origins.clear();
+  enemies = state.enemiesRemaining;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    origins.push(state.enemyPositions[i]);
+    if (!state.enemyAlive[i])
+      continue;
+    centers.squaredDistances(state.enemyPositions[i], scratch);
+    for (int c = 0; c < CELLS; ++c)
+      closest[c] = std::min(closest[c], scratch[c]);
+  }
+  for (int c = 0; c < CELLS; ++c)
+    turns[c] = turnOf(closest[c]);
+}
+
+int ThreatMap::enemyRemoved(int slot) {
+  const Vector2f position = origins[slot];
+  if (position == Vector2f(REMOVED_POSITION))
+    return 0;
+  origins.set(slot, Vector2f(REMOVED_POSITION));
+  --enemies;
+  centers.squaredDistances(position, scratch);
+  int updated = 0;
+  for (int c = 0; c < CELLS; ++c) {
+    if (scratch[c] > closest[c] * (1 + 1e-6f))
+      continue;
+    float squaredDistance = std::numeric_limits<float>::max();
+    if (enemies > 0)
+      origins.nearest(centers[c], &squaredDistance);
+    closest[c] = squaredDistance;
+    turns[c] = turnOf(squaredDistance);
+    ++updated;
+  }
+  return updated;
+}
+
+int ThreatMap::earliestTurn(const Vector2f &position) const {
+  return turns[cellIndex(position)];
+}
+
+bool ThreatMap::isSafe(const Vector2f &position, int turnCount) const {
+  return turns[cellIndex(position)] > turnCount;
+}
+
+int ThreatMap::cellTurn(int column, int row) const {
+  return turns[row * COLUMNS + column];
+}
+
+int ThreatMap::cellIndex(const Vector2f &position) {
+  int column = std::min(std::max(static_cast<int>(position.x) / CELL_SIZE, 0),
+                        COLUMNS - 1);
+  int row = std::min(std::max(static_cast<int>(position.y) / CELL_SIZE, 0),
+                     ROWS - 1);
+  return row * COLUMNS + column;
+}
+
+std::uint8_t ThreatMap::turnOf(float squaredDistance) {
+  const float halfDiagonal = CELL_SIZE * 0.70710678f;
+  float distance = std::sqrt(squaredDistance) - halfDiagonal - KILL_RANGE;
+  if (distance <= ENEMY_STEP)
+    return 1;
+  float turn = std::min(distance / ENEMY_STEP, static_cast<float>(NEVER));
+  int whole = static_cast<int>(turn);
+  return static_cast<std::uint8_t>(whole + (whole < turn));
+}
+}
+
+namespace fuzzyTelegram {
+
+InputReader::InputReader(int fdValue)
+    : fd(fdValue), position(0), end(0), ended(false) {}
+
+bool InputReader::refill() {
+  if (ended)
+    return false;
+  ssize_t count;
+  do {
+    count = read(fd, buffer, BUFFER_SIZE);
+  } while (count < 0 && errno == EINTR);
+  if (count <= 0) {
+    ended = true;
+    return false;
+  }
+  position = 0;
+  end = static_cast<std::size_t>(count);
+  return true;
+}
+
+bool InputReader::waitInput() {
+  for (;;) {
+    if (position == end && !refill())
+      return false;
+    char c = buffer[position];
+    if (c == '-' || (c >= '0' && c <= '9'))
+      return true;
+    ++position;
+  }
+}
+
+bool InputReader::readInt(int &value) {
+  if (!waitInput())
+    return false;
+  bool negative = buffer[position] == '-';
+  if (negative)
+    ++position;
+  int result = 0;
+  for (;;) {
+    if (position == end && !refill())
+      break;
+    unsigned digit = static_cast<unsigned>(buffer[position] - '0');
+    if (digit > 9)
+      break;
+    result = result * 10 + static_cast<int>(digit);
+    ++position;
+  }
+  value = negative ? -result : result;
+  return true;
+}
+
+template <typename T> bool InputReader::readVector2(Vector2<T> &v) {
+  int x;
+  int y;
+  if (!readInt(x) || !readInt(y))
+    return false;
+  v.set(x, y);
+  return true;
+}
+
+bool InputReader::readTurn(GameState &state) {
+  int initialTotalLife = state.initialTotalLife;
+  int shots = state.shots;
+  int kills = state.kills;
+  state.clear();
+  state.initialTotalLife = initialTotalLife;
+  state.shots = shots;
+  state.kills = kills;
+
+  if (!readVector2(state.wolff))
+    return false;
+  int dataCount;
+  if (!readInt(dataCount) || dataCount < 0 || dataCount > MAX_DATA_POINTS)
+    return false;
+  for (int i = 0; i < dataCount; i++) {
+    int id;
+    Vector2f position;
+    if (!readInt(id) || !readVector2(position))
+      return false;
+    state.addDataPoint(id, position);
+  }
+  int enemyCount;
+  if (!readInt(enemyCount) || enemyCount < 0 || enemyCount > MAX_ENEMIES)
+    return false;
+  for (int i = 0; i < enemyCount; i++) {
+    int id;
+    Vector2f position;
+    int life;
+    if (!readInt(id) || !readVector2(position) || !readInt(life))
+      return false;
+    state.addEnemy(id, position, life);
+  }
+  return true;
+}
+
+bool InputReader::eof() const { return ended; }
+}
+#if defined(__x86_64__) || defined(__i386__)
+#define FUZZY_HAS_RDTSC
+#endif
+
+namespace fuzzyTelegram {
+
+constexpr double TurnClock::FIRST_TURN_BUDGET_MS;
+constexpr double TurnClock::TURN_BUDGET_MS;
+
+TurnClock::TurnClock(double firstTurnBudgetMs, double turnBudgetMs)
+    : firstTurnBudget(firstTurnBudgetMs), turnBudget(turnBudgetMs),
+      ticks(ticksPerMs()), turns(0), start(0), deadline(0) {}
+
+void TurnClock::startTurn() {
+  start = now();
+  ++turns;
+  deadline = start + static_cast<std::uint64_t>(budgetMs() * ticks);
+}
+
+int TurnClock::turn() const { return turns; }
+
+double TurnClock::budgetMs() const {
+  return turns <= 1 ? firstTurnBudget : turnBudget;
+}
+
+double TurnClock::elapsedMs() const {
+  return static_cast<double>(now() - start) / ticks;
+}
+
+double TurnClock::remainingMs() const { return budgetMs() - elapsedMs(); }
+
+bool TurnClock::expired(double marginMs) const {
+  return now() + static_cast<std::uint64_t>(marginMs * ticks) >=
+         deadline;
+}
+
+std::uint64_t TurnClock::now() {
+#ifdef FUZZY_HAS_RDTSC
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+static double calibrate() {
+#ifdef FUZZY_HAS_RDTSC
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point from = Clock::now();
+  const std::uint64_t ticks = __rdtsc();
+  Clock::time_point to;
+  do {
+    to = Clock::now();
+  } while (to - from < std::chrono::milliseconds(2));
+  const double ms =
+      std::chrono::duration<double, std::milli>(to - from).count();
+  return static_cast<double>(__rdtsc() - ticks) / ms;
+#else
+  return 1e6;
+#endif
+}
+
+double TurnClock::ticksPerMs() {
+  static const double ticks = calibrate();
+  return ticks;
+}
+}
+
+namespace fuzzyTelegram {
+
+AnytimeConfig::AnytimeConfig(unsigned checkIntervalValue,
+                             double safetyMarginMsValue)
+    : checkInterval(checkIntervalValue), safetyMarginMs(safetyMarginMsValue) {}
+
+template <typename Search>
+static auto isDone(const Search &search, int) -> decltype(search.isDone()) {
+  return search.isDone();
+}
+
+template <typename Search> static bool isDone(const Search &, long) {
+  return false;
+}
+
+template <typename Search>
+unsigned long runAnytime(Search &search, const TurnClock &clock,
+                         const AnytimeConfig &config) {
+  unsigned long iterations = 0;
+  while (!clock.expired(config.safetyMarginMs) && !isDone(search, 0)) {
+    for (unsigned i = 0; i < config.checkInterval; ++i)
+      search.iterate();
+    iterations += config.checkInterval;
+  }
+  return iterations;
+}
+}
+
+namespace fuzzyTelegram {
+
+std::uint64_t splitMix64(std::uint64_t &state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+FastRandom::FastRandom(std::uint64_t value) { seed(value); }
+
+void FastRandom::seed(std::uint64_t value) {
+  std::uint64_t state = value;
+  std::uint64_t a = splitMix64(state);
+  std::uint64_t b = splitMix64(state);
+  s[0] = static_cast<std::uint32_t>(a);
+  s[1] = static_cast<std::uint32_t>(a >> 32);
+  s[2] = static_cast<std::uint32_t>(b);
+  s[3] = static_cast<std::uint32_t>(b >> 32);
+}
+
+std::uint32_t FastRandom::operator()() {
+  const std::uint32_t result = rotateLeft(s[1] * 5, 7) * 9;
+  const std::uint32_t t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotateLeft(s[3], 11);
+  return result;
+}
+
+std::uint32_t FastRandom::below(std::uint32_t bound) {
+  return static_cast<std::uint32_t>(
+      (static_cast<std::uint64_t>((*this)()) * bound) >> 32);
+}
+
+int FastRandom::range(int low, int high) {
+  return low + static_cast<int>(
+                   below(static_cast<std::uint32_t>(high - low) + 1));
+}
+
+float FastRandom::unit() { return unitFloat((*this)()); }
+
+bool FastRandom::coin() { return (*this)() >> 31; }
+
+Vector2f FastRandom::direction() {
+  float angle = unit() * 2 * static_cast<float>(M_PI);
+  return Vector2f(std::cos(angle), std::sin(angle));
+}
+
+Vector2f FastRandom::inDisc(float radius) {
+  float length = std::sqrt(unit()) * radius;
+  return direction() * length;
+}
+}
+
+namespace fuzzyTelegram {
+
+RolloutPlanner::RolloutPlanner(unsigned seed)
+    : bestSequenceValue(0), bestLength(0), hasBest(false), rolloutCount(0),
+      random(seed) {}
+
+void RolloutPlanner::reset(const GameState &newRoot, const Action &played) {
+  hasBest = hasBest && best[0] == played;
+  if (hasBest) {
+    for (int i = 0; i + 1 < bestLength; ++i) {
+      best[i] = best[i + 1];
+      if (best[i].type == Action::SHOOT && best[i].enemy >= 0)
+        best[i].enemy = newRoot.findEnemy(root.enemyIds[best[i].enemy]);
+    }
+  }
+  root = newRoot;
+  updateTargets(root);
+  threats.build(root);
+  rolloutCount = 0;
+  bestSequenceValue = rollout(best, hasBest ? bestLength - 1 : 0, bestLength);
+  hasBest = true;
+}
+
+void RolloutPlanner::reset(const GameState &newRoot) {
+  reset(newRoot, bestAction());
+}
+
+void RolloutPlanner::iterate() {
+  int keep = static_cast<int>(random.below(2 * DEPTH));
+  keep = keep < DEPTH ? 0 : std::min(keep - DEPTH, bestLength);
+  for (int i = 0; i < keep; ++i)
+    candidate[i] = best[i];
+  int length;
+  float value = rollout(candidate, keep, length);
+  if (value > bestSequenceValue) {
+    bestSequenceValue = value;
+    bestLength = length;
+    for (int i = 0; i < length; ++i)
+      best[i] = candidate[i];
+  }
+}
+
+Action RolloutPlanner::bestAction() const { return best[0]; }
+
+float RolloutPlanner::bestValue() const { return bestSequenceValue; }
+
+int RolloutPlanner::bestSequenceLength() const { return bestLength; }
+
+unsigned long RolloutPlanner::rollouts() const { return rolloutCount; }
+
+int RolloutPlanner::rootStatistics(ActionStatistics *out,
+                                   int capacity) const {
+  if (capacity < 1)
+    return 0;
+  out[0].action = best[0];
+  out[0].valueSum = bestSequenceValue;
+  out[0].visits = 1;
+  return 1;
+}
+
+Action RolloutPlanner::randomAction(const GameState &state, int turn) {
+  if (state.enemiesRemaining > 0 && random.coin()) {
+    int enemy;
+    do {
+      enemy = static_cast<int>(random.below(state.enemyCount));
+    } while (!state.enemyAlive[enemy]);
+    return Action::shoot(enemy);
+  }
+  Vector2f destination = state.wolff + random.inDisc(WOLFF_STEP);
+  for (int i = 1;
+       turn == 0 && i < MOVE_TRIES && !threats.isSafe(destination, 1); ++i)
+    destination = state.wolff + random.inDisc(WOLFF_STEP);
+  return Action::move(destination);
+}
+
+float RolloutPlanner::rollout(Action *sequence, int keep, int &length) {
+  ++rolloutCount;
+  scratch = root;
+  int i = 0;
+  for (; i < DEPTH && !scratch.isOver(); ++i) {
+    if (i >= keep || (sequence[i].type == Action::SHOOT &&
+                      (sequence[i].enemy < 0 ||
+                       !scratch.enemyAlive[sequence[i].enemy])))
+      sequence[i] = randomAction(scratch, i);
+    simulate(scratch, sequence[i]);
+  }
+  length = i;
+  return evaluate(scratch);
+}
+}
+
+namespace fuzzyTelegram {
+
+static inline int scaleBits(std::uint32_t bits, std::uint32_t bound) {
+  return static_cast<int>((static_cast<std::uint64_t>(bits) * bound) >> 32);
+}
+
+Gene Gene::fromBits(const std::uint32_t *bits, int enemies) {
+  Gene gene;
+  gene.kind = static_cast<std::uint8_t>(bits[0] >> 31);
+  gene.enemy = static_cast<std::uint8_t>(
+      scaleBits(bits[1], static_cast<std::uint32_t>(std::max(enemies, 1))));
+  gene.angle = static_cast<std::uint16_t>(bits[2] >> 16);
+  gene.distance = static_cast<std::uint16_t>(
+      scaleBits(bits[3], static_cast<std::uint32_t>(WOLFF_STEP) + 1));
+  return gene;
+}
+
+Action Gene::decode(const GameState &state) const {
+  if (kind == SHOOT && state.enemiesRemaining > 0) {
+    if (enemy < state.enemyCount && state.enemyAlive[enemy])
+      return Action::shoot(enemy);
+    return Action::shoot(
+        static_cast<int>(state.enemyPositions.nearest(state.wolff)));
+  }
+  float radians = angle * (2 * static_cast<float>(M_PI) / 65536);
+  return Action::move(state.wolff +
+                      Vector2f(std::cos(radians), std::sin(radians)) *
+                          static_cast<float>(distance));
+}
+
+EvolutionPlanner::EvolutionPlanner(unsigned seed)
+    : best(0), worst(0), initialized(false), rolloutCount(0), random(seed) {}
+
+void EvolutionPlanner::reset(const GameState &newRoot, const Action &played) {
+  int first[POPULATION];
+  for (int i = 0; i < POPULATION; ++i) {
+    Gene *genes = population[i].genes;
+    first[i] = initialized && genes[0].decode(root) == played ? HORIZON - 1 : 0;
+    if (first[i] == 0)
+      continue;
+    for (int j = 0; j + 1 < HORIZON; ++j) {
+      genes[j] = genes[j + 1];
+      if (genes[j].kind != Gene::SHOOT)
+        continue;
+      int slot = genes[j].enemy < root.enemyCount
+                     ? newRoot.findEnemy(root.enemyIds[genes[j].enemy])
+                     : -1;
+      genes[j].enemy = slot < 0 ? MAX_ENEMIES : slot;
+    }
+  }
+  root = newRoot;
+  updateTargets(root);
+  rolloutCount = 0;
+  for (int i = 0; i < POPULATION; ++i) {
+    for (int j = first[i]; j < HORIZON; ++j)
+      population[i].genes[j] = randomGene();
+    evaluate(population[i]);
+  }
+  initialized = true;
+  rank();
+}
+
+void EvolutionPlanner::reset(const GameState &newRoot) {
+  reset(newRoot, bestAction());
+}
+
+void EvolutionPlanner::iterate() {
+  const Genome &mother = population[tournament()];
+  const Genome &father = population[tournament()];
+  std::uint32_t parents = random();
+  for (int i = 0; i < HORIZON; ++i)
+    child.genes[i] = (parents >> i) & 1 ? mother.genes[i] : father.genes[i];
+
+  Gene &gene = child.genes[random.below(HORIZON)];
+  if (gene.kind == Gene::MOVE && random.coin()) {
+    gene.angle =
+        static_cast<std::uint16_t>(gene.angle + random.range(-4096, 4096));
+    int distance = gene.distance + random.range(-4096, 4096) / 16;
+    gene.distance = static_cast<std::uint16_t>(
+        std::min(std::max(distance, 0), static_cast<int>(WOLFF_STEP)));
+  } else {
+    gene = randomGene();
+  }
+
+  evaluate(child);
+  if (child.value > population[worst].value) {
+    population[worst] = child;
+    rank();
+  }
+}
+
+Action EvolutionPlanner::bestAction() const {
+  return population[best].genes[0].decode(root);
+}
+
+float EvolutionPlanner::bestValue() const { return population[best].value; }
+
+unsigned long EvolutionPlanner::rollouts() const { return rolloutCount; }
+
+int EvolutionPlanner::rootStatistics(ActionStatistics *out,
+                                     int capacity) const {
+  int count = 0;
+  for (int i = 0; i < POPULATION; ++i) {
+    Action action = population[i].genes[0].decode(root);
+    int j = 0;
+    while (j < count && !(out[j].action == action))
+      ++j;
+    if (j == count) {
+      if (count == capacity)
+        continue;
+      out[count].action = action;
+      out[count].valueSum = 0;
+      out[count].visits = 0;
+      ++count;
+    }
+    out[j].valueSum += population[i].value;
+    ++out[j].visits;
+  }
+  return count;
+}
+
+Gene EvolutionPlanner::randomGene() {
+  std::uint32_t bits[4] = {random(), random(), random(), random()};
+  return Gene::fromBits(bits, root.enemyCount);
+}
+
+int EvolutionPlanner::tournament() {
+  int winner = static_cast<int>(random.below(POPULATION));
+  for (int i = 1; i < TOURNAMENT; ++i) {
+    int challenger = static_cast<int>(random.below(POPULATION));
+    if (population[challenger].value > population[winner].value)
+      winner = challenger;
+  }
+  return winner;
+}
+
+void EvolutionPlanner::evaluate(Genome &genome) {
+  ++rolloutCount;
+  scratch = root;
+  for (int i = 0; i < HORIZON && !scratch.isOver(); ++i)
+    simulate(scratch, genome.genes[i].decode(scratch));
+  genome.value = fuzzyTelegram::evaluate(scratch);
+}
+
+void EvolutionPlanner::rank() {
+  best = 0;
+  worst = 0;
+  for (int i = 1; i < POPULATION; ++i) {
+    if (population[i].value > population[best].value)
+      best = i;
+    if (population[i].value < population[worst].value)
+      worst = i;
+  }
+}
+}
+
+namespace fuzzyTelegram {
+
+Arena::Arena(void) : buffer(nullptr), size(0), offset(0), highWater(0) {}
+
+Arena::~Arena() { delete[] buffer; }
+
+void Arena::reserve(std::size_t bytes) {
+  delete[] buffer;
+  buffer = new unsigned char[bytes];
+  std::memset(buffer, 0, bytes);
+  size = bytes;
+  offset = 0;
+  highWater = 0;
+}
+
+void *Arena::allocate(std::size_t bytes, std::size_t alignment) {
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer + offset);
+  std::size_t padding = (alignment - address % alignment) % alignment;
+  if (bytes + padding > size - offset)
+    return nullptr;
+  void *memory = buffer + offset + padding;
+  offset += padding + bytes;
+  highWater = std::max(highWater, offset);
+  return memory;
+}
+
+std::size_t Arena::mark() const { return offset; }
+
+void Arena::release(std::size_t mark) {
+  assert(mark <= offset);
+  offset = mark;
+}
+
+void Arena::reset() { offset = 0; }
+
+std::size_t Arena::capacity() const { return size; }
+
+std::size_t Arena::used() const { return offset; }
+
+std::size_t Arena::peak() const { return highWater; }
+
+template <typename Node>
+const typename NodePool<Node>::Index NodePool<Node>::NONE;
+
+template <typename Node>
+NodePool<Node>::NodePool(Arena &arena)
+    : arena(arena), nodes(nullptr), count(0) {
+  static_assert(std::is_trivially_copyable<Node>::value,
+                "nodes are moved with memcpy");
+}
+
+template <typename Node>
+typename NodePool<Node>::Index NodePool<Node>::size() const {
+  return count;
+}
+
+template <typename Node> void NodePool<Node>::clear() {
+  arena.reset();
+  nodes = nullptr;
+  count = 0;
+}
+
+template <typename Node>
+typename NodePool<Node>::Index NodePool<Node>::create() {
+  Node *node =
+      static_cast<Node *>(arena.allocate(sizeof(Node), alignof(Node)));
+  if (node == nullptr)
+    return NONE;
+  if (count == 0)
+    nodes = node;
+  assert(node == nodes + count);
+  node->firstChild = NONE;
+  node->nextSibling = NONE;
+  return count++;
+}
+
+template <typename Node> Node &NodePool<Node>::operator[](Index i) {
+  assert(i >= 0 && i < count);
+  return nodes[i];
+}
+
+template <typename Node>
+const Node &NodePool<Node>::operator[](Index i) const {
+  assert(i >= 0 && i < count);
+  return nodes[i];
+}
+
+template <typename Node>
+typename NodePool<Node>::Index NodePool<Node>::keepSubtree(Index root) {
+  if (root == NONE || count == 0) {
+    clear();
+    return 0;
+  }
+  std::size_t start = arena.mark();
+  Node *copies = nodes + count;
+  Index kept = 0;
+  auto copy = [&](Index from) -> Index {
+    Node *node =
+        static_cast<Node *>(arena.allocate(sizeof(Node), alignof(Node)));
+    if (node == nullptr)
+      return NONE;
+    assert(node == copies + kept);
+    std::memcpy(static_cast<void *>(node), &nodes[from], sizeof(Node));
+    return kept++;
+  };
+  if (copy(root) == NONE) {
+    clear();
+    return 0;
+  }
+  for (Index head = 0; head < kept; ++head) {
+    Index previous = NONE;
+    for (Index child = copies[head].firstChild; child != NONE;
+         child = nodes[child].nextSibling) {
+      Index moved = copy(child);
+      if (moved == NONE) {
+        clear();
+        return 0;
+      }
+      if (previous == NONE)
+        copies[head].firstChild = moved;
+      else
+        copies[previous].nextSibling = moved;
+      previous = moved;
+    }
+    if (previous != NONE)
+      copies[previous].nextSibling = NONE;
+  }
+  copies[0].nextSibling = NONE;
+  std::memmove(static_cast<void *>(nodes), copies, kept * sizeof(Node));
+  arena.release(start - (count - kept) * sizeof(Node));
+  count = kept;
+  return kept;
+}
+}
+
+namespace fuzzyTelegram {
+
+constexpr float MctsPlanner::WIDENING;
+constexpr float MctsPlanner::EXPLORATION;
+
+MctsPlanner::MctsPlanner(Arena &arena, unsigned seed)
+    : arena(arena), pool(arena), valueScale(1), playoutCount(0), maxDepth(0),
+      hasTree(false), random(seed) {}
+
+void MctsPlanner::reset(const GameState &newRoot, const Action &played) {
+  if (arena.capacity() == 0)
+    arena.reserve(ARENA_BYTES);
+
+  Index kept = NodePool<MctsNode>::NONE;
+  if (hasTree && newRoot.enemyCount == root.enemyCount &&
+      newRoot.dataCount == root.dataCount)
+    kept = findChild(0, played);
+  if (kept == NodePool<MctsNode>::NONE || pool.keepSubtree(kept) == 0) {
+    pool.clear();
+    createNode(Action());
+    pool[0].rotation = 0;
+  }
+  hasTree = true;
+  root = newRoot;
+  updateTargets(root);
+  pool[0].action = Action();
+  playoutCount = 0;
+  maxDepth = 0;
+  valueScale =
+      std::max(1.0f, static_cast<float>(root.dataRemaining) *
+                         (100 + 3 * std::max(0, root.initialTotalLife -
+                                                    3 * root.shots)) +
+                         10.0f * root.enemyCount);
+}
+
+void MctsPlanner::reset(const GameState &newRoot) {
+  reset(newRoot, bestAction());
+}
+
+void MctsPlanner::iterate() {
+  Index path[MAX_DEPTH + 1];
+  int length = 0;
+  Index node = 0;
+  path[length++] = node;
+  scratch = root;
+
+  while (!scratch.isOver() && length <= MAX_DEPTH) {
+    const MctsNode &current = pool[node];
+    float visits = static_cast<float>(current.visits);
+    int allowed = 1 + static_cast<int>(WIDENING * std::sqrt(visits));
+    if (current.expanded < allowed &&
+        current.expanded < candidateCount(scratch)) {
+      Index child = expand(node, scratch);
+      if (child != NodePool<MctsNode>::NONE) {
+        simulate(scratch, pool[child].action);
+        path[length++] = child;
+        break;
+      }
+    }
+    Index next = select(node);
+    if (next == NodePool<MctsNode>::NONE)
+      break;
+    simulate(scratch, pool[next].action);
+    path[length++] = next;
+    node = next;
+  }
+  maxDepth = std::max(maxDepth, length - 1);
+
+  for (int i = 0; i < PLAYOUT_DEPTH && !scratch.isOver(); ++i)
+    simulate(scratch, randomAction(scratch));
+  ++playoutCount;
+  float value = evaluate(scratch) / valueScale;
+
+  for (int i = 0; i < length; ++i) {
+    ++pool[path[i]].visits;
+    pool[path[i]].valueSum += value;
+  }
+}
+
+Action MctsPlanner::bestAction() const {
+  Index best = mostVisited(0);
+  return best == NodePool<MctsNode>::NONE ? Action::move(root.wolff)
+                                          : pool[best].action;
+}
+
+float MctsPlanner::bestValue() const {
+  Index best = mostVisited(0);
+  if (best == NodePool<MctsNode>::NONE)
+    return 0;
+  return pool[best].valueSum / pool[best].visits * valueScale;
+}
+
+unsigned long MctsPlanner::rollouts() const { return playoutCount; }
+
+int MctsPlanner::rootStatistics(ActionStatistics *out, int capacity) const {
+  int count = 0;
+  if (pool.size() == 0)
+    return count;
+  for (Index child = pool[0].firstChild;
+       child != NodePool<MctsNode>::NONE && count < capacity;
+       child = pool[child].nextSibling, ++count) {
+    out[count].action = pool[child].action;
+    out[count].valueSum = pool[child].valueSum * valueScale;
+    out[count].visits = pool[child].visits;
+  }
+  return count;
+}
+
+int MctsPlanner::depth() const { return maxDepth; }
+
+int MctsPlanner::nodes() const { return pool.size(); }
+
+MctsPlanner::Index MctsPlanner::findChild(Index node,
+                                          const Action &action) const {
+  if (node >= pool.size())
+    return NodePool<MctsNode>::NONE;
+  Index child = pool[node].firstChild;
+  while (child != NodePool<MctsNode>::NONE && !(pool[child].action == action))
+    child = pool[child].nextSibling;
+  return child;
+}
+
+MctsPlanner::Index MctsPlanner::mostVisited(Index node) const {
+  Index best = NodePool<MctsNode>::NONE;
+  if (node >= pool.size())
+    return best;
+  for (Index child = pool[node].firstChild; child != NodePool<MctsNode>::NONE;
+       child = pool[child].nextSibling)
+    if (best == NodePool<MctsNode>::NONE ||
+        pool[child].visits > pool[best].visits)
+      best = child;
+  return best;
+}
+
+MctsPlanner::Index MctsPlanner::select(Index node) const {
+  float logVisits = std::log(static_cast<float>(pool[node].visits));
+  Index best = NodePool<MctsNode>::NONE;
+  float bestScore = 0;
+  for (Index child = pool[node].firstChild; child != NodePool<MctsNode>::NONE;
+       child = pool[child].nextSibling) {
+    const MctsNode &n = pool[child];
+    float score = n.valueSum / n.visits +
+                  EXPLORATION * std::sqrt(logVisits / n.visits);
+    if (best == NodePool<MctsNode>::NONE || score > bestScore) {
+      best = child;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+MctsPlanner::Index MctsPlanner::expand(Index node, const GameState &state) {
+  Action action = candidate(state, pool[node].expanded, pool[node].rotation);
+  Index child = createNode(action);
+  if (child == NodePool<MctsNode>::NONE)
+    return child;
+  MctsNode &parent = pool[node];
+  ++parent.expanded;
+  pool[child].nextSibling = parent.firstChild;
+  parent.firstChild = child;
+  return child;
+}
+
+int MctsPlanner::candidateCount(const GameState &state) {
+  return state.enemiesRemaining + MAX_MOVES;
+}
+
+Action MctsPlanner::candidate(const GameState &state, int index,
+                              float rotation) {
+  int shots = state.enemiesRemaining;
+  int move = index;
+  if (index < 2 * shots) {
+    if (index % 2 == 0) {
+      int enemy = static_cast<int>(state.enemyAlive.next(0));
+      for (int i = 0; i < index / 2; ++i)
+        enemy = static_cast<int>(state.enemyAlive.next(enemy + 1));
+      return Action::shoot(enemy);
+    }
+    move = index / 2;
+  } else {
+    move = index - shots;
+  }
+
+  if (move < 2 && shots > 0) {
+    Vector2f threat =
+        state.enemyPositions[state.enemyPositions.nearest(state.wolff)];
+    Vector2f away = state.wolff - threat;
+    if (away.squaredMagnitude() > 0) {
+      away.normalize();
+      return Action::move(state.wolff +
+                          (move == 0 ? away : -away) * WOLFF_STEP);
+    }
+  }
+  int compassFirst = shots > 0 ? 2 : 0;
+  if (move >= compassFirst && move < compassFirst + 8) {
+    static const Vector2f compass[8] = {
+        Vector2f::up(),         Vector2f(0.70710678f, 0.70710678f),
+        Vector2f::right(),      Vector2f(0.70710678f, -0.70710678f),
+        Vector2f::down(),       Vector2f(-0.70710678f, -0.70710678f),
+        Vector2f::left(),       Vector2f(-0.70710678f, 0.70710678f)};
+    const Vector2f &d = compass[move - compassFirst];
+    float c = std::cos(rotation);
+    float s = std::sin(rotation);
+    return Action::move(state.wolff +
+                        Vector2f(d.x * c - d.y * s, d.x * s + d.y * c) *
+                            WOLFF_STEP);
+  }
+  return Action::move(state.wolff + random.inDisc(WOLFF_STEP));
+}
+
+Action MctsPlanner::randomAction(const GameState &state) {
+  if (state.enemiesRemaining > 0 && random.coin()) {
+    int enemy = static_cast<int>(
+        state.enemyAlive.next(random.below(state.enemyCount)));
+    if (enemy >= state.enemyCount)
+      enemy = static_cast<int>(state.enemyAlive.next(0));
+    return Action::shoot(enemy);
+  }
+  return Action::move(state.wolff + random.inDisc(WOLFF_STEP));
+}
+
+MctsPlanner::Index MctsPlanner::createNode(const Action &action) {
+  Index index = pool.create();
+  if (index == NodePool<MctsNode>::NONE)
+    return index;
+  MctsNode &node = pool[index];
+  node.action = action;
+  node.rotation = random.unit() * static_cast<float>(M_PI) / 4;
+  node.valueSum = 0;
+  node.visits = 0;
+  node.expanded = 0;
+  return index;
+}
+}
+
+namespace fuzzyTelegram {
+
+const int BeamPlanner::MIN_WIDTH;
+const int BeamPlanner::MOVES;
+
+static inline void combine(std::uint64_t &hash, std::uint64_t value) {
+  std::uint64_t state = hash ^ value;
+  hash = splitMix64(state);
+}
+
+static inline std::uint64_t positionBits(const Vector2f &position) {
+  std::uint32_t x;
+  std::uint32_t y;
+  std::memcpy(&x, &position.x, sizeof(x));
+  std::memcpy(&y, &position.y, sizeof(y));
+  return static_cast<std::uint64_t>(x) << 32 | y;
+}
+
+BeamPlanner::BeamPlanner(unsigned /*seed*/, int width, int depth)
+    : maxWidth(std::max(width, 1)), depth(std::max(depth, 1)), current(0),
+      currentCount(0), nextCount(0), nextWorst(0), searchWidth(0), layer(0),
+      parent(0), child(0), done(true), stamp(0), bestSequenceValue(0),
+      searchBestValue(0), searchBestLayer(0), rolloutCount(0),
+      duplicateCount(0) {
+  const Vector2f directions[8] = {
+      Vector2f::up(),
+      Vector2f::down(),
+      Vector2f::left(),
+      Vector2f::right(),
+      (Vector2f::up() + Vector2f::right()).normalized(),
+      (Vector2f::up() + Vector2f::left()).normalized(),
+      (Vector2f::down() + Vector2f::right()).normalized(),
+      (Vector2f::down() + Vector2f::left()).normalized()};
+  for (int r = 0; r < RADII; ++r)
+    for (int d = 0; d < 8; ++d)
+      moves[r * 8 + d] = directions[d] * (WOLFF_STEP / (1 << r));
+
+  layers[0].resize(maxWidth);
+  layers[1].resize(maxWidth);
+  order.resize(maxWidth);
+  std::size_t children = 2 * static_cast<std::size_t>(maxWidth) *
+                         (MOVES + MAX_ENEMIES);
+  std::size_t capacity = 1;
+  while (capacity < children)
+    capacity <<= 1;
+  seenHashes.resize(capacity);
+  seenStamps.resize(capacity, 0);
+}
+
+void BeamPlanner::reset(const GameState &newRoot,
+                        const Action & /*played*/) {
+  reset(newRoot);
+}
+
+void BeamPlanner::reset(const GameState &newRoot) {
+  root = newRoot;
+  updateTargets(root);
+  rolloutCount = 0;
+  duplicateCount = 0;
+  best = Action::move(root.wolff);
+  bestSequenceValue = evaluate(root);
+  searchWidth = std::min(MIN_WIDTH, maxWidth);
+  startSearch();
+  while (!done && layer == 0)
+    iterate();
+  best = searchBest;
+  bestSequenceValue = searchBestValue;
+}
+
+void BeamPlanner::iterate() {
+  if (done)
+    return;
+  const Node &node = layers[current][order[parent]];
+  const GameState &state = node.state;
+  if (state.isOver()) {
+    offer(state, node.first);
+    child = MOVES + state.enemyCount;
+  }
+  while (child >= MOVES && child < MOVES + state.enemyCount &&
+         !state.enemyAlive[child - MOVES])
+    ++child;
+  if (child == MOVES + state.enemyCount) {
+    child = 0;
+    if (++parent == currentCount)
+      nextLayer();
+    return;
+  }
+
+  Action action = child < MOVES ? Action::move(state.wolff + moves[child])
+                                : Action::shoot(child - MOVES);
+  ++child;
+  ++rolloutCount;
+  scratch = state;
+  simulate(scratch, action);
+  offer(scratch, layer == 0 ? action : node.first);
+}
+
+Action BeamPlanner::bestAction() const { return best; }
+
+float BeamPlanner::bestValue() const { return bestSequenceValue; }
+
+unsigned long BeamPlanner::rollouts() const { return rolloutCount; }
+
+int BeamPlanner::rootStatistics(ActionStatistics *out, int capacity) const {
+  if (capacity < 1)
+    return 0;
+  out[0].action = best;
+  out[0].valueSum = bestSequenceValue;
+  out[0].visits = 1;
+  return 1;
+}
+
+int BeamPlanner::width() const { return searchWidth; }
+
+bool BeamPlanner::isDone() const { return done; }
+
+unsigned long BeamPlanner::duplicates() const { return duplicateCount; }
+
+void BeamPlanner::startSearch() {
+  current = 0;
+  layers[current][0].state = root;
+  layers[current][0].first = best;
+  layers[current][0].value = bestSequenceValue;
+  order[0] = 0;
+  currentCount = 1;
+  nextCount = 0;
+  nextWorst = 0;
+  layer = 0;
+  parent = 0;
+  child = 0;
+  done = false;
+  searchBestValue = -1;
+  searchBestLayer = 0;
+  ++stamp;
+}
+
+void BeamPlanner::nextLayer() {
+  current = 1 - current;
+  currentCount = nextCount;
+  nextCount = 0;
+  nextWorst = 0;
+  parent = 0;
+  child = 0;
+  ++stamp;
+  if (++layer < depth) {
+    const std::vector<Node> &nodes = layers[current];
+    for (int i = 0; i < currentCount; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.begin() + currentCount,
+              [&nodes](int a, int b) {
+                return nodes[a].value > nodes[b].value;
+              });
+    return;
+  }
+
+  best = searchBest;
+  bestSequenceValue = searchBestValue;
+  if (searchWidth < maxWidth) {
+    searchWidth = std::min(2 * searchWidth, maxWidth);
+    startSearch();
+  } else {
+    done = true;
+  }
+}
+
+void BeamPlanner::offer(const GameState &state, const Action &first) {
+  float real = evaluate(state);
+  if ((layer + 1 > searchBestLayer && !state.wolffDead) ||
+      real > searchBestValue) {
+    searchBest = first;
+    searchBestValue = real;
+    searchBestLayer = layer + 1;
+  }
+  float value = evaluate(state, root.shots);
+  std::vector<Node> &nodes = layers[1 - current];
+  if (nextCount == searchWidth && value <= nodes[nextWorst].value)
+    return;
+  if (!insertSeen(hashState(state))) {
+    ++duplicateCount;
+    return;
+  }
+
+  int slot = nextCount < searchWidth ? nextCount++ : nextWorst;
+  nodes[slot].state = state;
+  nodes[slot].first = first;
+  nodes[slot].value = value;
+  if (nextCount < searchWidth)
+    return;
+  nextWorst = 0;
+  for (int i = 1; i < nextCount; ++i)
+    if (nodes[i].value < nodes[nextWorst].value)
+      nextWorst = i;
+}
+
+bool BeamPlanner::insertSeen(std::uint64_t hash) {
+  const std::size_t mask = seenHashes.size() - 1;
+  std::size_t i = static_cast<std::size_t>(hash) & mask;
+  while (seenStamps[i] == stamp) {
+    if (seenHashes[i] == hash)
+      return false;
+    i = (i + 1) & mask;
+  }
+  seenStamps[i] = stamp;
+  seenHashes[i] = hash;
+  return true;
+}
+
+std::uint64_t BeamPlanner::hashState(const GameState &state) {
+  std::uint64_t hash = positionBits(state.wolff);
+  combine(hash, static_cast<std::uint64_t>(state.shots) << 1 |
+                    static_cast<std::uint64_t>(state.wolffDead));
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    combine(hash, static_cast<std::uint64_t>(i) << 32 |
+                      static_cast<std::uint32_t>(state.enemyLives[i]));
+    combine(hash, positionBits(state.enemyPositions[i]));
+  }
+  for (int i = 0; i < state.dataCount; ++i)
+    if (state.dataAlive[i])
+      combine(hash, static_cast<std::uint64_t>(i));
+  return hash;
+}
+}
+#ifdef FUZZY_THREADS
+#endif
+#ifdef FUZZY_REPLAY
+#endif
+
+using namespace std;
+using namespace fuzzyTelegram;
+
+#if defined(FUZZY_MCTS)
+typedef MctsPlanner Planner;
+#elif defined(FUZZY_EVOLUTION)
+typedef EvolutionPlanner Planner;
+#elif defined(FUZZY_BEAM)
+typedef BeamPlanner Planner;
+#else
+typedef RolloutPlanner Planner;
+#endif
+
+/**
+ * Shoot enemies before they collect all the incriminating data!
+ * The closer you are to an enemy, the more damage you do but don't get too
+ *close or you'll get killed.
+ **/
+int main() {
+  InputReader input;
+  TurnClock clock;
+  GameState state;
+#if defined(FUZZY_THREADS)
+  ParallelPlanner<Planner> planner(
+      static_cast<int>(std::thread::hardware_concurrency()));
+#elif defined(FUZZY_MCTS)
+  Arena arena;
+  Planner planner(arena);
+#else
+  Planner planner;
+#endif
+  int initialEnemyCount = -1;
+  DivergenceTracker divergence;
+  Action played;
+#ifdef FUZZY_TRACE
+  PhaseTrace trace;
+#endif
+#ifdef FUZZY_REPLAY
+  ReplayWriter replay;
+  if (const char *path = std::getenv("FUZZY_REPLAY"))
+    replay.open(path);
+#endif
+
+  while (input.waitInput()) {
+    clock.startTurn();
+    {
+      FUZZY_PHASE(trace, PHASE_PARSE);
+      if (!input.readTurn(state))
+        break;
+    }
+
+    {
+      FUZZY_PHASE(trace, PHASE_RESET);
+      if (divergence.hasPrediction()) {
+        bool exact = divergence.compare(state).exact();
+        divergence.printTurn(cerr);
+        if (exact)
+          state = divergence.prediction();
+      }
+      if (initialEnemyCount < 0) {
+        initialEnemyCount = state.enemyCount;
+        for (int i = 0; i < state.enemyCount; i++)
+          state.initialTotalLife += state.enemyLives[i];
+      }
+      state.kills = initialEnemyCount - state.enemiesRemaining;
+
+      planner.reset(state, played);
+    }
+
+    {
+      FUZZY_PHASE(trace, PHASE_SEARCH);
+#ifdef FUZZY_THREADS
+      planner.run(clock);
+#else
+      runAnytime(planner, clock);
+#endif
+    }
+
+    {
+      FUZZY_PHASE(trace, PHASE_OUTPUT);
+      double elapsed = clock.elapsedMs();
+      cerr << "rollouts " << planner.rollouts() << " ("
+           << static_cast<long>(planner.rollouts() / elapsed * 1000)
+           << "/s) value " << planner.bestValue() << " in " << elapsed
+           << " ms" << endl;
+#if defined(FUZZY_MCTS) && !defined(FUZZY_THREADS)
+      cerr << "depth " << planner.depth() << " nodes " << planner.nodes()
+           << " arena peak " << arena.peak() / 1024 << " KB" << endl;
+#elif defined(FUZZY_BEAM) && !defined(FUZZY_THREADS)
+      cerr << "width " << planner.width() << " duplicates "
+           << planner.duplicates() << endl;
+#endif
+
+      Action action = playableAction(state, planner.bestAction());
+      played = action;
+      divergence.predict(state, action);
+      if (action.type == Action::SHOOT) {
+        ++state.shots;
+        cout << "SHOOT " << state.enemyIds[action.enemy] << endl;
+      } else {
+        Vector2i destination(clampToMap(action.destination));
+        cout << "MOVE " << destination.x << ' ' << destination.y << endl;
+      }
+#ifdef FUZZY_REPLAY
+      replay.write(state, &action, planner.rollouts(), planner.bestValue(),
+                   elapsed);
+#endif
+    }
+#ifdef FUZZY_TRACE
+    trace.endTurn(cerr);
+#endif
+  }
+  divergence.printTotals(cerr);
+#ifdef FUZZY_TRACE
+  if (const char *path = std::getenv("FUZZY_TRACE_JSON"))
+    trace.writeChromeTrace(path);
+#endif
 }
+template class fuzzyTelegram::Vector2<int>;
+template class fuzzyTelegram::Vector2<float>;
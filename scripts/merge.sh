@@ -1,6 +1,10 @@
 #!/bin/bash
 # Merge all files given by a file's list into another file,
 # deleting #include directives for local libraries.
+# The merged file is what we submit : it starts with the optimization pragmas
+# so that the judge compiles the code paths we benchmark, it ends with the
+# explicit instantiations of the Vector2 types the bot uses, and the
+# documentation comments and blank lines are dropped to keep it small.
 
 # Arguments :
 # The file's list containing the list of files to merge
@@ -12,18 +16,55 @@ to="$1"
 
 temp=$(mktemp) # Temporary file
 
-cat "$temp"
+# Read the files to merge, skipping blank lines
+files=()
+while IFS='' read -r line || [[ -n "$line" ]]; do
+    [[ -n "$line" ]] && files+=("$line")
+done < "$filesList"
+
+# Optimization pragmas, before any included code. The target pragma does not
+# define __AVX2__, FUZZY_TARGET_AVX2 tells the code it may use AVX2
+cat > "$to" << 'EOF'
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("O3,unroll-loops")
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(FUZZY_NO_AVX2)
+#pragma GCC target("avx2,fma")
+#define FUZZY_TARGET_AVX2
+#endif
+#endif
+EOF
 
-# Get all "#include <*>" and copy them to top of $to file
-grep -he "#include <.*>" -r include src | sort -u > "$to"
+# Get all "#include <*>" of the merged files and copy them once to $to file
+grep -he "^#include <.*>" "${files[@]}" | sort -u >> "$to"
 
 # Get all hpp and cpp and add them to $temp file
-while IFS='' read -r line || [[ -n "$line" ]]; do
-    cat "$line" >> "$temp"
-done < "$filesList"
+for file in "${files[@]}"; do
+    cat "$file" >> "$temp"
+done
+
+# Remove all "#include" directives, documentation comments and comment lines
+# from the $temp file, squeeze blank lines and add it to $to file
+sed '/^#include/d' "$temp" |
+    awk '/^[ \t]*\/\*!/ { doc = 1 }
+         !doc && !/^[ \t]*\/\/ / { print }
+         doc && /\*\// { doc = 0 }' |
+    cat -s >> "$to"
 
-# Remove all "#include" directives from the $temp file and add it to $to file
-sed '/^#include/d' "$temp" >> "$to"
+# Explicitly instantiate the Vector2 types used outside of Vector2 itself
+types=("c:char" "si:short int" "i:int" "li:long int" "f:float" "d:double"
+       "ld:long double" "uc:unsigned char" "usi:unsigned short int"
+       "ui:unsigned int" "uli:unsigned long int")
+users=()
+for file in "${files[@]}"; do
+    [[ "$file" != *Vector2.[ch]pp ]] && users+=("$file")
+done
+for entry in "${types[@]}"; do
+    suffix="${entry%%:*}"
+    type="${entry#*:}"
+    if grep -qE "\bVector2$suffix\b|\bVector2<$type>" "${users[@]}"; then
+        echo "template class fuzzyTelegram::Vector2<$type>;" >> "$to"
+    fi
+done
 
 # Remove temporary file
 rm -rf "$temp"
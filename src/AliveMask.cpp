@@ -0,0 +1,52 @@
+#include "AliveMask.hpp"
+#include <cassert>
+
+namespace fuzzyTelegram {
+
+template <std::size_t Capacity> AliveMask<Capacity>::AliveMask(void) {
+  clear();
+}
+
+template <std::size_t Capacity> void AliveMask<Capacity>::clear() {
+  for (std::size_t w = 0; w < WORDS; ++w)
+    words[w] = 0;
+}
+
+template <std::size_t Capacity> void AliveMask<Capacity>::set(std::size_t i) {
+  assert(i < Capacity);
+  words[i / 64] |= std::uint64_t(1) << (i % 64);
+}
+
+template <std::size_t Capacity>
+void AliveMask<Capacity>::reset(std::size_t i) {
+  assert(i < Capacity);
+  words[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+}
+
+template <std::size_t Capacity>
+bool AliveMask<Capacity>::operator[](std::size_t i) const {
+  assert(i < Capacity);
+  return (words[i / 64] >> (i % 64)) & 1;
+}
+
+template <std::size_t Capacity> std::size_t AliveMask<Capacity>::count() const {
+  std::size_t total = 0;
+  for (std::size_t w = 0; w < WORDS; ++w)
+    total += __builtin_popcountll(words[w]);
+  return total;
+}
+
+template <std::size_t Capacity>
+std::size_t AliveMask<Capacity>::next(std::size_t from) const {
+  if (from >= Capacity)
+    return Capacity;
+  std::size_t w = from / 64;
+  std::uint64_t word = words[w] & (~std::uint64_t(0) << (from % 64));
+  while (word == 0) {
+    if (++w == WORDS)
+      return Capacity;
+    word = words[w];
+  }
+  return w * 64 + __builtin_ctzll(word);
+}
+}
@@ -0,0 +1,35 @@
+#include "AnytimeSearch.hpp"
+
+namespace fuzzyTelegram {
+
+AnytimeConfig::AnytimeConfig(unsigned checkIntervalValue,
+                             double safetyMarginMsValue)
+    : checkInterval(checkIntervalValue), safetyMarginMs(safetyMarginMsValue) {}
+
+/*!
+* \brief Return search.isDone(), for the searches that end.
+*/
+template <typename Search>
+static auto isDone(const Search &search, int) -> decltype(search.isDone()) {
+  return search.isDone();
+}
+
+/*!
+* \brief Return false, for the searches that never end.
+*/
+template <typename Search> static bool isDone(const Search &, long) {
+  return false;
+}
+
+template <typename Search>
+unsigned long runAnytime(Search &search, const TurnClock &clock,
+                         const AnytimeConfig &config) {
+  unsigned long iterations = 0;
+  while (!clock.expired(config.safetyMarginMs) && !isDone(search, 0)) {
+    for (unsigned i = 0; i < config.checkInterval; ++i)
+      search.iterate();
+    iterations += config.checkInterval;
+  }
+  return iterations;
+}
+}
@@ -0,0 +1,142 @@
+#include "Arena.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+namespace fuzzyTelegram {
+
+Arena::Arena(void) : buffer(nullptr), size(0), offset(0), highWater(0) {}
+
+Arena::~Arena() { delete[] buffer; }
+
+void Arena::reserve(std::size_t bytes) {
+  delete[] buffer;
+  buffer = new unsigned char[bytes];
+  std::memset(buffer, 0, bytes);
+  size = bytes;
+  offset = 0;
+  highWater = 0;
+}
+
+void *Arena::allocate(std::size_t bytes, std::size_t alignment) {
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer + offset);
+  std::size_t padding = (alignment - address % alignment) % alignment;
+  if (bytes + padding > size - offset)
+    return nullptr;
+  void *memory = buffer + offset + padding;
+  offset += padding + bytes;
+  highWater = std::max(highWater, offset);
+  return memory;
+}
+
+std::size_t Arena::mark() const { return offset; }
+
+void Arena::release(std::size_t mark) {
+  assert(mark <= offset);
+  offset = mark;
+}
+
+void Arena::reset() { offset = 0; }
+
+std::size_t Arena::capacity() const { return size; }
+
+std::size_t Arena::used() const { return offset; }
+
+std::size_t Arena::peak() const { return highWater; }
+
+template <typename Node>
+const typename NodePool<Node>::Index NodePool<Node>::NONE;
+
+template <typename Node>
+NodePool<Node>::NodePool(Arena &arena)
+    : arena(arena), nodes(nullptr), count(0) {
+  static_assert(std::is_trivially_copyable<Node>::value,
+                "nodes are moved with memcpy");
+}
+
+template <typename Node>
+typename NodePool<Node>::Index NodePool<Node>::size() const {
+  return count;
+}
+
+template <typename Node> void NodePool<Node>::clear() {
+  arena.reset();
+  nodes = nullptr;
+  count = 0;
+}
+
+template <typename Node>
+typename NodePool<Node>::Index NodePool<Node>::create() {
+  Node *node =
+      static_cast<Node *>(arena.allocate(sizeof(Node), alignof(Node)));
+  if (node == nullptr)
+    return NONE;
+  if (count == 0)
+    nodes = node;
+  assert(node == nodes + count);
+  node->firstChild = NONE;
+  node->nextSibling = NONE;
+  return count++;
+}
+
+template <typename Node> Node &NodePool<Node>::operator[](Index i) {
+  assert(i >= 0 && i < count);
+  return nodes[i];
+}
+
+template <typename Node>
+const Node &NodePool<Node>::operator[](Index i) const {
+  assert(i >= 0 && i < count);
+  return nodes[i];
+}
+
+template <typename Node>
+typename NodePool<Node>::Index NodePool<Node>::keepSubtree(Index root) {
+  if (root == NONE || count == 0) {
+    clear();
+    return 0;
+  }
+  // Copy the subtree after the pool, the copies being the queue of the
+  // breadth first walk, then move it to the front.
+  std::size_t start = arena.mark();
+  Node *copies = nodes + count;
+  Index kept = 0;
+  auto copy = [&](Index from) -> Index {
+    Node *node =
+        static_cast<Node *>(arena.allocate(sizeof(Node), alignof(Node)));
+    if (node == nullptr)
+      return NONE;
+    assert(node == copies + kept);
+    std::memcpy(static_cast<void *>(node), &nodes[from], sizeof(Node));
+    return kept++;
+  };
+  if (copy(root) == NONE) {
+    clear();
+    return 0;
+  }
+  for (Index head = 0; head < kept; ++head) {
+    Index previous = NONE;
+    for (Index child = copies[head].firstChild; child != NONE;
+         child = nodes[child].nextSibling) {
+      Index moved = copy(child);
+      if (moved == NONE) {
+        clear();
+        return 0;
+      }
+      if (previous == NONE)
+        copies[head].firstChild = moved;
+      else
+        copies[previous].nextSibling = moved;
+      previous = moved;
+    }
+    if (previous != NONE)
+      copies[previous].nextSibling = NONE;
+  }
+  copies[0].nextSibling = NONE;
+  std::memmove(static_cast<void *>(nodes), copies, kept * sizeof(Node));
+  arena.release(start - (count - kept) * sizeof(Node));
+  count = kept;
+  return kept;
+}
+}
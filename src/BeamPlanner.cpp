@@ -0,0 +1,243 @@
+#include "BeamPlanner.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace fuzzyTelegram {
+
+const int BeamPlanner::MIN_WIDTH;
+const int BeamPlanner::MOVES;
+
+/*!
+* \brief Mix value into hash.
+*/
+static inline void combine(std::uint64_t &hash, std::uint64_t value) {
+  std::uint64_t state = hash ^ value;
+  hash = splitMix64(state);
+}
+
+/*!
+* \brief Return the bits of the coordinates of position.
+*/
+static inline std::uint64_t positionBits(const Vector2f &position) {
+  std::uint32_t x;
+  std::uint32_t y;
+  std::memcpy(&x, &position.x, sizeof(x));
+  std::memcpy(&y, &position.y, sizeof(y));
+  return static_cast<std::uint64_t>(x) << 32 | y;
+}
+
+BeamPlanner::BeamPlanner(unsigned /*seed*/, int width, int depth)
+    : maxWidth(std::max(width, 1)), depth(std::max(depth, 1)), current(0),
+      currentCount(0), nextCount(0), nextWorst(0), searchWidth(0), layer(0),
+      parent(0), child(0), done(true), stamp(0), bestSequenceValue(0),
+      searchBestValue(0), searchBestLayer(0), rolloutCount(0),
+      duplicateCount(0) {
+  const Vector2f directions[8] = {
+      Vector2f::up(),
+      Vector2f::down(),
+      Vector2f::left(),
+      Vector2f::right(),
+      (Vector2f::up() + Vector2f::right()).normalized(),
+      (Vector2f::up() + Vector2f::left()).normalized(),
+      (Vector2f::down() + Vector2f::right()).normalized(),
+      (Vector2f::down() + Vector2f::left()).normalized()};
+  for (int r = 0; r < RADII; ++r)
+    for (int d = 0; d < 8; ++d)
+      moves[r * 8 + d] = directions[d] * (WOLFF_STEP / (1 << r));
+
+  layers[0].resize(maxWidth);
+  layers[1].resize(maxWidth);
+  order.resize(maxWidth);
+  // Twice the children of a layer, so that probes stay short.
+  std::size_t children = 2 * static_cast<std::size_t>(maxWidth) *
+                         (MOVES + MAX_ENEMIES);
+  std::size_t capacity = 1;
+  while (capacity < children)
+    capacity <<= 1;
+  seenHashes.resize(capacity);
+  seenStamps.resize(capacity, 0);
+}
+
+void BeamPlanner::reset(const GameState &newRoot,
+                        const Action & /*played*/) {
+  reset(newRoot);
+}
+
+void BeamPlanner::reset(const GameState &newRoot) {
+  root = newRoot;
+  updateTargets(root);
+  rolloutCount = 0;
+  duplicateCount = 0;
+  best = Action::move(root.wolff);
+  bestSequenceValue = evaluate(root);
+  searchWidth = std::min(MIN_WIDTH, maxWidth);
+  startSearch();
+  while (!done && layer == 0)
+    iterate();
+  best = searchBest;
+  bestSequenceValue = searchBestValue;
+}
+
+void BeamPlanner::iterate() {
+  if (done)
+    return;
+  const Node &node = layers[current][order[parent]];
+  const GameState &state = node.state;
+  // An ended game has no children, it goes on to the next layer as it is.
+  if (state.isOver()) {
+    offer(state, node.first);
+    child = MOVES + state.enemyCount;
+  }
+  while (child >= MOVES && child < MOVES + state.enemyCount &&
+         !state.enemyAlive[child - MOVES])
+    ++child;
+  if (child == MOVES + state.enemyCount) {
+    child = 0;
+    if (++parent == currentCount)
+      nextLayer();
+    return;
+  }
+
+  Action action = child < MOVES ? Action::move(state.wolff + moves[child])
+                                : Action::shoot(child - MOVES);
+  ++child;
+  ++rolloutCount;
+  scratch = state;
+  simulate(scratch, action);
+  offer(scratch, layer == 0 ? action : node.first);
+}
+
+Action BeamPlanner::bestAction() const { return best; }
+
+float BeamPlanner::bestValue() const { return bestSequenceValue; }
+
+unsigned long BeamPlanner::rollouts() const { return rolloutCount; }
+
+int BeamPlanner::rootStatistics(ActionStatistics *out, int capacity) const {
+  if (capacity < 1)
+    return 0;
+  out[0].action = best;
+  out[0].valueSum = bestSequenceValue;
+  out[0].visits = 1;
+  return 1;
+}
+
+int BeamPlanner::width() const { return searchWidth; }
+
+bool BeamPlanner::isDone() const { return done; }
+
+unsigned long BeamPlanner::duplicates() const { return duplicateCount; }
+
+void BeamPlanner::startSearch() {
+  current = 0;
+  layers[current][0].state = root;
+  layers[current][0].first = best;
+  layers[current][0].value = bestSequenceValue;
+  order[0] = 0;
+  currentCount = 1;
+  nextCount = 0;
+  nextWorst = 0;
+  layer = 0;
+  parent = 0;
+  child = 0;
+  done = false;
+  searchBestValue = -1;
+  searchBestLayer = 0;
+  ++stamp;
+}
+
+void BeamPlanner::nextLayer() {
+  current = 1 - current;
+  currentCount = nextCount;
+  nextCount = 0;
+  nextWorst = 0;
+  parent = 0;
+  child = 0;
+  ++stamp;
+  if (++layer < depth) {
+    // The best states first, so that a search stopped in the middle of a
+    // layer has expanded them.
+    const std::vector<Node> &nodes = layers[current];
+    for (int i = 0; i < currentCount; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.begin() + currentCount,
+              [&nodes](int a, int b) {
+                return nodes[a].value > nodes[b].value;
+              });
+    return;
+  }
+
+  best = searchBest;
+  bestSequenceValue = searchBestValue;
+  if (searchWidth < maxWidth) {
+    searchWidth = std::min(2 * searchWidth, maxWidth);
+    startSearch();
+  } else {
+    done = true;
+  }
+}
+
+void BeamPlanner::offer(const GameState &state, const Action &first) {
+  // The first state of a deeper layer where Wolff lives beats the best of
+  // the previous ones, so that when every sequence dies the longest wins.
+  float real = evaluate(state);
+  if ((layer + 1 > searchBestLayer && !state.wolffDead) ||
+      real > searchBestValue) {
+    searchBest = first;
+    searchBestValue = real;
+    searchBestLayer = layer + 1;
+  }
+  // The hash of an evicted node stays in the table. A state equal to it has
+  // its value, at most the worst of the full layer, so it is pruned anyway.
+  float value = evaluate(state, root.shots);
+  std::vector<Node> &nodes = layers[1 - current];
+  if (nextCount == searchWidth && value <= nodes[nextWorst].value)
+    return;
+  if (!insertSeen(hashState(state))) {
+    ++duplicateCount;
+    return;
+  }
+
+  int slot = nextCount < searchWidth ? nextCount++ : nextWorst;
+  nodes[slot].state = state;
+  nodes[slot].first = first;
+  nodes[slot].value = value;
+  if (nextCount < searchWidth)
+    return;
+  nextWorst = 0;
+  for (int i = 1; i < nextCount; ++i)
+    if (nodes[i].value < nodes[nextWorst].value)
+      nextWorst = i;
+}
+
+bool BeamPlanner::insertSeen(std::uint64_t hash) {
+  const std::size_t mask = seenHashes.size() - 1;
+  std::size_t i = static_cast<std::size_t>(hash) & mask;
+  while (seenStamps[i] == stamp) {
+    if (seenHashes[i] == hash)
+      return false;
+    i = (i + 1) & mask;
+  }
+  seenStamps[i] = stamp;
+  seenHashes[i] = hash;
+  return true;
+}
+
+std::uint64_t BeamPlanner::hashState(const GameState &state) {
+  std::uint64_t hash = positionBits(state.wolff);
+  combine(hash, static_cast<std::uint64_t>(state.shots) << 1 |
+                    static_cast<std::uint64_t>(state.wolffDead));
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    combine(hash, static_cast<std::uint64_t>(i) << 32 |
+                      static_cast<std::uint32_t>(state.enemyLives[i]));
+    combine(hash, positionBits(state.enemyPositions[i]));
+  }
+  for (int i = 0; i < state.dataCount; ++i)
+    if (state.dataAlive[i])
+      combine(hash, static_cast<std::uint64_t>(i));
+  return hash;
+}
+}
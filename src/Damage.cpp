@@ -0,0 +1,105 @@
+#include "Damage.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace fuzzyTelegram {
+
+const int DamageTable::MIN_EXPONENT;
+const int DamageTable::MAX_EXPONENT;
+const int DamageTable::SUBDIVISION_BITS;
+const int DamageTable::BUCKETS;
+const int DamageTable::MAX_DAMAGE;
+
+int shotDamage(float distance) {
+  if (distance <= 1.0f)
+    return 125000;
+  return static_cast<int>(std::round(125000.0 / std::pow(distance, 1.2)));
+}
+
+/*!
+* \brief The shift from the bits of a squared distance to its bucket key.
+*/
+static const int BUCKET_SHIFT = 23 - DamageTable::SUBDIVISION_BITS;
+
+/*!
+* \brief The key of the first bucket, the bits of 2^MIN_EXPONENT shifted.
+*/
+static const std::uint32_t FIRST_BUCKET_KEY =
+    static_cast<std::uint32_t>(127 + DamageTable::MIN_EXPONENT)
+    << DamageTable::SUBDIVISION_BITS;
+
+static inline std::uint32_t floatBits(float x) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+static inline float bitsFloat(std::uint32_t bits) {
+  float x;
+  std::memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+/*!
+* \brief Return the damage of a squared distance as simulations used to
+* compute it, the distance with the default Vector2f::magnitude.
+*/
+static inline int referenceDamage(float squaredDistance) {
+  return shotDamage(
+      static_cast<float>(std::sqrt(static_cast<double>(squaredDistance))));
+}
+
+DamageTable::DamageTable() {
+  // The damage never increases with the distance : the largest squared
+  // distance doing damage is found by bisection on the bits, which are
+  // ordered like the positive floats.
+  thresholds[0] = INFINITY;
+  for (int damage = 1; damage <= MAX_DAMAGE + 1; ++damage) {
+    std::uint32_t low = 0;
+    std::uint32_t high = floatBits(INFINITY);
+    while (low + 1 < high) {
+      std::uint32_t middle = low + (high - low) / 2;
+      if (referenceDamage(bitsFloat(middle)) >= damage)
+        low = middle;
+      else
+        high = middle;
+    }
+    thresholds[damage] = bitsFloat(low);
+  }
+  for (int i = 0; i < BUCKETS; ++i) {
+    float largest = bitsFloat(((FIRST_BUCKET_KEY + i + 1) << BUCKET_SHIFT) - 1);
+    int damage = referenceDamage(largest);
+    assert(damage >= 0 && damage < MAX_DAMAGE);
+    buckets[i] = static_cast<std::uint8_t>(damage);
+  }
+}
+
+int DamageTable::damage(float squaredDistance) const {
+  // Negative numbers and NaN have keys far out of the table.
+  std::uint32_t bucket =
+      (floatBits(squaredDistance) >> BUCKET_SHIFT) - FIRST_BUCKET_KEY;
+  if (bucket >= static_cast<std::uint32_t>(BUCKETS))
+    return referenceDamage(squaredDistance);
+  int damage = buckets[bucket];
+  while (squaredDistance <= thresholds[damage + 1])
+    ++damage;
+  return damage;
+}
+
+float DamageTable::reach(int damage) const { return thresholds[damage]; }
+
+int shotDamageSquared(float squaredDistance) {
+  static const DamageTable table;
+  return table.damage(squaredDistance);
+}
+
+int shotsToKill(int life, float squaredDistance) {
+  if (life <= 0)
+    return 0;
+  int damage = shotDamageSquared(squaredDistance);
+  if (damage == 0)
+    return -1;
+  return (life + damage - 1) / damage;
+}
+}
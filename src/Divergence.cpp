@@ -0,0 +1,138 @@
+#include "Divergence.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace fuzzyTelegram {
+
+const int DivergenceTracker::MAX_PRINTED_ENEMIES;
+
+Divergence::Divergence(void)
+    : wolffError(0), enemies(0), enemiesMoved(0), maxEnemyError(0),
+      livesChanged(0), enemiesMissed(0), dataMissed(0) {}
+
+bool Divergence::exact() const {
+  return wolffError == 0 && enemiesMoved == 0 && livesChanged == 0 &&
+         enemiesMissed == 0 && dataMissed == 0;
+}
+
+DivergenceTracker::DivergenceTracker(void)
+    : pending(false), printed(0), compared(0), exactCount(0), wolffErrors(0),
+      enemiesMoved(0), livesChanged(0), entitiesMissed(0), maxEnemyError(0) {}
+
+void DivergenceTracker::predict(const GameState &root, const Action &action) {
+  predicted = root;
+  simulate(predicted, action);
+  pending = true;
+}
+
+bool DivergenceTracker::hasPrediction() const { return pending; }
+
+const Divergence &DivergenceTracker::compare(const GameState &observed) {
+  pending = false;
+  last = Divergence();
+  printed = 0;
+  last.wolffError = Vector2f::distance(predicted.wolff, observed.wolff);
+
+  // Both states keep their entities in the order of the ids : they are
+  // matched walking them side by side.
+  int p = 0;
+  int o = 0;
+  while (true) {
+    while (p < predicted.enemyCount && !predicted.enemyAlive[p])
+      ++p;
+    while (o < observed.enemyCount && !observed.enemyAlive[o])
+      ++o;
+    if (p == predicted.enemyCount || o == observed.enemyCount) {
+      for (; p < predicted.enemyCount; ++p)
+        last.enemiesMissed += predicted.enemyAlive[p];
+      for (; o < observed.enemyCount; ++o)
+        last.enemiesMissed += observed.enemyAlive[o];
+      break;
+    }
+    if (predicted.enemyIds[p] != observed.enemyIds[o]) {
+      ++last.enemiesMissed;
+      ++(predicted.enemyIds[p] < observed.enemyIds[o] ? p : o);
+      continue;
+    }
+    ++last.enemies;
+    float error = Vector2f::distance(predicted.enemyPositions[p],
+                                     observed.enemyPositions[o]);
+    bool lifeChanged = predicted.enemyLives[p] != observed.enemyLives[o];
+    last.enemiesMoved += error != 0;
+    last.livesChanged += lifeChanged;
+    last.maxEnemyError = std::max(last.maxEnemyError, error);
+    if ((error != 0 || lifeChanged) && printed < MAX_PRINTED_ENEMIES) {
+      printedIds[printed] = observed.enemyIds[o];
+      printedPredicted[printed] = predicted.enemyPositions[p];
+      printedObserved[printed] = observed.enemyPositions[o];
+      printedLives[printed][0] = predicted.enemyLives[p];
+      printedLives[printed][1] = observed.enemyLives[o];
+      ++printed;
+    }
+    ++p;
+    ++o;
+  }
+
+  p = 0;
+  o = 0;
+  while (true) {
+    while (p < predicted.dataCount && !predicted.dataAlive[p])
+      ++p;
+    while (o < observed.dataCount && !observed.dataAlive[o])
+      ++o;
+    if (p == predicted.dataCount || o == observed.dataCount) {
+      for (; p < predicted.dataCount; ++p)
+        last.dataMissed += predicted.dataAlive[p];
+      for (; o < observed.dataCount; ++o)
+        last.dataMissed += observed.dataAlive[o];
+      break;
+    }
+    if (predicted.dataIds[p] != observed.dataIds[o]) {
+      ++last.dataMissed;
+      ++(predicted.dataIds[p] < observed.dataIds[o] ? p : o);
+      continue;
+    }
+    ++p;
+    ++o;
+  }
+
+  ++compared;
+  exactCount += last.exact();
+  wolffErrors += last.wolffError != 0;
+  enemiesMoved += last.enemiesMoved;
+  livesChanged += last.livesChanged;
+  entitiesMissed += last.enemiesMissed + last.dataMissed;
+  maxEnemyError = std::max(maxEnemyError, last.maxEnemyError);
+  return last;
+}
+
+const GameState &DivergenceTracker::prediction() const { return predicted; }
+
+void DivergenceTracker::printTurn(std::ostream &output) const {
+  if (last.exact()) {
+    output << "prediction exact, " << last.enemies << " enemies" << std::endl;
+    return;
+  }
+  output << "prediction off : wolff " << last.wolffError << " enemies moved "
+         << last.enemiesMoved << '/' << last.enemies << " (max "
+         << last.maxEnemyError << ") lives " << last.livesChanged
+         << " missed enemies " << last.enemiesMissed << " data "
+         << last.dataMissed << std::endl;
+  for (int i = 0; i < printed; ++i)
+    output << "  enemy " << printedIds[i] << " predicted "
+           << printedPredicted[i] << " life " << printedLives[i][0]
+           << " parsed " << printedObserved[i] << " life "
+           << printedLives[i][1] << std::endl;
+}
+
+void DivergenceTracker::printTotals(std::ostream &output) const {
+  output << "predictions exact " << exactCount << '/' << compared
+         << " wolff off " << wolffErrors << " enemies moved " << enemiesMoved
+         << " (max " << maxEnemyError << ") lives " << livesChanged
+         << " missed " << entitiesMissed << std::endl;
+}
+
+int DivergenceTracker::turns() const { return compared; }
+
+int DivergenceTracker::exactTurns() const { return exactCount; }
+}
@@ -0,0 +1,168 @@
+#include "EvolutionPlanner.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return a number in [0, bound) from 32 random bits.
+*/
+static inline int scaleBits(std::uint32_t bits, std::uint32_t bound) {
+  return static_cast<int>((static_cast<std::uint64_t>(bits) * bound) >> 32);
+}
+
+Gene Gene::fromBits(const std::uint32_t *bits, int enemies) {
+  Gene gene;
+  gene.kind = static_cast<std::uint8_t>(bits[0] >> 31);
+  gene.enemy = static_cast<std::uint8_t>(
+      scaleBits(bits[1], static_cast<std::uint32_t>(std::max(enemies, 1))));
+  gene.angle = static_cast<std::uint16_t>(bits[2] >> 16);
+  gene.distance = static_cast<std::uint16_t>(
+      scaleBits(bits[3], static_cast<std::uint32_t>(WOLFF_STEP) + 1));
+  return gene;
+}
+
+Action Gene::decode(const GameState &state) const {
+  if (kind == SHOOT && state.enemiesRemaining > 0) {
+    if (enemy < state.enemyCount && state.enemyAlive[enemy])
+      return Action::shoot(enemy);
+    return Action::shoot(
+        static_cast<int>(state.enemyPositions.nearest(state.wolff)));
+  }
+  float radians = angle * (2 * static_cast<float>(M_PI) / 65536);
+  return Action::move(state.wolff +
+                      Vector2f(std::cos(radians), std::sin(radians)) *
+                          static_cast<float>(distance));
+}
+
+EvolutionPlanner::EvolutionPlanner(unsigned seed)
+    : best(0), worst(0), initialized(false), rolloutCount(0), random(seed) {}
+
+void EvolutionPlanner::reset(const GameState &newRoot, const Action &played) {
+  // The first gene drawn again in each genome : the last one in the genomes
+  // that played the action, all of them in the others.
+  int first[POPULATION];
+  for (int i = 0; i < POPULATION; ++i) {
+    Gene *genes = population[i].genes;
+    first[i] = initialized && genes[0].decode(root) == played ? HORIZON - 1 : 0;
+    if (first[i] == 0)
+      continue;
+    // Follow the enemies by id, their slots change when others die.
+    for (int j = 0; j + 1 < HORIZON; ++j) {
+      genes[j] = genes[j + 1];
+      if (genes[j].kind != Gene::SHOOT)
+        continue;
+      int slot = genes[j].enemy < root.enemyCount
+                     ? newRoot.findEnemy(root.enemyIds[genes[j].enemy])
+                     : -1;
+      genes[j].enemy = slot < 0 ? MAX_ENEMIES : slot;
+    }
+  }
+  root = newRoot;
+  updateTargets(root);
+  rolloutCount = 0;
+  for (int i = 0; i < POPULATION; ++i) {
+    for (int j = first[i]; j < HORIZON; ++j)
+      population[i].genes[j] = randomGene();
+    evaluate(population[i]);
+  }
+  initialized = true;
+  rank();
+}
+
+void EvolutionPlanner::reset(const GameState &newRoot) {
+  reset(newRoot, bestAction());
+}
+
+void EvolutionPlanner::iterate() {
+  const Genome &mother = population[tournament()];
+  const Genome &father = population[tournament()];
+  // One draw picks the parent of every gene.
+  std::uint32_t parents = random();
+  for (int i = 0; i < HORIZON; ++i)
+    child.genes[i] = (parents >> i) & 1 ? mother.genes[i] : father.genes[i];
+
+  // Either replace a gene, or nudge a move.
+  Gene &gene = child.genes[random.below(HORIZON)];
+  if (gene.kind == Gene::MOVE && random.coin()) {
+    gene.angle =
+        static_cast<std::uint16_t>(gene.angle + random.range(-4096, 4096));
+    int distance = gene.distance + random.range(-4096, 4096) / 16;
+    gene.distance = static_cast<std::uint16_t>(
+        std::min(std::max(distance, 0), static_cast<int>(WOLFF_STEP)));
+  } else {
+    gene = randomGene();
+  }
+
+  evaluate(child);
+  if (child.value > population[worst].value) {
+    population[worst] = child;
+    rank();
+  }
+}
+
+Action EvolutionPlanner::bestAction() const {
+  return population[best].genes[0].decode(root);
+}
+
+float EvolutionPlanner::bestValue() const { return population[best].value; }
+
+unsigned long EvolutionPlanner::rollouts() const { return rolloutCount; }
+
+int EvolutionPlanner::rootStatistics(ActionStatistics *out,
+                                     int capacity) const {
+  // Each genome is a visit of its first action.
+  int count = 0;
+  for (int i = 0; i < POPULATION; ++i) {
+    Action action = population[i].genes[0].decode(root);
+    int j = 0;
+    while (j < count && !(out[j].action == action))
+      ++j;
+    if (j == count) {
+      if (count == capacity)
+        continue;
+      out[count].action = action;
+      out[count].valueSum = 0;
+      out[count].visits = 0;
+      ++count;
+    }
+    out[j].valueSum += population[i].value;
+    ++out[j].visits;
+  }
+  return count;
+}
+
+Gene EvolutionPlanner::randomGene() {
+  std::uint32_t bits[4] = {random(), random(), random(), random()};
+  return Gene::fromBits(bits, root.enemyCount);
+}
+
+int EvolutionPlanner::tournament() {
+  int winner = static_cast<int>(random.below(POPULATION));
+  for (int i = 1; i < TOURNAMENT; ++i) {
+    int challenger = static_cast<int>(random.below(POPULATION));
+    if (population[challenger].value > population[winner].value)
+      winner = challenger;
+  }
+  return winner;
+}
+
+void EvolutionPlanner::evaluate(Genome &genome) {
+  ++rolloutCount;
+  scratch = root;
+  for (int i = 0; i < HORIZON && !scratch.isOver(); ++i)
+    simulate(scratch, genome.genes[i].decode(scratch));
+  genome.value = fuzzyTelegram::evaluate(scratch);
+}
+
+void EvolutionPlanner::rank() {
+  best = 0;
+  worst = 0;
+  for (int i = 1; i < POPULATION; ++i) {
+    if (population[i].value > population[best].value)
+      best = i;
+    if (population[i].value < population[worst].value)
+      worst = i;
+  }
+}
+}
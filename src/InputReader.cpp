@@ -0,0 +1,102 @@
+#include "InputReader.hpp"
+#include <cerrno>
+#include <unistd.h>
+
+namespace fuzzyTelegram {
+
+InputReader::InputReader(int fdValue)
+    : fd(fdValue), position(0), end(0), ended(false) {}
+
+bool InputReader::refill() {
+  if (ended)
+    return false;
+  ssize_t count;
+  do {
+    count = read(fd, buffer, BUFFER_SIZE);
+  } while (count < 0 && errno == EINTR);
+  if (count <= 0) {
+    ended = true;
+    return false;
+  }
+  position = 0;
+  end = static_cast<std::size_t>(count);
+  return true;
+}
+
+bool InputReader::waitInput() {
+  for (;;) {
+    if (position == end && !refill())
+      return false;
+    char c = buffer[position];
+    if (c == '-' || (c >= '0' && c <= '9'))
+      return true;
+    ++position;
+  }
+}
+
+bool InputReader::readInt(int &value) {
+  if (!waitInput())
+    return false;
+  bool negative = buffer[position] == '-';
+  if (negative)
+    ++position;
+  int result = 0;
+  for (;;) {
+    if (position == end && !refill())
+      break;
+    unsigned digit = static_cast<unsigned>(buffer[position] - '0');
+    if (digit > 9)
+      break;
+    result = result * 10 + static_cast<int>(digit);
+    ++position;
+  }
+  value = negative ? -result : result;
+  return true;
+}
+
+template <typename T> bool InputReader::readVector2(Vector2<T> &v) {
+  int x;
+  int y;
+  if (!readInt(x) || !readInt(y))
+    return false;
+  v.set(x, y);
+  return true;
+}
+
+bool InputReader::readTurn(GameState &state) {
+  int initialTotalLife = state.initialTotalLife;
+  int shots = state.shots;
+  int kills = state.kills;
+  state.clear();
+  state.initialTotalLife = initialTotalLife;
+  state.shots = shots;
+  state.kills = kills;
+
+  if (!readVector2(state.wolff))
+    return false;
+  int dataCount;
+  if (!readInt(dataCount) || dataCount < 0 || dataCount > MAX_DATA_POINTS)
+    return false;
+  for (int i = 0; i < dataCount; i++) {
+    int id;
+    Vector2f position;
+    if (!readInt(id) || !readVector2(position))
+      return false;
+    state.addDataPoint(id, position);
+  }
+  int enemyCount;
+  if (!readInt(enemyCount) || enemyCount < 0 || enemyCount > MAX_ENEMIES)
+    return false;
+  for (int i = 0; i < enemyCount; i++) {
+    int id;
+    Vector2f position;
+    int life;
+    if (!readInt(id) || !readVector2(position) || !readInt(life))
+      return false;
+    state.addEnemy(id, position, life);
+  }
+  return true;
+}
+
+bool InputReader::eof() const { return ended; }
+}
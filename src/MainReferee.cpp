@@ -0,0 +1,147 @@
+#include "Vector2.hpp"
+#include "Vector2Batch.cpp"
+#include "SpatialGrid.cpp"
+#include "AliveMask.cpp"
+#include "Damage.cpp"
+#include "Simulator.cpp"
+#include "Random.cpp"
+#include "TurnClock.cpp"
+#include "ReplayLog.cpp"
+#include "Referee.cpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace fuzzyTelegram;
+
+static void usage(const char *name) {
+  std::fprintf(stderr,
+               "usage: %s [-n games] [-j threads] [-s seed] [-b command] "
+               "[-d scale] [-r dir] [-v] [-e]\n"
+               "  -n games    number of games to play (100)\n"
+               "  -j threads  games played at once (one per core)\n"
+               "  -s seed     seed of the first map, the others follow (1)\n"
+               "  -b command  command starting the bot (./bin/bot)\n"
+               "  -d scale    multiply the 1000/100 ms deadlines (1)\n"
+               "  -r dir      log the turns of every game in dir\n"
+               "  -v          print a line per game\n"
+               "  -e          keep the stderr of the bots\n"
+               "The rules are played apart from the simulation of the bot,\n"
+               "which prints where they diverge on its stderr (-e).\n",
+               name);
+}
+
+/*!
+* \brief Return the value below which a fraction of the sorted values are.
+*/
+static double percentile(const std::vector<double> &sorted, double fraction) {
+  if (sorted.empty())
+    return 0;
+  std::size_t i = static_cast<std::size_t>(fraction * (sorted.size() - 1));
+  return sorted[i];
+}
+
+/**
+ * Play games of a bot on random maps, in parallel, with the deadlines of the
+ * game, and print the scores and response times.
+ **/
+int main(int argc, char **argv) {
+  RefereeConfig config;
+  int games = 100;
+  int threads = static_cast<int>(std::thread::hardware_concurrency());
+  unsigned seed = 1;
+  double scale = 1;
+  bool verbose = false;
+  int option;
+  while ((option = getopt(argc, argv, "n:j:s:b:d:r:veh")) != -1) {
+    switch (option) {
+    case 'n':
+      games = std::atoi(optarg);
+      break;
+    case 'j':
+      threads = std::atoi(optarg);
+      break;
+    case 's':
+      seed = static_cast<unsigned>(std::strtoul(optarg, nullptr, 10));
+      break;
+    case 'b':
+      config.command = optarg;
+      break;
+    case 'd':
+      scale = std::atof(optarg);
+      break;
+    case 'r':
+      config.replayDirectory = optarg;
+      break;
+    case 'v':
+      verbose = true;
+      break;
+    case 'e':
+      config.showBotErrors = true;
+      break;
+    default:
+      usage(argv[0]);
+      return option == 'h' ? 0 : 2;
+    }
+  }
+  if (games < 1 || scale <= 0) {
+    usage(argv[0]);
+    return 2;
+  }
+  config.firstTurnBudgetMs *= scale;
+  config.turnBudgetMs *= scale;
+  threads = std::max(threads, 1);
+
+  std::vector<unsigned> seeds;
+  for (int i = 0; i < games; ++i)
+    seeds.push_back(seed + i);
+  std::vector<GameResult> results = playGames(seeds, threads, config);
+
+  int outcomes[GameResult::TURN_LIMIT + 1] = {};
+  long totalScore = 0;
+  std::vector<double> firstTurns;
+  std::vector<double> turns;
+  for (const GameResult &result : results) {
+    ++outcomes[result.outcome];
+    totalScore += result.score;
+    for (std::size_t t = 0; t < result.latenciesMs.size(); ++t)
+      (t == 0 ? firstTurns : turns).push_back(result.latenciesMs[t]);
+    if (verbose) {
+      double worst = 0;
+      for (std::size_t t = 1; t < result.latenciesMs.size(); ++t)
+        worst = std::max(worst, result.latenciesMs[t]);
+      std::printf("seed %u %s score %d turns %d shots %d kills %d data %d "
+                  "first %.1f ms worst %.1f ms",
+                  result.seed, outcomeName(result.outcome), result.score,
+                  result.turns, result.shots, result.kills,
+                  result.dataRemaining,
+                  result.latenciesMs.empty() ? 0 : result.latenciesMs[0],
+                  worst);
+      if (result.outcome == GameResult::INVALID)
+        std::printf(" output \"%s\"", result.invalidOutput.c_str());
+      std::printf("\n");
+    }
+  }
+  std::sort(firstTurns.begin(), firstTurns.end());
+  std::sort(turns.begin(), turns.end());
+
+  std::printf("games %d threads %d mean score %.1f\n", games, threads,
+              static_cast<double>(totalScore) / games);
+  for (int o = 0; o <= GameResult::TURN_LIMIT; ++o)
+    if (outcomes[o] > 0)
+      std::printf("  %-10s %d\n",
+                  outcomeName(static_cast<GameResult::Outcome>(o)),
+                  outcomes[o]);
+  std::printf("first turn ms p50 %.2f p99 %.2f max %.2f\n",
+              percentile(firstTurns, 0.5), percentile(firstTurns, 0.99),
+              firstTurns.empty() ? 0 : firstTurns.back());
+  std::printf("turn ms p50 %.2f p99 %.2f max %.2f over %zu turns\n",
+              percentile(turns, 0.5), percentile(turns, 0.99),
+              turns.empty() ? 0 : turns.back(), turns.size());
+  int failures = outcomes[GameResult::TIMEOUT] +
+                 outcomes[GameResult::INVALID] + outcomes[GameResult::CRASHED];
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+#include "Vector2.hpp"
+#include "Vector2Batch.cpp"
+#include "SpatialGrid.cpp"
+#include "AliveMask.cpp"
+#include "Damage.cpp"
+#include "Simulator.cpp"
+#include "TurnClock.cpp"
+#include "ReplayLog.cpp"
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace fuzzyTelegram;
+
+static void usage(const char *name) {
+  std::fprintf(stderr,
+               "usage: %s [-t ms] file...\n"
+               "  -t ms  print the turns slower than ms (the budget of the "
+               "turn)\n",
+               name);
+}
+
+/**
+ * Read replay files and print the turns that took too long, with what they
+ * were given, then the totals.
+ **/
+int main(int argc, char **argv) {
+  double threshold = 0;
+  int option;
+  while ((option = getopt(argc, argv, "t:h")) != -1) {
+    switch (option) {
+    case 't':
+      threshold = std::atof(optarg);
+      break;
+    default:
+      usage(argv[0]);
+      return option == 'h' ? 0 : 2;
+    }
+  }
+  if (optind == argc) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  TurnClock clock;
+  clock.startTurn();
+  long turns = 0;
+  long slow = 0;
+  long missed = 0;
+  double slowest = 0;
+  ReplayReader reader;
+  ReplayTurnView view;
+  for (int f = optind; f < argc; ++f) {
+    if (!reader.open(argv[f])) {
+      std::fprintf(stderr, "%s: not a replay file of version %u\n", argv[f],
+                   REPLAY_VERSION);
+      continue;
+    }
+    while (reader.next(view)) {
+      const ReplayTurn &turn = *view.turn;
+      ++turns;
+      if (turn.actionType == REPLAY_NO_ACTION)
+        ++missed;
+      if (turn.elapsedMs > slowest)
+        slowest = turn.elapsedMs;
+      double limit = threshold > 0 ? threshold
+                                   : turn.turn == 0
+                                         ? TurnClock::FIRST_TURN_BUDGET_MS
+                                         : TurnClock::TURN_BUDGET_MS;
+      if (turn.elapsedMs <= limit)
+        continue;
+      ++slow;
+      std::printf("%s turn %d %.2f ms data %d enemies %d rollouts %u%s\n",
+                  argv[f], turn.turn, turn.elapsedMs, turn.dataCount,
+                  turn.enemyCount, turn.rollouts,
+                  turn.actionType == REPLAY_NO_ACTION ? " no action" : "");
+    }
+  }
+  std::printf("turns %ld slow %ld without action %ld slowest %.2f ms, read "
+              "in %.1f ms\n",
+              turns, slow, missed, slowest, clock.elapsedMs());
+  return 0;
+}
@@ -0,0 +1,245 @@
+#include "MctsPlanner.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace fuzzyTelegram {
+
+constexpr float MctsPlanner::WIDENING;
+constexpr float MctsPlanner::EXPLORATION;
+
+MctsPlanner::MctsPlanner(Arena &arena, unsigned seed)
+    : arena(arena), pool(arena), valueScale(1), playoutCount(0), maxDepth(0),
+      hasTree(false), random(seed) {}
+
+void MctsPlanner::reset(const GameState &newRoot, const Action &played) {
+  if (arena.capacity() == 0)
+    arena.reserve(ARENA_BYTES);
+
+  // Shots are stored by slot : the tree is only valid if no entity left.
+  Index kept = NodePool<MctsNode>::NONE;
+  if (hasTree && newRoot.enemyCount == root.enemyCount &&
+      newRoot.dataCount == root.dataCount)
+    kept = findChild(0, played);
+  if (kept == NodePool<MctsNode>::NONE || pool.keepSubtree(kept) == 0) {
+    pool.clear();
+    createNode(Action());
+    // The same candidates at the root in every planner, see ParallelPlanner.
+    pool[0].rotation = 0;
+  }
+  hasTree = true;
+  root = newRoot;
+  updateTargets(root);
+  pool[0].action = Action();
+  playoutCount = 0;
+  maxDepth = 0;
+  valueScale =
+      std::max(1.0f, static_cast<float>(root.dataRemaining) *
+                         (100 + 3 * std::max(0, root.initialTotalLife -
+                                                    3 * root.shots)) +
+                         10.0f * root.enemyCount);
+}
+
+void MctsPlanner::reset(const GameState &newRoot) {
+  reset(newRoot, bestAction());
+}
+
+void MctsPlanner::iterate() {
+  Index path[MAX_DEPTH + 1];
+  int length = 0;
+  Index node = 0;
+  path[length++] = node;
+  scratch = root;
+
+  // Selection, down to a node that can still be widened.
+  while (!scratch.isOver() && length <= MAX_DEPTH) {
+    const MctsNode &current = pool[node];
+    float visits = static_cast<float>(current.visits);
+    int allowed = 1 + static_cast<int>(WIDENING * std::sqrt(visits));
+    if (current.expanded < allowed &&
+        current.expanded < candidateCount(scratch)) {
+      Index child = expand(node, scratch);
+      if (child != NodePool<MctsNode>::NONE) {
+        simulate(scratch, pool[child].action);
+        path[length++] = child;
+        break;
+      }
+    }
+    Index next = select(node);
+    if (next == NodePool<MctsNode>::NONE)
+      break;
+    simulate(scratch, pool[next].action);
+    path[length++] = next;
+    node = next;
+  }
+  maxDepth = std::max(maxDepth, length - 1);
+
+  // Playout.
+  for (int i = 0; i < PLAYOUT_DEPTH && !scratch.isOver(); ++i)
+    simulate(scratch, randomAction(scratch));
+  ++playoutCount;
+  float value = evaluate(scratch) / valueScale;
+
+  for (int i = 0; i < length; ++i) {
+    ++pool[path[i]].visits;
+    pool[path[i]].valueSum += value;
+  }
+}
+
+Action MctsPlanner::bestAction() const {
+  Index best = mostVisited(0);
+  return best == NodePool<MctsNode>::NONE ? Action::move(root.wolff)
+                                          : pool[best].action;
+}
+
+float MctsPlanner::bestValue() const {
+  Index best = mostVisited(0);
+  if (best == NodePool<MctsNode>::NONE)
+    return 0;
+  return pool[best].valueSum / pool[best].visits * valueScale;
+}
+
+unsigned long MctsPlanner::rollouts() const { return playoutCount; }
+
+int MctsPlanner::rootStatistics(ActionStatistics *out, int capacity) const {
+  int count = 0;
+  if (pool.size() == 0)
+    return count;
+  for (Index child = pool[0].firstChild;
+       child != NodePool<MctsNode>::NONE && count < capacity;
+       child = pool[child].nextSibling, ++count) {
+    out[count].action = pool[child].action;
+    out[count].valueSum = pool[child].valueSum * valueScale;
+    out[count].visits = pool[child].visits;
+  }
+  return count;
+}
+
+int MctsPlanner::depth() const { return maxDepth; }
+
+int MctsPlanner::nodes() const { return pool.size(); }
+
+MctsPlanner::Index MctsPlanner::findChild(Index node,
+                                          const Action &action) const {
+  if (node >= pool.size())
+    return NodePool<MctsNode>::NONE;
+  Index child = pool[node].firstChild;
+  while (child != NodePool<MctsNode>::NONE && !(pool[child].action == action))
+    child = pool[child].nextSibling;
+  return child;
+}
+
+MctsPlanner::Index MctsPlanner::mostVisited(Index node) const {
+  Index best = NodePool<MctsNode>::NONE;
+  if (node >= pool.size())
+    return best;
+  for (Index child = pool[node].firstChild; child != NodePool<MctsNode>::NONE;
+       child = pool[child].nextSibling)
+    if (best == NodePool<MctsNode>::NONE ||
+        pool[child].visits > pool[best].visits)
+      best = child;
+  return best;
+}
+
+MctsPlanner::Index MctsPlanner::select(Index node) const {
+  float logVisits = std::log(static_cast<float>(pool[node].visits));
+  Index best = NodePool<MctsNode>::NONE;
+  float bestScore = 0;
+  for (Index child = pool[node].firstChild; child != NodePool<MctsNode>::NONE;
+       child = pool[child].nextSibling) {
+    const MctsNode &n = pool[child];
+    float score = n.valueSum / n.visits +
+                  EXPLORATION * std::sqrt(logVisits / n.visits);
+    if (best == NodePool<MctsNode>::NONE || score > bestScore) {
+      best = child;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+MctsPlanner::Index MctsPlanner::expand(Index node, const GameState &state) {
+  Action action = candidate(state, pool[node].expanded, pool[node].rotation);
+  Index child = createNode(action);
+  if (child == NodePool<MctsNode>::NONE)
+    return child;
+  // Children are added in front, the order does not matter to UCB1.
+  MctsNode &parent = pool[node];
+  ++parent.expanded;
+  pool[child].nextSibling = parent.firstChild;
+  parent.firstChild = child;
+  return child;
+}
+
+int MctsPlanner::candidateCount(const GameState &state) {
+  return state.enemiesRemaining + MAX_MOVES;
+}
+
+Action MctsPlanner::candidate(const GameState &state, int index,
+                              float rotation) {
+  // SHOOT and MOVE alternate while there are enemies left to shoot.
+  int shots = state.enemiesRemaining;
+  int move = index;
+  if (index < 2 * shots) {
+    if (index % 2 == 0) {
+      int enemy = static_cast<int>(state.enemyAlive.next(0));
+      for (int i = 0; i < index / 2; ++i)
+        enemy = static_cast<int>(state.enemyAlive.next(enemy + 1));
+      return Action::shoot(enemy);
+    }
+    move = index / 2;
+  } else {
+    move = index - shots;
+  }
+
+  if (move < 2 && shots > 0) {
+    Vector2f threat =
+        state.enemyPositions[state.enemyPositions.nearest(state.wolff)];
+    Vector2f away = state.wolff - threat;
+    if (away.squaredMagnitude() > 0) {
+      away.normalize();
+      return Action::move(state.wolff +
+                          (move == 0 ? away : -away) * WOLFF_STEP);
+    }
+  }
+  // The compass follows the moves away and towards, once each direction.
+  int compassFirst = shots > 0 ? 2 : 0;
+  if (move >= compassFirst && move < compassFirst + 8) {
+    static const Vector2f compass[8] = {
+        Vector2f::up(),         Vector2f(0.70710678f, 0.70710678f),
+        Vector2f::right(),      Vector2f(0.70710678f, -0.70710678f),
+        Vector2f::down(),       Vector2f(-0.70710678f, -0.70710678f),
+        Vector2f::left(),       Vector2f(-0.70710678f, 0.70710678f)};
+    const Vector2f &d = compass[move - compassFirst];
+    float c = std::cos(rotation);
+    float s = std::sin(rotation);
+    return Action::move(state.wolff +
+                        Vector2f(d.x * c - d.y * s, d.x * s + d.y * c) *
+                            WOLFF_STEP);
+  }
+  return Action::move(state.wolff + random.inDisc(WOLFF_STEP));
+}
+
+Action MctsPlanner::randomAction(const GameState &state) {
+  if (state.enemiesRemaining > 0 && random.coin()) {
+    int enemy = static_cast<int>(
+        state.enemyAlive.next(random.below(state.enemyCount)));
+    if (enemy >= state.enemyCount)
+      enemy = static_cast<int>(state.enemyAlive.next(0));
+    return Action::shoot(enemy);
+  }
+  return Action::move(state.wolff + random.inDisc(WOLFF_STEP));
+}
+
+MctsPlanner::Index MctsPlanner::createNode(const Action &action) {
+  Index index = pool.create();
+  if (index == NodePool<MctsNode>::NONE)
+    return index;
+  MctsNode &node = pool[index];
+  node.action = action;
+  node.rotation = random.unit() * static_cast<float>(M_PI) / 4;
+  node.valueSum = 0;
+  node.visits = 0;
+  node.expanded = 0;
+  return index;
+}
+}
@@ -0,0 +1,189 @@
+#include "ParallelPlanner.hpp"
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+
+namespace fuzzyTelegram {
+
+template <typename Planner> const int ParallelPlanner<Planner>::MAX_THREADS;
+template <typename Planner> const int ParallelPlanner<Planner>::MAX_ACTIONS;
+
+/*!
+* \brief What a thread owns : its arena, used by planners that take one, its
+* planner, and the thread itself except for the first planner.
+*/
+template <typename Planner> struct ParallelPlanner<Planner>::Worker {
+  Arena arena;
+  Planner planner;
+  std::thread thread;
+  unsigned long iterations;
+
+  explicit Worker(unsigned seed)
+      : planner(make(arena, seed)), iterations(0) {}
+
+  template <typename P = Planner>
+  static typename std::enable_if<std::is_constructible<P, Arena &>::value,
+                                 P>::type
+  make(Arena &arena, unsigned seed) {
+    return P(arena, seed);
+  }
+
+  template <typename P = Planner>
+  static typename std::enable_if<!std::is_constructible<P, Arena &>::value,
+                                 P>::type
+  make(Arena &, unsigned seed) {
+    return P(seed);
+  }
+};
+
+template <typename Planner>
+ParallelPlanner<Planner>::ParallelPlanner(int threads, unsigned seed)
+    : count(std::min(std::max(threads, 1), MAX_THREADS)), task(STOP),
+      generation(0), pending(0), taskRoot(nullptr), taskPlayed(nullptr),
+      taskClock(nullptr), taskConfig(nullptr) {
+  for (int i = 0; i < count; ++i)
+    workers[i] = new Worker(seed + i);
+  for (int i = 1; i < count; ++i)
+    workers[i]->thread = std::thread(&ParallelPlanner::work, this, i);
+  best.action = Action();
+  best.valueSum = 0;
+  best.visits = 0;
+}
+
+template <typename Planner> ParallelPlanner<Planner>::~ParallelPlanner() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    task = STOP;
+    ++generation;
+  }
+  wake.notify_all();
+  for (int i = 1; i < count; ++i)
+    workers[i]->thread.join();
+  for (int i = 0; i < count; ++i)
+    delete workers[i];
+}
+
+template <typename Planner> int ParallelPlanner<Planner>::threads() const {
+  return count;
+}
+
+template <typename Planner>
+void ParallelPlanner<Planner>::reset(const GameState &root,
+                                     const Action &played) {
+  // Planners that reserve their arena do it here, on the first turn.
+  taskRoot = &root;
+  taskPlayed = &played;
+  dispatch(RESET);
+  merge();
+}
+
+template <typename Planner>
+void ParallelPlanner<Planner>::reset(const GameState &root) {
+  // A copy, merge replaces best.
+  Action played = best.action;
+  reset(root, played);
+}
+
+template <typename Planner>
+unsigned long ParallelPlanner<Planner>::run(const TurnClock &clock,
+                                            const AnytimeConfig &config) {
+  taskClock = &clock;
+  taskConfig = &config;
+  dispatch(RUN);
+  merge();
+  unsigned long total = 0;
+  for (int i = 0; i < count; ++i)
+    total += workers[i]->iterations;
+  return total;
+}
+
+template <typename Planner>
+Action ParallelPlanner<Planner>::bestAction() const {
+  return best.action;
+}
+
+template <typename Planner> float ParallelPlanner<Planner>::bestValue() const {
+  return best.visits > 0 ? best.valueSum / best.visits : 0;
+}
+
+template <typename Planner>
+unsigned long ParallelPlanner<Planner>::rollouts() const {
+  unsigned long total = 0;
+  for (int i = 0; i < count; ++i)
+    total += workers[i]->planner.rollouts();
+  return total;
+}
+
+template <typename Planner>
+void ParallelPlanner<Planner>::dispatch(Task newTask) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    task = newTask;
+    ++generation;
+    pending = count - 1;
+  }
+  wake.notify_all();
+  perform(0);
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this] { return pending == 0; });
+}
+
+template <typename Planner> void ParallelPlanner<Planner>::perform(int i) {
+  Worker &worker = *workers[i];
+  if (task == RESET)
+    worker.planner.reset(*taskRoot, *taskPlayed);
+  else if (task == RUN)
+    worker.iterations = runAnytime(worker.planner, *taskClock, *taskConfig);
+}
+
+template <typename Planner> void ParallelPlanner<Planner>::work(int i) {
+  unsigned seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this, seen] { return generation != seen; });
+      seen = generation;
+      if (task == STOP)
+        return;
+    }
+    perform(i);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--pending == 0)
+      finished.notify_one();
+  }
+}
+
+template <typename Planner> void ParallelPlanner<Planner>::merge() {
+  ActionStatistics merged[MAX_ACTIONS];
+  ActionStatistics actions[MAX_ACTIONS];
+  int mergedCount = 0;
+  for (int i = 0; i < count; ++i) {
+    int n = workers[i]->planner.rootStatistics(actions, MAX_ACTIONS);
+    for (int a = 0; a < n; ++a) {
+      int j = 0;
+      while (j < mergedCount && !(merged[j].action == actions[a].action))
+        ++j;
+      if (j == mergedCount) {
+        if (mergedCount == MAX_ACTIONS)
+          continue;
+        merged[mergedCount] = actions[a];
+        merged[mergedCount].valueSum = 0;
+        merged[mergedCount].visits = 0;
+        ++mergedCount;
+      }
+      merged[j].valueSum += actions[a].valueSum;
+      merged[j].visits += actions[a].visits;
+    }
+  }
+  if (mergedCount == 0)
+    return;
+  best = merged[0];
+  for (int j = 1; j < mergedCount; ++j) {
+    const ActionStatistics &s = merged[j];
+    if (s.visits > best.visits ||
+        (s.visits == best.visits &&
+         s.valueSum / s.visits > best.valueSum / best.visits))
+      best = s;
+  }
+}
+}
@@ -0,0 +1,90 @@
+#include "PhaseTrace.hpp"
+#include <cstdio>
+
+#ifdef FUZZY_TRACE
+
+namespace fuzzyTelegram {
+
+const int PhaseTrace::CAPACITY;
+
+const char *phaseName(Phase phase) {
+  switch (phase) {
+  case PHASE_PARSE:
+    return "parse";
+  case PHASE_RESET:
+    return "reset";
+  case PHASE_SEARCH:
+    return "search";
+  case PHASE_OUTPUT:
+    return "output";
+  case PHASE_COUNT:
+    break;
+  }
+  return "unknown";
+}
+
+PhaseTrace::PhaseTrace(void) : count(0), turns(0), turnTicks() {}
+
+void PhaseTrace::record(Phase phase, std::uint64_t start, std::uint64_t end) {
+  Event &event = events[count++ % CAPACITY];
+  event.phase = phase;
+  event.turn = turns;
+  event.start = start;
+  event.end = end;
+  turnTicks[phase] += end - start;
+}
+
+double PhaseTrace::turnMs(Phase phase) const {
+  return turnTicks[phase] / TurnClock::ticksPerMs();
+}
+
+void PhaseTrace::endTurn(std::ostream &out) {
+  char line[128];
+  int length = std::snprintf(line, sizeof line, "turn %d", turns);
+  for (int p = 0; p < PHASE_COUNT; ++p) {
+    Phase phase = static_cast<Phase>(p);
+    length += std::snprintf(line + length, sizeof line - length, " %s %.3f",
+                            phaseName(phase), turnMs(phase));
+    turnTicks[p] = 0;
+  }
+  out << line << " ms" << std::endl;
+  ++turns;
+}
+
+int PhaseTrace::size() const {
+  return static_cast<int>(count < CAPACITY ? count : CAPACITY);
+}
+
+const PhaseTrace::Event &PhaseTrace::event(int i) const {
+  long first = count < CAPACITY ? 0 : count - CAPACITY;
+  return events[(first + i) % CAPACITY];
+}
+
+bool PhaseTrace::writeChromeTrace(const char *path) const {
+  std::FILE *file = std::fopen(path, "w");
+  if (!file)
+    return false;
+  // Times are in microseconds from the first event kept.
+  const double ticksPerUs = TurnClock::ticksPerMs() / 1000;
+  std::uint64_t origin = size() > 0 ? event(0).start : 0;
+  std::fprintf(file, "{\"traceEvents\":[");
+  for (int i = 0; i < size(); ++i) {
+    const Event &e = event(i);
+    std::fprintf(file,
+                 "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+                 "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"turn\":%d}}",
+                 i > 0 ? "," : "", phaseName(e.phase),
+                 (e.start - origin) / ticksPerUs,
+                 (e.end - e.start) / ticksPerUs, e.turn);
+  }
+  std::fprintf(file, "\n]}\n");
+  return std::fclose(file) == 0;
+}
+
+ScopedPhase::ScopedPhase(PhaseTrace &traceValue, Phase phaseValue)
+    : trace(traceValue), phase(phaseValue), start(TurnClock::now()) {}
+
+ScopedPhase::~ScopedPhase() { trace.record(phase, start, TurnClock::now()); }
+}
+
+#endif
@@ -0,0 +1,61 @@
+#include "Random.hpp"
+#include <cmath>
+
+namespace fuzzyTelegram {
+
+std::uint64_t splitMix64(std::uint64_t &state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+FastRandom::FastRandom(std::uint64_t value) { seed(value); }
+
+void FastRandom::seed(std::uint64_t value) {
+  std::uint64_t state = value;
+  std::uint64_t a = splitMix64(state);
+  std::uint64_t b = splitMix64(state);
+  s[0] = static_cast<std::uint32_t>(a);
+  s[1] = static_cast<std::uint32_t>(a >> 32);
+  s[2] = static_cast<std::uint32_t>(b);
+  s[3] = static_cast<std::uint32_t>(b >> 32);
+}
+
+std::uint32_t FastRandom::operator()() {
+  const std::uint32_t result = rotateLeft(s[1] * 5, 7) * 9;
+  const std::uint32_t t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotateLeft(s[3], 11);
+  return result;
+}
+
+std::uint32_t FastRandom::below(std::uint32_t bound) {
+  return static_cast<std::uint32_t>(
+      (static_cast<std::uint64_t>((*this)()) * bound) >> 32);
+}
+
+int FastRandom::range(int low, int high) {
+  return low + static_cast<int>(
+                   below(static_cast<std::uint32_t>(high - low) + 1));
+}
+
+float FastRandom::unit() { return unitFloat((*this)()); }
+
+bool FastRandom::coin() { return (*this)() >> 31; }
+
+Vector2f FastRandom::direction() {
+  float angle = unit() * 2 * static_cast<float>(M_PI);
+  return Vector2f(std::cos(angle), std::sin(angle));
+}
+
+Vector2f FastRandom::inDisc(float radius) {
+  // The square root spreads the points evenly over the area.
+  float length = std::sqrt(unit()) * radius;
+  return direction() * length;
+}
+}
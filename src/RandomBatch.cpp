@@ -0,0 +1,88 @@
+#include "RandomBatch.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace fuzzyTelegram {
+
+template <std::size_t Lanes>
+FastRandomBatch<Lanes>::FastRandomBatch(std::uint64_t value) {
+  seed(value);
+}
+
+template <std::size_t Lanes>
+void FastRandomBatch<Lanes>::seed(std::uint64_t value) {
+  std::uint64_t state = value;
+  for (std::size_t l = 0; l < Lanes; ++l) {
+    std::uint64_t a = splitMix64(state);
+    std::uint64_t b = splitMix64(state);
+    s0[l] = static_cast<std::uint32_t>(a);
+    s1[l] = static_cast<std::uint32_t>(a >> 32);
+    s2[l] = static_cast<std::uint32_t>(b);
+    s3[l] = static_cast<std::uint32_t>(b >> 32);
+  }
+}
+
+template <std::size_t Lanes>
+void FastRandomBatch<Lanes>::step(std::uint32_t *out) {
+  // The results go to a local array first : written straight to out, which
+  // may alias the states for the compiler, the loop is not vectorized.
+  std::uint32_t result[Lanes];
+  for (std::size_t l = 0; l < Lanes; ++l) {
+    result[l] = rotateLeft(s1[l] * 5, 7) * 9;
+    const std::uint32_t t = s1[l] << 9;
+    s2[l] ^= s0[l];
+    s3[l] ^= s1[l];
+    s1[l] ^= s2[l];
+    s0[l] ^= s3[l];
+    s2[l] ^= t;
+    s3[l] = rotateLeft(s3[l], 11);
+  }
+  std::copy(result, result + Lanes, out);
+}
+
+template <std::size_t Lanes>
+void FastRandomBatch<Lanes>::fill(std::uint32_t *out, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + Lanes <= n; i += Lanes)
+    step(out + i);
+  if (i < n) {
+    std::uint32_t rest[Lanes];
+    step(rest);
+    for (std::size_t k = 0; k < Lanes && i < n; ++i, ++k)
+      out[i] = rest[k];
+  }
+}
+
+template <std::size_t Lanes>
+void FastRandomBatch<Lanes>::fillBelow(std::uint32_t *out, std::size_t n,
+                                       std::uint32_t bound) {
+  fill(out, n);
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = static_cast<std::uint32_t>(
+        (static_cast<std::uint64_t>(out[i]) * bound) >> 32);
+}
+
+template <std::size_t Lanes>
+void FastRandomBatch<Lanes>::fillUnit(float *out, std::size_t n) {
+  std::uint32_t bits[8 * Lanes];
+  for (std::size_t i = 0; i < n; i += 8 * Lanes) {
+    std::size_t count = std::min(8 * Lanes, n - i);
+    fill(bits, count);
+    for (std::size_t j = 0; j < count; ++j)
+      out[i + j] = unitFloat(bits[j]);
+  }
+}
+
+template <std::size_t Lanes>
+void FastRandomBatch<Lanes>::fillInDisc(float *xs, float *ys, std::size_t n,
+                                        const Vector2f &center, float radius) {
+  fillUnit(xs, n);
+  fillUnit(ys, n);
+  for (std::size_t i = 0; i < n; ++i) {
+    float angle = xs[i] * 2 * static_cast<float>(M_PI);
+    float length = std::sqrt(ys[i]) * radius;
+    xs[i] = center.x + std::cos(angle) * length;
+    ys[i] = center.y + std::sin(angle) * length;
+  }
+}
+}
@@ -0,0 +1,417 @@
+#include "Referee.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace fuzzyTelegram {
+
+MapConfig::MapConfig(void)
+    : minDataPoints(1), maxDataPoints(15), minEnemies(1), maxEnemies(30),
+      minLife(5), maxLife(30) {}
+
+RefereeConfig::RefereeConfig(void)
+    : command("./bin/bot"),
+      firstTurnBudgetMs(TurnClock::FIRST_TURN_BUDGET_MS),
+      turnBudgetMs(TurnClock::TURN_BUDGET_MS), maxTurns(400),
+      showBotErrors(false) {}
+
+GameResult::GameResult(void)
+    : seed(0), outcome(CRASHED), score(0), turns(0), shots(0), kills(0),
+      dataRemaining(0) {}
+
+const char *outcomeName(GameResult::Outcome outcome) {
+  switch (outcome) {
+  case GameResult::FINISHED:
+    return "finished";
+  case GameResult::DEAD:
+    return "dead";
+  case GameResult::TIMEOUT:
+    return "timeout";
+  case GameResult::INVALID:
+    return "invalid";
+  case GameResult::CRASHED:
+    return "crashed";
+  case GameResult::TURN_LIMIT:
+    return "turn-limit";
+  }
+  return "unknown";
+}
+
+GameState randomMap(FastRandom &random, const MapConfig &config) {
+  const int width = static_cast<int>(MAP_WIDTH);
+  const int height = static_cast<int>(MAP_HEIGHT);
+  GameState state;
+  state.wolff.set(random.range(0, width - 1), random.range(0, height - 1));
+  int data = random.range(config.minDataPoints,
+                          std::min(config.maxDataPoints, MAX_DATA_POINTS));
+  for (int i = 0; i < data; ++i)
+    state.addDataPoint(i, Vector2f(random.range(0, width - 1),
+                                   random.range(0, height - 1)));
+  // An enemy further than this cannot reach Wolff if Wolff stays.
+  const float safe = KILL_RANGE + ENEMY_STEP;
+  int enemies = random.range(config.minEnemies,
+                             std::min(config.maxEnemies, MAX_ENEMIES));
+  for (int i = 0; i < enemies; ++i) {
+    Vector2f position;
+    do {
+      position.set(random.range(0, width - 1), random.range(0, height - 1));
+    } while (Vector2f::squaredDistance(position, state.wolff) <=
+             safe * safe);
+    state.addEnemy(i, position, random.range(config.minLife, config.maxLife));
+    state.initialTotalLife += state.enemyLives[i];
+  }
+  return state;
+}
+
+void writeTurnInput(const GameState &state, std::string &out) {
+  char line[64];
+  out.clear();
+  std::snprintf(line, sizeof line, "%d %d\n%d\n",
+                static_cast<int>(state.wolff.x),
+                static_cast<int>(state.wolff.y), state.dataRemaining);
+  out += line;
+  for (int i = 0; i < state.dataCount; ++i) {
+    if (!state.dataAlive[i])
+      continue;
+    Vector2f position = state.dataPositions[i];
+    std::snprintf(line, sizeof line, "%d %d %d\n", state.dataIds[i],
+                  static_cast<int>(position.x), static_cast<int>(position.y));
+    out += line;
+  }
+  std::snprintf(line, sizeof line, "%d\n", state.enemiesRemaining);
+  out += line;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    Vector2f position = state.enemyPositions[i];
+    std::snprintf(line, sizeof line, "%d %d %d %d\n", state.enemyIds[i],
+                  static_cast<int>(position.x), static_cast<int>(position.y),
+                  state.enemyLives[i]);
+    out += line;
+  }
+}
+
+/*!
+* \brief Read an integer at text, skipping the spaces before it.
+* \return false if there is no integer, or if it is not followed by a space
+* or the end of the line.
+*/
+static bool parseInt(const char *&text, long &value) {
+  char *end;
+  errno = 0;
+  value = std::strtol(text, &end, 10);
+  if (end == text || errno != 0 || (*end != '\0' && *end != ' '))
+    return false;
+  text = end;
+  return true;
+}
+
+bool parseAction(const char *line, const GameState &state, Action &action) {
+  if (std::strncmp(line, "MOVE ", 5) == 0) {
+    const char *text = line + 5;
+    long x;
+    long y;
+    if (!parseInt(text, x) || !parseInt(text, y))
+      return false;
+    action = Action::move(Vector2f(x, y));
+    return true;
+  }
+  if (std::strncmp(line, "SHOOT ", 6) == 0) {
+    const char *text = line + 6;
+    long id;
+    if (!parseInt(text, id))
+      return false;
+    int slot = state.findEnemy(static_cast<int>(id));
+    if (slot == -1)
+      return false;
+    action = Action::shoot(slot);
+    return true;
+  }
+  return false;
+}
+
+/*!
+* \brief Return the squared distance of two whole positions.
+*/
+static double squaredDistance(const Vector2f &a, const Vector2f &b) {
+  double dx = static_cast<double>(a.x) - b.x;
+  double dy = static_cast<double>(a.y) - b.y;
+  return dx * dx + dy * dy;
+}
+
+/*!
+* \brief Move position towards destination by step at most, then drop the
+* fractional part of the coordinates.
+* \return true if destination is reached.
+*/
+static bool moveOnWholeCoordinates(Vector2f &position,
+                                   const Vector2f &destination, double step) {
+  double dx = static_cast<double>(destination.x) - position.x;
+  double dy = static_cast<double>(destination.y) - position.y;
+  double length = std::sqrt(dx * dx + dy * dy);
+  if (length <= step) {
+    position = destination;
+    return true;
+  }
+  position.set(static_cast<float>(std::floor(position.x + dx * step / length)),
+               static_cast<float>(std::floor(position.y + dy * step / length)));
+  return false;
+}
+
+void playTurn(GameState &state, const Action &action) {
+  int targets[MAX_ENEMIES];
+  bool arrived[MAX_ENEMIES];
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    Vector2f position = state.enemyPositions[i];
+    targets[i] = -1;
+    for (int j = 0; j < state.dataCount; ++j)
+      if (state.dataAlive[j] &&
+          (targets[i] == -1 ||
+           squaredDistance(state.dataPositions[j], position) <
+               squaredDistance(state.dataPositions[targets[i]], position)))
+        targets[i] = j;
+    arrived[i] = targets[i] != -1 &&
+                 moveOnWholeCoordinates(
+                     position, state.dataPositions[targets[i]], ENEMY_STEP);
+    state.enemyPositions.set(i, position);
+  }
+
+  if (action.type == Action::MOVE)
+    moveOnWholeCoordinates(state.wolff, clampToMap(action.destination),
+                           WOLFF_STEP);
+  ++state.turn;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (state.enemyAlive[i] &&
+        squaredDistance(state.enemyPositions[i], state.wolff) <=
+            static_cast<double>(KILL_RANGE) * KILL_RANGE) {
+      state.wolffDead = true;
+      state.invalidateTargets();
+      return;
+    }
+  }
+
+  if (action.type == Action::SHOOT) {
+    int target = action.enemy;
+    ++state.shots;
+    state.enemyLives[target] -= shotDamage(static_cast<float>(
+        std::sqrt(squaredDistance(state.enemyPositions[target], state.wolff))));
+    if (state.enemyLives[target] <= 0) {
+      state.removeEnemy(target);
+      ++state.kills;
+    }
+  }
+
+  for (int i = 0; i < state.enemyCount; ++i)
+    if (state.enemyAlive[i] && arrived[i] && state.dataAlive[targets[i]])
+      state.removeDataPoint(targets[i]);
+  state.invalidateTargets();
+}
+
+BotProcess::BotProcess(void) : pid(-1), input(-1), output(-1) {}
+
+BotProcess::~BotProcess() { stop(); }
+
+bool BotProcess::start(const std::string &command, bool showErrors) {
+  stop();
+  std::signal(SIGPIPE, SIG_IGN);
+  // Close on exec, so that bots started by other threads do not keep these
+  // pipes open.
+  int toBot[2];
+  int fromBot[2];
+  if (pipe2(toBot, O_CLOEXEC) != 0)
+    return false;
+  if (pipe2(fromBot, O_CLOEXEC) != 0) {
+    close(toBot[0]);
+    close(toBot[1]);
+    return false;
+  }
+  const char *text = command.c_str();
+  pid = fork();
+  if (pid == 0) {
+    dup2(toBot[0], 0);
+    dup2(fromBot[1], 1);
+    if (!showErrors) {
+      int null = open("/dev/null", O_WRONLY);
+      if (null >= 0)
+        dup2(null, 2);
+    }
+    execl("/bin/sh", "sh", "-c", text, static_cast<char *>(nullptr));
+    _exit(127);
+  }
+  close(toBot[0]);
+  close(fromBot[1]);
+  if (pid < 0) {
+    close(toBot[1]);
+    close(fromBot[0]);
+    return false;
+  }
+  input = toBot[1];
+  output = fromBot[0];
+  pending.clear();
+  return true;
+}
+
+bool BotProcess::send(const std::string &text) {
+  std::size_t sent = 0;
+  while (sent < text.size()) {
+    ssize_t count = write(input, text.data() + sent, text.size() - sent);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count <= 0)
+      return false;
+    sent += static_cast<std::size_t>(count);
+  }
+  return true;
+}
+
+int BotProcess::readLine(std::string &line, std::uint64_t deadline) {
+  const double ticks = TurnClock::ticksPerMs();
+  for (;;) {
+    std::size_t end = pending.find('\n');
+    if (end != std::string::npos) {
+      line.assign(pending, 0, end);
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+      pending.erase(0, end + 1);
+      return 1;
+    }
+    std::uint64_t now = TurnClock::now();
+    if (now >= deadline)
+      return 0;
+    pollfd fd = {output, POLLIN, 0};
+    int timeout = static_cast<int>(std::ceil((deadline - now) / ticks));
+    int ready = poll(&fd, 1, std::max(timeout, 1));
+    if (ready < 0 && errno != EINTR)
+      return -1;
+    if (ready <= 0)
+      continue;
+    char buffer[4096];
+    ssize_t count = read(output, buffer, sizeof buffer);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count <= 0)
+      return -1;
+    pending.append(buffer, static_cast<std::size_t>(count));
+  }
+}
+
+void BotProcess::stop() {
+  if (input >= 0)
+    close(input);
+  if (output >= 0)
+    close(output);
+  input = output = -1;
+  if (pid > 0) {
+    // The bot sees the end of its input : leave it a moment to write its
+    // logs and exit before killing it.
+    int status;
+    bool exited = false;
+    for (int waited = 0; !exited && waited < 200; ++waited) {
+      exited = waitpid(pid, &status, WNOHANG) != 0;
+      if (!exited)
+        usleep(1000);
+    }
+    if (!exited) {
+      kill(pid, SIGKILL);
+      while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+      }
+    }
+  }
+  pid = -1;
+}
+
+GameResult playGame(const GameState &map, const RefereeConfig &config,
+                    const std::string &replayPrefix) {
+  GameResult result;
+  ReplayWriter replay;
+  std::string command = config.command;
+  if (!replayPrefix.empty()) {
+    replay.open((replayPrefix + ".rpl").c_str());
+    command = "export FUZZY_REPLAY='" + replayPrefix + ".bot.rpl'; " + command;
+  }
+  BotProcess bot;
+  if (!bot.start(command, config.showBotErrors))
+    return result;
+
+  GameState state = map;
+  std::string text;
+  std::string line;
+  const double ticks = TurnClock::ticksPerMs();
+  result.outcome = GameResult::TURN_LIMIT;
+  while (!state.isOver() && result.turns < config.maxTurns) {
+    writeTurnInput(state, text);
+    if (!bot.send(text)) {
+      result.outcome = GameResult::CRASHED;
+      break;
+    }
+    double budget =
+        result.turns == 0 ? config.firstTurnBudgetMs : config.turnBudgetMs;
+    std::uint64_t start = TurnClock::now();
+    int read = bot.readLine(
+        line, start + static_cast<std::uint64_t>(budget * ticks));
+    double latency = (TurnClock::now() - start) / ticks;
+    result.latenciesMs.push_back(latency);
+    if (read <= 0) {
+      result.outcome = read == 0 ? GameResult::TIMEOUT : GameResult::CRASHED;
+      replay.write(state, nullptr, 0, 0, latency);
+      break;
+    }
+    Action action;
+    if (!parseAction(line.c_str(), state, action)) {
+      result.outcome = GameResult::INVALID;
+      result.invalidOutput = line;
+      replay.write(state, nullptr, 0, 0, latency);
+      break;
+    }
+    replay.write(state, &action, 0, 0, latency);
+    playTurn(state, action);
+    ++result.turns;
+  }
+  bot.stop();
+  if (state.isOver())
+    result.outcome = state.wolffDead ? GameResult::DEAD : GameResult::FINISHED;
+
+  result.shots = state.shots;
+  result.kills = state.kills;
+  result.dataRemaining = state.dataRemaining;
+  if (result.outcome == GameResult::FINISHED)
+    result.score = score(state);
+  return result;
+}
+
+std::vector<GameResult> playGames(const std::vector<unsigned> &seeds,
+                                  int threads, const RefereeConfig &config,
+                                  const MapConfig &mapConfig) {
+  std::vector<GameResult> results(seeds.size());
+  std::atomic<std::size_t> next(0);
+  auto work = [&] {
+    for (std::size_t i = next++; i < seeds.size(); i = next++) {
+      FastRandom random(seeds[i]);
+      std::string prefix;
+      if (!config.replayDirectory.empty())
+        prefix = config.replayDirectory + "/" + std::to_string(seeds[i]);
+      results[i] = playGame(randomMap(random, mapConfig), config, prefix);
+      results[i].seed = seeds[i];
+    }
+  };
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; ++i)
+    workers.emplace_back(work);
+  work();
+  for (std::thread &worker : workers)
+    worker.join();
+  return results;
+}
+}
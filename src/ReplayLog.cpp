@@ -0,0 +1,221 @@
+#include "ReplayLog.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return the size of a turn with its arrays.
+*/
+static std::size_t replayTurnSize(int dataCount, int enemyCount) {
+  return sizeof(ReplayTurn) + dataCount * (sizeof(Vector2i) + 4) +
+         enemyCount * (sizeof(Vector2i) + 8);
+}
+
+void ReplayTurnView::toState(GameState &state) const {
+  int initialTotalLife = state.initialTotalLife;
+  int shots = state.shots;
+  int kills = state.kills;
+  state.clear();
+  state.initialTotalLife = initialTotalLife;
+  state.shots = shots;
+  state.kills = kills;
+
+  state.wolff = Vector2f(turn->wolff);
+  for (int i = 0; i < turn->dataCount; ++i)
+    state.addDataPoint(dataIds[i], Vector2f(dataPositions[i]));
+  for (int i = 0; i < turn->enemyCount; ++i)
+    state.addEnemy(enemyIds[i], Vector2f(enemyPositions[i]), enemyLives[i]);
+}
+
+bool ReplayTurnView::toAction(const GameState &state, Action &action) const {
+  if (turn->actionType == Action::MOVE) {
+    action = Action::move(Vector2f(turn->destination));
+    return true;
+  }
+  if (turn->actionType == Action::SHOOT) {
+    action = Action::shoot(state.findEnemy(turn->target));
+    return true;
+  }
+  return false;
+}
+
+ReplayWriter::ReplayWriter(void) : fd(-1), turns(0), used(0) {}
+
+ReplayWriter::~ReplayWriter() { close(); }
+
+bool ReplayWriter::open(const char *path) {
+  close();
+  fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0)
+    return false;
+  ReplayHeader header;
+  std::memcpy(header.magic, "FZRP", 4);
+  header.version = REPLAY_VERSION;
+  header.turnSize = sizeof(ReplayTurn);
+  header.reserved = 0;
+  std::memcpy(buffer, &header, sizeof header);
+  used = sizeof header;
+  turns = 0;
+  return true;
+}
+
+bool ReplayWriter::isOpen() const { return fd >= 0; }
+
+bool ReplayWriter::write(const GameState &state, const Action *action,
+                         unsigned long rollouts, float value,
+                         double elapsedMs) {
+  if (fd < 0)
+    return false;
+  std::size_t size =
+      replayTurnSize(state.dataRemaining, state.enemiesRemaining);
+  if (used + size > BUFFER_SIZE && !flush())
+    return false;
+
+  ReplayTurn turn;
+  turn.size = static_cast<std::uint32_t>(size);
+  // The turn of a parsed state is always 0.
+  turn.turn = turns++;
+  turn.wolff = Vector2i(state.wolff);
+  turn.dataCount = state.dataRemaining;
+  turn.enemyCount = state.enemiesRemaining;
+  turn.actionType = REPLAY_NO_ACTION;
+  turn.target = -1;
+  if (action) {
+    turn.actionType = action->type;
+    if (action->type == Action::SHOOT)
+      turn.target = state.enemyIds[action->enemy];
+    else
+      turn.destination = Vector2i(clampToMap(action->destination));
+  }
+  turn.rollouts = static_cast<std::uint32_t>(rollouts);
+  turn.value = value;
+  turn.elapsedMs = static_cast<float>(elapsedMs);
+
+  char *out = buffer + used;
+  std::memcpy(out, &turn, sizeof turn);
+  Vector2i *dataPositions =
+      reinterpret_cast<Vector2i *>(out + sizeof(ReplayTurn));
+  std::int32_t *dataIds =
+      reinterpret_cast<std::int32_t *>(dataPositions + turn.dataCount);
+  Vector2i *enemyPositions =
+      reinterpret_cast<Vector2i *>(dataIds + turn.dataCount);
+  std::int32_t *enemyIds =
+      reinterpret_cast<std::int32_t *>(enemyPositions + turn.enemyCount);
+  std::int32_t *enemyLives = enemyIds + turn.enemyCount;
+  int n = 0;
+  for (int i = 0; i < state.dataCount; ++i) {
+    if (!state.dataAlive[i])
+      continue;
+    dataPositions[n] = Vector2i(state.dataPositions[i]);
+    dataIds[n++] = state.dataIds[i];
+  }
+  n = 0;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    enemyPositions[n] = Vector2i(state.enemyPositions[i]);
+    enemyIds[n] = state.enemyIds[i];
+    enemyLives[n++] = state.enemyLives[i];
+  }
+  used += size;
+  return true;
+}
+
+bool ReplayWriter::flush() {
+  std::size_t written = 0;
+  while (written < used) {
+    ssize_t count = ::write(fd, buffer + written, used - written);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count <= 0)
+      return false;
+    written += static_cast<std::size_t>(count);
+  }
+  used = 0;
+  return true;
+}
+
+void ReplayWriter::close() {
+  if (fd < 0)
+    return;
+  flush();
+  ::close(fd);
+  fd = -1;
+  used = 0;
+}
+
+ReplayReader::ReplayReader(void) : data(nullptr), size(0), offset(0) {}
+
+ReplayReader::~ReplayReader() { close(); }
+
+bool ReplayReader::open(const char *path) {
+  close();
+  int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+  struct stat status;
+  if (fstat(fd, &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) < sizeof(ReplayHeader)) {
+    ::close(fd);
+    return false;
+  }
+  void *mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED)
+    return false;
+  data = static_cast<const char *>(mapped);
+  size = static_cast<std::size_t>(status.st_size);
+  madvise(mapped, size, MADV_SEQUENTIAL);
+
+  const ReplayHeader *header = reinterpret_cast<const ReplayHeader *>(data);
+  if (std::memcmp(header->magic, "FZRP", 4) != 0 ||
+      header->version != REPLAY_VERSION ||
+      header->turnSize != sizeof(ReplayTurn)) {
+    close();
+    return false;
+  }
+  offset = sizeof(ReplayHeader);
+  return true;
+}
+
+void ReplayReader::close() {
+  if (data)
+    munmap(const_cast<char *>(data), size);
+  data = nullptr;
+  size = 0;
+  offset = 0;
+}
+
+bool ReplayReader::next(ReplayTurnView &view) {
+  if (!data || offset + sizeof(ReplayTurn) > size)
+    return false;
+  const ReplayTurn *turn = reinterpret_cast<const ReplayTurn *>(data + offset);
+  if (turn->dataCount < 0 || turn->dataCount > MAX_DATA_POINTS ||
+      turn->enemyCount < 0 || turn->enemyCount > MAX_ENEMIES ||
+      turn->size != replayTurnSize(turn->dataCount, turn->enemyCount) ||
+      offset + turn->size > size)
+    return false;
+  view.turn = turn;
+  view.dataPositions =
+      reinterpret_cast<const Vector2i *>(data + offset + sizeof(ReplayTurn));
+  view.dataIds = reinterpret_cast<const std::int32_t *>(view.dataPositions +
+                                                         turn->dataCount);
+  view.enemyPositions =
+      reinterpret_cast<const Vector2i *>(view.dataIds + turn->dataCount);
+  view.enemyIds = reinterpret_cast<const std::int32_t *>(
+      view.enemyPositions + turn->enemyCount);
+  view.enemyLives = view.enemyIds + turn->enemyCount;
+  offset += turn->size;
+  return true;
+}
+
+void ReplayReader::rewind() {
+  if (data)
+    offset = sizeof(ReplayHeader);
+}
+}
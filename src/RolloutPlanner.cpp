@@ -0,0 +1,99 @@
+#include "RolloutPlanner.hpp"
+#include <algorithm>
+
+namespace fuzzyTelegram {
+
+RolloutPlanner::RolloutPlanner(unsigned seed)
+    : bestSequenceValue(0), bestLength(0), hasBest(false), rolloutCount(0),
+      random(seed) {}
+
+void RolloutPlanner::reset(const GameState &newRoot, const Action &played) {
+  // Shift the best sequence and follow the enemies it shoots by id, their
+  // slots change when others die. After another action it is worth nothing.
+  hasBest = hasBest && best[0] == played;
+  if (hasBest) {
+    for (int i = 0; i + 1 < bestLength; ++i) {
+      best[i] = best[i + 1];
+      if (best[i].type == Action::SHOOT && best[i].enemy >= 0)
+        best[i].enemy = newRoot.findEnemy(root.enemyIds[best[i].enemy]);
+    }
+  }
+  root = newRoot;
+  updateTargets(root);
+  threats.build(root);
+  rolloutCount = 0;
+  bestSequenceValue = rollout(best, hasBest ? bestLength - 1 : 0, bestLength);
+  hasBest = true;
+}
+
+void RolloutPlanner::reset(const GameState &newRoot) {
+  reset(newRoot, bestAction());
+}
+
+void RolloutPlanner::iterate() {
+  // Half of the sequences are brand new, the others keep a prefix of the
+  // best one, never past the end of the game.
+  int keep = static_cast<int>(random.below(2 * DEPTH));
+  keep = keep < DEPTH ? 0 : std::min(keep - DEPTH, bestLength);
+  for (int i = 0; i < keep; ++i)
+    candidate[i] = best[i];
+  int length;
+  float value = rollout(candidate, keep, length);
+  if (value > bestSequenceValue) {
+    bestSequenceValue = value;
+    bestLength = length;
+    for (int i = 0; i < length; ++i)
+      best[i] = candidate[i];
+  }
+}
+
+Action RolloutPlanner::bestAction() const { return best[0]; }
+
+float RolloutPlanner::bestValue() const { return bestSequenceValue; }
+
+int RolloutPlanner::bestSequenceLength() const { return bestLength; }
+
+unsigned long RolloutPlanner::rollouts() const { return rolloutCount; }
+
+int RolloutPlanner::rootStatistics(ActionStatistics *out,
+                                   int capacity) const {
+  if (capacity < 1)
+    return 0;
+  out[0].action = best[0];
+  out[0].valueSum = bestSequenceValue;
+  out[0].visits = 1;
+  return 1;
+}
+
+Action RolloutPlanner::randomAction(const GameState &state, int turn) {
+  if (state.enemiesRemaining > 0 && random.coin()) {
+    int enemy;
+    do {
+      enemy = static_cast<int>(random.below(state.enemyCount));
+    } while (!state.enemyAlive[enemy]);
+    return Action::shoot(enemy);
+  }
+  // Only the first move is checked : the map assumes enemies walk straight
+  // to Wolff, further turns would keep away from most of the map.
+  Vector2f destination = state.wolff + random.inDisc(WOLFF_STEP);
+  for (int i = 1;
+       turn == 0 && i < MOVE_TRIES && !threats.isSafe(destination, 1); ++i)
+    destination = state.wolff + random.inDisc(WOLFF_STEP);
+  return Action::move(destination);
+}
+
+float RolloutPlanner::rollout(Action *sequence, int keep, int &length) {
+  ++rolloutCount;
+  scratch = root;
+  int i = 0;
+  for (; i < DEPTH && !scratch.isOver(); ++i) {
+    if (i >= keep || (sequence[i].type == Action::SHOOT &&
+                      (sequence[i].enemy < 0 ||
+                       !scratch.enemyAlive[sequence[i].enemy])))
+      sequence[i] = randomAction(scratch, i);
+    simulate(scratch, sequence[i]);
+  }
+  length = i;
+  return evaluate(scratch);
+}
+}
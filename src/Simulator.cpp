@@ -0,0 +1,366 @@
+#include "Simulator.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace fuzzyTelegram {
+
+Action::Action(void) : type(MOVE), destination(), enemy(-1) {}
+
+Action Action::move(const Vector2f &destination) {
+  Action action;
+  action.type = MOVE;
+  action.destination = destination;
+  return action;
+}
+
+Action Action::shoot(int enemy) {
+  Action action;
+  action.type = SHOOT;
+  action.enemy = enemy;
+  return action;
+}
+
+bool Action::operator==(const Action &other) const {
+  if (type != other.type)
+    return false;
+  return type == SHOOT ? enemy == other.enemy
+                       : destination == other.destination;
+}
+
+GameState::GameState(void) { clear(); }
+
+void GameState::clear() {
+  wolff = Vector2f::zero();
+  wolffDead = false;
+  turn = 0;
+  dataCount = 0;
+  dataRemaining = 0;
+  dataPositions.clear();
+  dataGrid.clear();
+  dataAlive.clear();
+  enemyCount = 0;
+  enemyPositions.clear();
+  enemyAlive.clear();
+  enemiesRemaining = 0;
+  initialTotalLife = 0;
+  shots = 0;
+  kills = 0;
+}
+
+int GameState::addDataPoint(int id, const Vector2f &position) {
+  int slot = dataCount++;
+  dataPositions.push(position);
+  dataGrid.insert(slot, position);
+  dataIds[slot] = id;
+  dataAlive.set(slot);
+  ++dataRemaining;
+  invalidateTargets();
+  return slot;
+}
+
+int GameState::addEnemy(int id, const Vector2f &position, int life) {
+  int slot = enemyCount++;
+  enemyPositions.push(position);
+  enemyIds[slot] = id;
+  enemyLives[slot] = life;
+  enemyAlive.set(slot);
+  enemyTargets[slot] = -1;
+  enemyTargetTurns[slot] = 0;
+  ++enemiesRemaining;
+  return slot;
+}
+
+void GameState::removeDataPoint(int slot) {
+  dataAlive.reset(slot);
+  dataGrid.remove(slot);
+  dataPositions.set(slot, Vector2f(REMOVED_POSITION));
+  --dataRemaining;
+}
+
+void GameState::removeEnemy(int slot) {
+  enemyAlive.reset(slot);
+  enemyPositions.set(slot, Vector2f(REMOVED_POSITION));
+  --enemiesRemaining;
+}
+
+void GameState::restoreDataPoint(int slot, const Vector2f &position) {
+  dataAlive.set(slot);
+  dataGrid.insert(slot, position);
+  dataPositions.set(slot, position);
+  ++dataRemaining;
+}
+
+void GameState::restoreEnemy(int slot, const Vector2f &position) {
+  enemyAlive.set(slot);
+  enemyPositions.set(slot, position);
+  ++enemiesRemaining;
+}
+
+void GameState::invalidateTargets() {
+  std::fill(enemyTargets, enemyTargets + enemyCount, -1);
+}
+
+int GameState::findEnemy(int id) const {
+  for (int i = 0; i < enemyCount; ++i)
+    if (enemyAlive[i] && enemyIds[i] == id)
+      return i;
+  return -1;
+}
+
+bool GameState::isOver() const {
+  return wolffDead || dataRemaining == 0 || enemiesRemaining == 0;
+}
+
+/*!
+* \brief Return the squared distance of two whole positions, exactly.
+*/
+static inline std::uint64_t exactSquaredDistance(const Vector2f &a,
+                                                 const Vector2f &b) {
+  std::int64_t dx = static_cast<std::int64_t>(a.x - b.x);
+  std::int64_t dy = static_cast<std::int64_t>(a.y - b.y);
+  return static_cast<std::uint64_t>(dx * dx + dy * dy);
+}
+
+/*!
+* \brief Return the candidate closest to position by exact distances, the
+* first slot on ties.
+*/
+template <typename Index>
+static int closestExactly(const GameState &state, const Vector2f &position,
+                          const Index *candidates, std::size_t count) {
+  int best = -1;
+  std::uint64_t bestDistance = 0;
+  for (std::size_t c = 0; c < count; ++c) {
+    int j = static_cast<int>(candidates[c]);
+    std::uint64_t distance =
+        exactSquaredDistance(state.dataPositions[j], position);
+    if (best == -1 || distance < bestDistance ||
+        (distance == bestDistance && j < best)) {
+      best = j;
+      bestDistance = distance;
+    }
+  }
+  return best;
+}
+
+int nearestDataPoint(const GameState &state, const Vector2f &position) {
+  if (state.dataRemaining == 0)
+    return -1;
+  // Float squared distances are rounded above 2^24 : the data points within
+  // rounding of the closest one are compared again exactly.
+  const float tolerance = 1 + 1.0f / (1 << 20);
+  if (state.dataRemaining < DATA_GRID_THRESHOLD) {
+    float distances[MAX_DATA_POINTS];
+    int candidates[MAX_DATA_POINTS];
+    std::size_t count = 0;
+    state.dataPositions.squaredDistances(position, distances);
+    float closest = *std::min_element(distances, distances + state.dataCount);
+    for (int j = 0; j < state.dataCount; ++j)
+      if (state.dataAlive[j] && distances[j] <= closest * tolerance)
+        candidates[count++] = j;
+    return closestExactly(state, position, candidates, count);
+  }
+  DataGrid::Index slots[MAX_DATA_POINTS];
+  float squaredDistance;
+  if (state.dataGrid.nearest(state.dataPositions, position, 1, slots,
+                             &squaredDistance) == 0)
+    return -1;
+  std::size_t count = state.dataGrid.within(state.dataPositions, position,
+      std::sqrt(squaredDistance) * tolerance + 1, slots, MAX_DATA_POINTS);
+  return closestExactly(state, position, slots, count);
+}
+
+/*!
+* \brief Return the last turn target stays the closest data point of an
+* enemy at position : the difference of the distances to the second closest
+* and to target, rounded down, shrinks by TARGET_SLACK per turn and must stay
+* positive.
+*/
+static int targetTurn(const GameState &state, const Vector2f &position,
+                      int target) {
+  std::uint64_t second = std::numeric_limits<std::uint64_t>::max();
+  for (std::size_t j = state.dataAlive.next(0);
+       j < static_cast<std::size_t>(state.dataCount);
+       j = state.dataAlive.next(j + 1))
+    if (static_cast<int>(j) != target)
+      second = std::min(
+          second, exactSquaredDistance(state.dataPositions[j], position));
+  if (second == std::numeric_limits<std::uint64_t>::max())
+    return std::numeric_limits<int>::max();
+  std::int64_t margin =
+      static_cast<std::int64_t>(integerSqrt(second)) -
+      static_cast<std::int64_t>(integerSqrt(exactSquaredDistance(
+          state.dataPositions[target], position))) -
+      1;
+  return state.turn + static_cast<int>(std::max<std::int64_t>(
+                          0, (margin - 1) / TARGET_SLACK));
+}
+
+template <typename Recorder>
+int updateTargets(GameState &state, Recorder &recorder) {
+  int updated = 0;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    int target = state.enemyTargets[i];
+    if (!state.enemyAlive[i] ||
+        (target != -1 && state.dataAlive[target] &&
+         state.turn <= state.enemyTargetTurns[i]))
+      continue;
+    recorder.targetChanged(i, target, state.enemyTargetTurns[i]);
+    Vector2f position = state.enemyPositions[i];
+    target = nearestDataPoint(state, position);
+    state.enemyTargets[i] = target;
+    if (target != -1)
+      state.enemyTargetTurns[i] = targetTurn(state, position, target);
+    ++updated;
+  }
+  return updated;
+}
+
+int updateTargets(GameState &state) {
+  NoRecorder recorder;
+  return updateTargets(state, recorder);
+}
+
+bool verifyTargets(const GameState &state) {
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    int target = state.enemyTargets[i];
+    if (target == -1) {
+      if (state.dataRemaining > 0)
+        return false;
+      continue;
+    }
+    if (!state.dataAlive[target])
+      return false;
+    Vector2f position = state.enemyPositions[i];
+    std::uint64_t cached =
+        exactSquaredDistance(state.dataPositions[target], position);
+    // Positions are whole, the distances are compared exactly and the
+    // first slot wins ties, like nearestDataPoint.
+    for (int j = 0; j < state.dataCount; ++j) {
+      if (!state.dataAlive[j])
+        continue;
+      std::uint64_t squaredDistance =
+          exactSquaredDistance(state.dataPositions[j], position);
+      if (squaredDistance < cached || (squaredDistance == cached && j < target))
+        return false;
+    }
+  }
+  return true;
+}
+
+Vector2f clampToMap(const Vector2f &position) {
+  return Vector2f(std::min(std::max(position.x, 0.0f), MAP_WIDTH - 1),
+                  std::min(std::max(position.y, 0.0f), MAP_HEIGHT - 1));
+}
+
+Action playableAction(const GameState &state, const Action &action) {
+  if (action.type == Action::SHOOT &&
+      (action.enemy < 0 || action.enemy >= state.enemyCount ||
+       !state.enemyAlive[action.enemy]))
+    return Action::move(state.wolff);
+  return action;
+}
+
+bool moveTowards(Vector2f &position, const Vector2f &destination,
+                 float step) {
+  Vector2i moved(position);
+  bool arrived = stepTowards(moved, Vector2i(destination),
+                             static_cast<int>(step));
+  position = Vector2f(moved);
+  return arrived;
+}
+
+template <typename Recorder>
+void simulate(GameState &state, const Action &action, Recorder &recorder) {
+  bool arrived[MAX_ENEMIES];
+  recorder.beginTurn(state);
+
+  // Enemies move towards their closest data point.
+  updateTargets(state, recorder);
+#ifdef FUZZY_DEBUG
+  assert(verifyTargets(state));
+#endif
+  const int *targets = state.enemyTargets;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    Vector2f position = state.enemyPositions[i];
+    recorder.enemyMoved(i, position);
+    arrived[i] = targets[i] != -1 &&
+                 moveTowards(position, state.dataPositions[targets[i]],
+                             ENEMY_STEP);
+    state.enemyPositions.set(i, position);
+  }
+
+  if (action.type == Action::MOVE)
+    moveTowards(state.wolff, clampToMap(action.destination), WOLFF_STEP);
+
+  if (state.enemyPositions.anyWithin(state.wolff, KILL_RANGE)) {
+    state.wolffDead = true;
+    ++state.turn;
+    return;
+  }
+
+  if (action.type == Action::SHOOT && action.enemy >= 0 &&
+      action.enemy < state.enemyCount && state.enemyAlive[action.enemy]) {
+    int target = action.enemy;
+    ++state.shots;
+    recorder.enemyHit(target, state.enemyLives[target]);
+    state.enemyLives[target] -= shotDamageSquared(
+        Vector2f::squaredDistance(state.enemyPositions[target], state.wolff));
+    if (state.enemyLives[target] <= 0) {
+      recorder.enemyRemoved(target, state.enemyPositions[target]);
+      state.removeEnemy(target);
+      ++state.kills;
+    }
+  }
+
+  // Surviving enemies collect the data point they reached.
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    if (arrived[i] && state.dataAlive[targets[i]]) {
+      recorder.dataRemoved(targets[i], state.dataPositions[targets[i]]);
+      state.removeDataPoint(targets[i]);
+    }
+  }
+
+  ++state.turn;
+}
+
+void simulate(GameState &state, const Action &action) {
+  NoRecorder recorder;
+  simulate(state, action, recorder);
+}
+
+/*!
+* \brief Return the score of state with shots counted in the bonus.
+*/
+static int scoreWithShots(const GameState &state, int shots) {
+  if (state.wolffDead)
+    return 0;
+  int bonus =
+      state.dataRemaining * std::max(0, state.initialTotalLife - 3 * shots) * 3;
+  return state.dataRemaining * 100 + state.kills * 10 + bonus;
+}
+
+int score(const GameState &state) { return scoreWithShots(state, state.shots); }
+
+float evaluate(const GameState &state) { return evaluate(state, state.shots); }
+
+float evaluate(const GameState &state, int shots) {
+  if (state.wolffDead)
+    return 0;
+  int life = 0;
+  for (int i = 0; i < state.enemyCount; ++i)
+    if (state.enemyAlive[i])
+      life += state.enemyLives[i];
+  return scoreWithShots(state, shots) +
+         0.1f * std::max(0, state.initialTotalLife - life);
+}
+}
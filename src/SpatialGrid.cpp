@@ -0,0 +1,159 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace fuzzyTelegram {
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+const int SpatialGrid<Capacity, Width, Height, CellSize>::COLUMNS;
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+const int SpatialGrid<Capacity, Width, Height, CellSize>::ROWS;
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+const int SpatialGrid<Capacity, Width, Height, CellSize>::CELLS;
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+const typename SpatialGrid<Capacity, Width, Height, CellSize>::Index
+    SpatialGrid<Capacity, Width, Height, CellSize>::NONE;
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+SpatialGrid<Capacity, Width, Height, CellSize>::SpatialGrid(void) {
+  clear();
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+void SpatialGrid<Capacity, Width, Height, CellSize>::clear() {
+  std::fill(heads, heads + CELLS, NONE);
+  std::fill(inserted, inserted + Capacity, false);
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+Vector2i SpatialGrid<Capacity, Width, Height, CellSize>::cellOf(
+    const Vector2f &position) {
+  int column = static_cast<int>(position.x) / CellSize;
+  int row = static_cast<int>(position.y) / CellSize;
+  return Vector2i(std::min(std::max(column, 0), COLUMNS - 1),
+                  std::min(std::max(row, 0), ROWS - 1));
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+int SpatialGrid<Capacity, Width, Height, CellSize>::cellIndex(
+    const Vector2i &cell) {
+  return cell.y * COLUMNS + cell.x;
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+void SpatialGrid<Capacity, Width, Height, CellSize>::insert(
+    std::size_t index, const Vector2f &position) {
+  assert(index < Capacity && !inserted[index]);
+  int cell = cellIndex(cellOf(position));
+  Index head = heads[cell];
+  next[index] = head;
+  previous[index] = NONE;
+  if (head != NONE)
+    previous[head] = static_cast<Index>(index);
+  heads[cell] = static_cast<Index>(index);
+  cells[index] = static_cast<std::uint16_t>(cell);
+  inserted[index] = true;
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+void SpatialGrid<Capacity, Width, Height, CellSize>::remove(
+    std::size_t index) {
+  assert(index < Capacity && inserted[index]);
+  if (previous[index] != NONE)
+    next[previous[index]] = next[index];
+  else
+    heads[cells[index]] = next[index];
+  if (next[index] != NONE)
+    previous[next[index]] = previous[index];
+  inserted[index] = false;
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+void SpatialGrid<Capacity, Width, Height, CellSize>::move(
+    std::size_t index, const Vector2f &position) {
+  if (cells[index] == cellIndex(cellOf(position)))
+    return;
+  remove(index);
+  insert(index, position);
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+bool SpatialGrid<Capacity, Width, Height, CellSize>::contains(
+    std::size_t index) const {
+  return index < Capacity && inserted[index];
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+std::size_t SpatialGrid<Capacity, Width, Height, CellSize>::within(
+    const Positions &positions, const Vector2f &center, float radius,
+    Index *out, std::size_t maxCount) const {
+  Vector2i low = cellOf(center - Vector2f(radius));
+  Vector2i high = cellOf(center + Vector2f(radius));
+  float squaredRadius = radius * radius;
+  std::size_t count = 0;
+  for (int row = low.y; row <= high.y; ++row) {
+    for (int column = low.x; column <= high.x; ++column) {
+      Index i = heads[cellIndex(Vector2i(column, row))];
+      for (; i != NONE; i = next[i]) {
+        if (Vector2f::squaredDistance(positions[i], center) > squaredRadius)
+          continue;
+        if (count == maxCount)
+          return count;
+        out[count++] = i;
+      }
+    }
+  }
+  return count;
+}
+
+template <std::size_t Capacity, int Width, int Height, int CellSize>
+std::size_t SpatialGrid<Capacity, Width, Height, CellSize>::nearest(
+    const Positions &positions, const Vector2f &center, std::size_t k,
+    Index *out, float *squaredDistances) const {
+  if (k == 0)
+    return 0;
+  Vector2i origin = cellOf(center);
+  std::size_t count = 0;
+  for (int ring = 0; ring < std::max(COLUMNS, ROWS); ++ring) {
+    Vector2i low(std::max(origin.x - ring, 0), std::max(origin.y - ring, 0));
+    Vector2i high(std::min(origin.x + ring, COLUMNS - 1),
+                  std::min(origin.y + ring, ROWS - 1));
+    for (int row = low.y; row <= high.y; ++row) {
+      bool edge = row == origin.y - ring || row == origin.y + ring;
+      // Inside the ring, only its left and right columns are new.
+      int step = edge ? 1 : std::max(2 * ring, 1);
+      for (int column = origin.x - ring; column <= origin.x + ring;
+           column += step) {
+        if (column < low.x || column > high.x)
+          continue;
+        Index i = heads[cellIndex(Vector2i(column, row))];
+        for (; i != NONE; i = next[i]) {
+          float distance = Vector2f::squaredDistance(positions[i], center);
+          // Insertion into the sorted k best, ordered by distance then index.
+          std::size_t slot = count;
+          while (slot > 0 &&
+                 (distance < squaredDistances[slot - 1] ||
+                  (distance == squaredDistances[slot - 1] &&
+                   i < out[slot - 1]))) {
+            if (slot < k) {
+              out[slot] = out[slot - 1];
+              squaredDistances[slot] = squaredDistances[slot - 1];
+            }
+            --slot;
+          }
+          if (slot < k) {
+            out[slot] = i;
+            squaredDistances[slot] = distance;
+            count = std::min(count + 1, k);
+          }
+        }
+      }
+    }
+    // Every cell outside this ring is at least ring * CellSize away.
+    float bound = static_cast<float>(ring) * CellSize;
+    if (count == k && squaredDistances[k - 1] < bound * bound)
+      break;
+  }
+  return count;
+}
+}
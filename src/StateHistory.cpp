@@ -0,0 +1,114 @@
+#include "StateHistory.hpp"
+#include <cassert>
+#include <cstring>
+
+namespace fuzzyTelegram {
+
+template <std::size_t Depth>
+SnapshotStack<Depth>::SnapshotStack(void) : depth(0) {}
+
+template <std::size_t Depth> std::size_t SnapshotStack<Depth>::size() const {
+  return depth;
+}
+
+template <std::size_t Depth> void SnapshotStack<Depth>::clear() { depth = 0; }
+
+template <std::size_t Depth>
+void SnapshotStack<Depth>::push(const GameState &state) {
+  assert(depth < Depth);
+  std::memcpy(static_cast<void *>(&slots[depth++]), &state, sizeof(state));
+}
+
+template <std::size_t Depth>
+void SnapshotStack<Depth>::restore(GameState &state) const {
+  assert(depth > 0);
+  std::memcpy(static_cast<void *>(&state), &slots[depth - 1], sizeof(state));
+}
+
+template <std::size_t Depth> void SnapshotStack<Depth>::pop() {
+  assert(depth > 0);
+  --depth;
+}
+
+UndoLog::UndoLog(void) : turnCount(0), entryCount(0) {}
+
+void UndoLog::clear() {
+  turnCount = 0;
+  entryCount = 0;
+}
+
+int UndoLog::turns() const { return turnCount; }
+
+void UndoLog::undo(GameState &state) {
+  assert(turnCount > 0);
+  const Turn &turn = turnLog[--turnCount];
+  while (entryCount > turn.firstEntry) {
+    const Entry &entry = entries[--entryCount];
+    switch (entry.kind) {
+    case Entry::TARGET:
+      state.enemyTargets[entry.slot] = entry.value;
+      state.enemyTargetTurns[entry.slot] = entry.targetTurn;
+      break;
+    case Entry::MOVE:
+      state.enemyPositions.set(entry.slot, entry.position);
+      break;
+    case Entry::LIFE:
+      state.enemyLives[entry.slot] = entry.value;
+      break;
+    case Entry::ENEMY_REMOVED:
+      state.restoreEnemy(entry.slot, entry.position);
+      break;
+    case Entry::DATA_REMOVED:
+      state.restoreDataPoint(entry.slot, entry.position);
+      break;
+    }
+  }
+  state.wolff = turn.wolff;
+  state.wolffDead = turn.wolffDead;
+  state.turn = turn.turn;
+  state.shots = turn.shots;
+  state.kills = turn.kills;
+}
+
+void UndoLog::beginTurn(const GameState &state) {
+  assert(turnCount < MAX_TURNS);
+  Turn &turn = turnLog[turnCount++];
+  turn.wolff = state.wolff;
+  turn.wolffDead = state.wolffDead;
+  turn.turn = state.turn;
+  turn.shots = state.shots;
+  turn.kills = state.kills;
+  turn.firstEntry = entryCount;
+}
+
+void UndoLog::targetChanged(int slot, int target, int targetTurn) {
+  record(Entry::TARGET, slot, target, Vector2f::zero());
+  entries[entryCount - 1].targetTurn = targetTurn;
+}
+
+void UndoLog::enemyMoved(int slot, const Vector2f &position) {
+  record(Entry::MOVE, slot, 0, position);
+}
+
+void UndoLog::enemyHit(int slot, int life) {
+  record(Entry::LIFE, slot, life, Vector2f::zero());
+}
+
+void UndoLog::enemyRemoved(int slot, const Vector2f &position) {
+  record(Entry::ENEMY_REMOVED, slot, 0, position);
+}
+
+void UndoLog::dataRemoved(int slot, const Vector2f &position) {
+  record(Entry::DATA_REMOVED, slot, 0, position);
+}
+
+void UndoLog::record(Entry::Kind kind, int slot, int value,
+                     const Vector2f &position) {
+  assert(entryCount < MAX_ENTRIES);
+  Entry &entry = entries[entryCount++];
+  entry.kind = static_cast<std::uint8_t>(kind);
+  entry.slot = static_cast<std::uint8_t>(slot);
+  entry.value = value;
+  entry.position = position;
+}
+}
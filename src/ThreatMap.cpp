@@ -0,0 +1,91 @@
+#include "ThreatMap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace fuzzyTelegram {
+
+const int ThreatMap::CELL_SIZE;
+const int ThreatMap::COLUMNS;
+const int ThreatMap::ROWS;
+const int ThreatMap::CELLS;
+const int ThreatMap::NEVER;
+
+ThreatMap::ThreatMap(void) : enemies(0) {
+  for (int row = 0; row < ROWS; ++row)
+    for (int column = 0; column < COLUMNS; ++column)
+      centers.push(Vector2f((column + 0.5f) * CELL_SIZE,
+                            (row + 0.5f) * CELL_SIZE));
+  std::fill(closest, closest + CELLS, std::numeric_limits<float>::max());
+  std::fill(turns, turns + CELLS, static_cast<std::uint8_t>(NEVER));
+}
+
+void ThreatMap::build(const GameState &state) {
+  std::fill(closest, closest + CELLS, std::numeric_limits<float>::max());
+  origins.clear();
+  enemies = state.enemiesRemaining;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    origins.push(state.enemyPositions[i]);
+    if (!state.enemyAlive[i])
+      continue;
+    centers.squaredDistances(state.enemyPositions[i], scratch);
+    for (int c = 0; c < CELLS; ++c)
+      closest[c] = std::min(closest[c], scratch[c]);
+  }
+  for (int c = 0; c < CELLS; ++c)
+    turns[c] = turnOf(closest[c]);
+}
+
+int ThreatMap::enemyRemoved(int slot) {
+  const Vector2f position = origins[slot];
+  if (position == Vector2f(REMOVED_POSITION))
+    return 0;
+  origins.set(slot, Vector2f(REMOVED_POSITION));
+  --enemies;
+  centers.squaredDistances(position, scratch);
+  int updated = 0;
+  for (int c = 0; c < CELLS; ++c) {
+    // The same kernel computed both, the tolerance is for ties.
+    if (scratch[c] > closest[c] * (1 + 1e-6f))
+      continue;
+    float squaredDistance = std::numeric_limits<float>::max();
+    if (enemies > 0)
+      origins.nearest(centers[c], &squaredDistance);
+    closest[c] = squaredDistance;
+    turns[c] = turnOf(squaredDistance);
+    ++updated;
+  }
+  return updated;
+}
+
+int ThreatMap::earliestTurn(const Vector2f &position) const {
+  return turns[cellIndex(position)];
+}
+
+bool ThreatMap::isSafe(const Vector2f &position, int turnCount) const {
+  return turns[cellIndex(position)] > turnCount;
+}
+
+int ThreatMap::cellTurn(int column, int row) const {
+  return turns[row * COLUMNS + column];
+}
+
+int ThreatMap::cellIndex(const Vector2f &position) {
+  int column = std::min(std::max(static_cast<int>(position.x) / CELL_SIZE, 0),
+                        COLUMNS - 1);
+  int row = std::min(std::max(static_cast<int>(position.y) / CELL_SIZE, 0),
+                     ROWS - 1);
+  return row * COLUMNS + column;
+}
+
+std::uint8_t ThreatMap::turnOf(float squaredDistance) {
+  const float halfDiagonal = CELL_SIZE * 0.70710678f;
+  float distance = std::sqrt(squaredDistance) - halfDiagonal - KILL_RANGE;
+  if (distance <= ENEMY_STEP)
+    return 1;
+  // Rounded up without std::ceil, a libm call without SSE4.1.
+  float turn = std::min(distance / ENEMY_STEP, static_cast<float>(NEVER));
+  int whole = static_cast<int>(turn);
+  return static_cast<std::uint8_t>(whole + (whole < turn));
+}
+}
@@ -0,0 +1,75 @@
+#include "TurnClock.hpp"
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define FUZZY_HAS_RDTSC
+#endif
+
+namespace fuzzyTelegram {
+
+constexpr double TurnClock::FIRST_TURN_BUDGET_MS;
+constexpr double TurnClock::TURN_BUDGET_MS;
+
+TurnClock::TurnClock(double firstTurnBudgetMs, double turnBudgetMs)
+    : firstTurnBudget(firstTurnBudgetMs), turnBudget(turnBudgetMs),
+      ticks(ticksPerMs()), turns(0), start(0), deadline(0) {}
+
+void TurnClock::startTurn() {
+  start = now();
+  ++turns;
+  deadline = start + static_cast<std::uint64_t>(budgetMs() * ticks);
+}
+
+int TurnClock::turn() const { return turns; }
+
+double TurnClock::budgetMs() const {
+  return turns <= 1 ? firstTurnBudget : turnBudget;
+}
+
+double TurnClock::elapsedMs() const {
+  return static_cast<double>(now() - start) / ticks;
+}
+
+double TurnClock::remainingMs() const { return budgetMs() - elapsedMs(); }
+
+bool TurnClock::expired(double marginMs) const {
+  return now() + static_cast<std::uint64_t>(marginMs * ticks) >=
+         deadline;
+}
+
+std::uint64_t TurnClock::now() {
+#ifdef FUZZY_HAS_RDTSC
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/*!
+* \brief Count the ticks of the time stamp counter during a few milliseconds
+* of steady_clock.
+*/
+static double calibrate() {
+#ifdef FUZZY_HAS_RDTSC
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point from = Clock::now();
+  const std::uint64_t ticks = __rdtsc();
+  Clock::time_point to;
+  do {
+    to = Clock::now();
+  } while (to - from < std::chrono::milliseconds(2));
+  const double ms =
+      std::chrono::duration<double, std::milli>(to - from).count();
+  return static_cast<double>(__rdtsc() - ticks) / ms;
+#else
+  return 1e6;
+#endif
+}
+
+double TurnClock::ticksPerMs() {
+  static const double ticks = calibrate();
+  return ticks;
+}
+}
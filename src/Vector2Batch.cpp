@@ -0,0 +1,299 @@
+#include "Vector2Batch.hpp"
+#include <cassert>
+#include <limits>
+#if defined(__AVX__) || defined(FUZZY_TARGET_AVX2)
+#define FUZZY_BATCH_AVX
+#endif
+#if defined(__SSE2__) || defined(FUZZY_BATCH_AVX)
+#include <immintrin.h>
+#endif
+
+namespace fuzzyTelegram {
+
+namespace batchKernels {
+
+template <typename T>
+void squaredDistances(const T *xs, const T *ys, std::size_t n, T px, T py,
+                      T *out) {
+  for (std::size_t i = 0; i < n; ++i) {
+    T dx = xs[i] - px;
+    T dy = ys[i] - py;
+    out[i] = dx * dx + dy * dy;
+  }
+}
+
+template <typename T>
+void dots(const T *xs, const T *ys, std::size_t n, T vx, T vy, T *out) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = xs[i] * vx + ys[i] * vy;
+}
+
+template <typename T>
+std::size_t nearest(const T *xs, const T *ys, std::size_t begin,
+                    std::size_t n, T px, T py, std::size_t best,
+                    T &bestDistance) {
+  for (std::size_t i = begin; i < n; ++i) {
+    T dx = xs[i] - px;
+    T dy = ys[i] - py;
+    T distance = dx * dx + dy * dy;
+    if (best == n || distance < bestDistance) {
+      best = i;
+      bestDistance = distance;
+    }
+  }
+  return best;
+}
+
+template <typename T>
+bool anyWithin(const T *xs, const T *ys, std::size_t begin, std::size_t n,
+               T px, T py, T squaredRadius) {
+  for (std::size_t i = begin; i < n; ++i) {
+    T dx = xs[i] - px;
+    T dy = ys[i] - py;
+    if (dx * dx + dy * dy <= squaredRadius)
+      return true;
+  }
+  return false;
+}
+
+#if defined(FUZZY_BATCH_AVX)
+
+inline void squaredDistances(const float *xs, const float *ys, std::size_t n,
+                             float px, float py, float *out) {
+  const __m256 x = _mm256_set1_ps(px);
+  const __m256 y = _mm256_set1_ps(py);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_load_ps(xs + i), x);
+    __m256 dy = _mm256_sub_ps(_mm256_load_ps(ys + i), y);
+    _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(dx, dx),
+                                            _mm256_mul_ps(dy, dy)));
+  }
+  squaredDistances<float>(xs + i, ys + i, n - i, px, py, out + i);
+}
+
+inline void dots(const float *xs, const float *ys, std::size_t n, float vx,
+                 float vy, float *out) {
+  const __m256 x = _mm256_set1_ps(vx);
+  const __m256 y = _mm256_set1_ps(vy);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(out + i,
+                     _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(xs + i), x),
+                                   _mm256_mul_ps(_mm256_load_ps(ys + i), y)));
+  dots<float>(xs + i, ys + i, n - i, vx, vy, out + i);
+}
+
+inline std::size_t nearest(const float *xs, const float *ys, std::size_t n,
+                           float px, float py, float &bestDistance) {
+  const __m256 x = _mm256_set1_ps(px);
+  const __m256 y = _mm256_set1_ps(py);
+  // Indices are kept as floats, exact for any realistic capacity.
+  __m256 index = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256 step = _mm256_set1_ps(8);
+  __m256 lanesDistance = _mm256_set1_ps(std::numeric_limits<float>::max());
+  __m256 lanesIndex = _mm256_set1_ps(-1);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_load_ps(xs + i), x);
+    __m256 dy = _mm256_sub_ps(_mm256_load_ps(ys + i), y);
+    __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    __m256 closer = _mm256_cmp_ps(d, lanesDistance, _CMP_LT_OQ);
+    lanesDistance = _mm256_blendv_ps(lanesDistance, d, closer);
+    lanesIndex = _mm256_blendv_ps(lanesIndex, index, closer);
+    index = _mm256_add_ps(index, step);
+  }
+  alignas(32) float distances[8];
+  alignas(32) float indices[8];
+  _mm256_store_ps(distances, lanesDistance);
+  _mm256_store_ps(indices, lanesIndex);
+  std::size_t best = n;
+  for (int lane = 0; lane < 8; ++lane) {
+    if (indices[lane] < 0)
+      continue;
+    std::size_t laneBest = static_cast<std::size_t>(indices[lane]);
+    if (best == n || distances[lane] < bestDistance ||
+        (distances[lane] == bestDistance && laneBest < best)) {
+      best = laneBest;
+      bestDistance = distances[lane];
+    }
+  }
+  return nearest<float>(xs, ys, i, n, px, py, best, bestDistance);
+}
+
+inline bool anyWithin(const float *xs, const float *ys, std::size_t n,
+                      float px, float py, float squaredRadius) {
+  const __m256 x = _mm256_set1_ps(px);
+  const __m256 y = _mm256_set1_ps(py);
+  const __m256 r = _mm256_set1_ps(squaredRadius);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_load_ps(xs + i), x);
+    __m256 dy = _mm256_sub_ps(_mm256_load_ps(ys + i), y);
+    __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    if (_mm256_movemask_ps(_mm256_cmp_ps(d, r, _CMP_LE_OQ)))
+      return true;
+  }
+  return anyWithin<float>(xs, ys, i, n, px, py, squaredRadius);
+}
+
+#elif defined(__SSE2__)
+
+inline void squaredDistances(const float *xs, const float *ys, std::size_t n,
+                             float px, float py, float *out) {
+  const __m128 x = _mm_set1_ps(px);
+  const __m128 y = _mm_set1_ps(py);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 dx = _mm_sub_ps(_mm_load_ps(xs + i), x);
+    __m128 dy = _mm_sub_ps(_mm_load_ps(ys + i), y);
+    _mm_storeu_ps(out + i,
+                  _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+  }
+  squaredDistances<float>(xs + i, ys + i, n - i, px, py, out + i);
+}
+
+inline void dots(const float *xs, const float *ys, std::size_t n, float vx,
+                 float vy, float *out) {
+  const __m128 x = _mm_set1_ps(vx);
+  const __m128 y = _mm_set1_ps(vy);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(xs + i), x),
+                                      _mm_mul_ps(_mm_load_ps(ys + i), y)));
+  dots<float>(xs + i, ys + i, n - i, vx, vy, out + i);
+}
+
+inline std::size_t nearest(const float *xs, const float *ys, std::size_t n,
+                           float px, float py, float &bestDistance) {
+  const __m128 x = _mm_set1_ps(px);
+  const __m128 y = _mm_set1_ps(py);
+  // Indices are kept as floats, exact for any realistic capacity.
+  __m128 index = _mm_setr_ps(0, 1, 2, 3);
+  const __m128 step = _mm_set1_ps(4);
+  __m128 lanesDistance = _mm_set1_ps(std::numeric_limits<float>::max());
+  __m128 lanesIndex = _mm_set1_ps(-1);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 dx = _mm_sub_ps(_mm_load_ps(xs + i), x);
+    __m128 dy = _mm_sub_ps(_mm_load_ps(ys + i), y);
+    __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    __m128 closer = _mm_cmplt_ps(d, lanesDistance);
+    lanesDistance = _mm_or_ps(_mm_and_ps(closer, d),
+                              _mm_andnot_ps(closer, lanesDistance));
+    lanesIndex = _mm_or_ps(_mm_and_ps(closer, index),
+                           _mm_andnot_ps(closer, lanesIndex));
+    index = _mm_add_ps(index, step);
+  }
+  alignas(16) float distances[4];
+  alignas(16) float indices[4];
+  _mm_store_ps(distances, lanesDistance);
+  _mm_store_ps(indices, lanesIndex);
+  std::size_t best = n;
+  for (int lane = 0; lane < 4; ++lane) {
+    if (indices[lane] < 0)
+      continue;
+    std::size_t laneBest = static_cast<std::size_t>(indices[lane]);
+    if (best == n || distances[lane] < bestDistance ||
+        (distances[lane] == bestDistance && laneBest < best)) {
+      best = laneBest;
+      bestDistance = distances[lane];
+    }
+  }
+  return nearest<float>(xs, ys, i, n, px, py, best, bestDistance);
+}
+
+inline bool anyWithin(const float *xs, const float *ys, std::size_t n,
+                      float px, float py, float squaredRadius) {
+  const __m128 x = _mm_set1_ps(px);
+  const __m128 y = _mm_set1_ps(py);
+  const __m128 r = _mm_set1_ps(squaredRadius);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 dx = _mm_sub_ps(_mm_load_ps(xs + i), x);
+    __m128 dy = _mm_sub_ps(_mm_load_ps(ys + i), y);
+    __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    if (_mm_movemask_ps(_mm_cmple_ps(d, r)))
+      return true;
+  }
+  return anyWithin<float>(xs, ys, i, n, px, py, squaredRadius);
+}
+
+#endif
+
+template <typename T>
+std::size_t nearest(const T *xs, const T *ys, std::size_t n, T px, T py,
+                    T &bestDistance) {
+  return nearest<T>(xs, ys, 0, n, px, py, n, bestDistance);
+}
+
+template <typename T>
+bool anyWithin(const T *xs, const T *ys, std::size_t n, T px, T py,
+               T squaredRadius) {
+  return anyWithin<T>(xs, ys, 0, n, px, py, squaredRadius);
+}
+}
+
+template <typename T, std::size_t Capacity>
+Vector2Batch<T, Capacity>::Vector2Batch(void) : count(0) {}
+
+template <typename T, std::size_t Capacity>
+std::size_t Vector2Batch<T, Capacity>::size() const {
+  return count;
+}
+
+template <typename T, std::size_t Capacity>
+void Vector2Batch<T, Capacity>::clear() {
+  count = 0;
+}
+
+template <typename T, std::size_t Capacity>
+std::size_t Vector2Batch<T, Capacity>::push(const Vector2<T> &v) {
+  assert(count < Capacity);
+  xs[count] = v.x;
+  ys[count] = v.y;
+  return count++;
+}
+
+template <typename T, std::size_t Capacity>
+void Vector2Batch<T, Capacity>::set(std::size_t i, const Vector2<T> &v) {
+  assert(i < count);
+  xs[i] = v.x;
+  ys[i] = v.y;
+}
+
+template <typename T, std::size_t Capacity>
+Vector2<T> Vector2Batch<T, Capacity>::operator[](std::size_t i) const {
+  assert(i < count);
+  return Vector2<T>(xs[i], ys[i]);
+}
+
+template <typename T, std::size_t Capacity>
+void Vector2Batch<T, Capacity>::squaredDistances(const Vector2<T> &point,
+                                                 T *out) const {
+  batchKernels::squaredDistances(xs, ys, count, point.x, point.y, out);
+}
+
+template <typename T, std::size_t Capacity>
+void Vector2Batch<T, Capacity>::dots(const Vector2<T> &v, T *out) const {
+  batchKernels::dots(xs, ys, count, v.x, v.y, out);
+}
+
+template <typename T, std::size_t Capacity>
+std::size_t Vector2Batch<T, Capacity>::nearest(const Vector2<T> &point,
+                                               T *squaredDistance) const {
+  T bestDistance = T();
+  std::size_t best =
+      batchKernels::nearest(xs, ys, count, point.x, point.y, bestDistance);
+  if (squaredDistance != nullptr)
+    *squaredDistance = bestDistance;
+  return best;
+}
+
+template <typename T, std::size_t Capacity>
+bool Vector2Batch<T, Capacity>::anyWithin(const Vector2<T> &point,
+                                          T radius) const {
+  return batchKernels::anyWithin(xs, ys, count, point.x, point.y,
+                                 radius * radius);
+}
+}
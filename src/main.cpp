@@ -1,9 +1,55 @@
+#include "Vector2.hpp"
+#include "Vector2Batch.cpp"
+#include "SpatialGrid.cpp"
+#include "AliveMask.cpp"
+#include "Damage.cpp"
+#include "Simulator.cpp"
+#include "Divergence.cpp"
+#include "ThreatMap.cpp"
+#include "InputReader.cpp"
+#include "TurnClock.cpp"
+#include "AnytimeSearch.cpp"
+#include "Random.cpp"
+#include "RolloutPlanner.cpp"
+#include "EvolutionPlanner.cpp"
+#include "Arena.cpp"
+#include "MctsPlanner.cpp"
+#include "BeamPlanner.cpp"
+#include "PhaseTrace.cpp"
+#ifdef FUZZY_THREADS
+#include "ParallelPlanner.cpp"
+#include <thread>
+#endif
+#ifdef FUZZY_REPLAY
+#include "ReplayLog.cpp"
+#endif
+#include <cstdlib>
 #include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
 
 using namespace std;
+using namespace fuzzyTelegram;
+
+// Build with -DFUZZY_EVOLUTION to plan with the genetic algorithm, with
+// -DFUZZY_MCTS to plan with the tree search, or with -DFUZZY_BEAM to plan
+// with the beam search. make bot-mt adds -DFUZZY_THREADS
+// to run one planner per core. With -DFUZZY_REPLAY, which make bot adds, the
+// turns are logged to the replay file named by the FUZZY_REPLAY variable.
+// With -DFUZZY_TRACE, which make bot adds too, the time of each phase of the
+// turn is printed to stderr, and written as a Chrome trace to the file named
+// by the FUZZY_TRACE_JSON variable when the game ends. Each turn is compared
+// with the prediction of the previous one, the differences go to stderr.
+#if defined(FUZZY_MCTS)
+typedef MctsPlanner Planner;
+#elif defined(FUZZY_EVOLUTION)
+typedef EvolutionPlanner Planner;
+#elif defined(FUZZY_BEAM)
+typedef BeamPlanner Planner;
+#else
+typedef RolloutPlanner Planner;
+#endif
 
 /**
  * Shoot enemies before they collect all the incriminating data!
@@ -11,38 +57,111 @@ using namespace std;
  *close or you'll get killed.
  **/
 int main() {
+  InputReader input;
+  TurnClock clock;
+  GameState state;
+#if defined(FUZZY_THREADS)
+  ParallelPlanner<Planner> planner(
+      static_cast<int>(std::thread::hardware_concurrency()));
+#elif defined(FUZZY_MCTS)
+  Arena arena;
+  Planner planner(arena);
+#else
+  Planner planner;
+#endif
+  int initialEnemyCount = -1;
+  DivergenceTracker divergence;
+  Action played;
+#ifdef FUZZY_TRACE
+  PhaseTrace trace;
+#endif
+#ifdef FUZZY_REPLAY
+  ReplayWriter replay;
+  if (const char *path = std::getenv("FUZZY_REPLAY"))
+    replay.open(path);
+#endif
 
   // game loop
-  while (1) {
-    int x;
-    int y;
-    cin >> x >> y;
-    cin.ignore();
-    int dataCount;
-    cin >> dataCount;
-    cin.ignore();
-    for (int i = 0; i < dataCount; i++) {
-      int dataId;
-      int dataX;
-      int dataY;
-      cin >> dataId >> dataX >> dataY;
-      cin.ignore();
+  while (input.waitInput()) {
+    // The turn starts when its input arrives, parsing counts against it.
+    clock.startTurn();
+    {
+      FUZZY_PHASE(trace, PHASE_PARSE);
+      if (!input.readTurn(state))
+        break;
+    }
+
+    {
+      FUZZY_PHASE(trace, PHASE_RESET);
+      // An exact prediction keeps the slots, and with them the targets of
+      // the enemies and the trees of the planners.
+      if (divergence.hasPrediction()) {
+        bool exact = divergence.compare(state).exact();
+        divergence.printTurn(cerr);
+        if (exact)
+          state = divergence.prediction();
+      }
+      // Enemies only leave the game when they are killed.
+      if (initialEnemyCount < 0) {
+        initialEnemyCount = state.enemyCount;
+        for (int i = 0; i < state.enemyCount; i++)
+          state.initialTotalLife += state.enemyLives[i];
+      }
+      state.kills = initialEnemyCount - state.enemiesRemaining;
+
+      // The planners keep what they searched after the action played,
+      // nothing on the first turn.
+      planner.reset(state, played);
     }
-    int enemyCount;
-    cin >> enemyCount;
-    cin.ignore();
-    for (int i = 0; i < enemyCount; i++) {
-      int enemyId;
-      int enemyX;
-      int enemyY;
-      int enemyLife;
-      cin >> enemyId >> enemyX >> enemyY >> enemyLife;
-      cin.ignore();
+
+    {
+      FUZZY_PHASE(trace, PHASE_SEARCH);
+#ifdef FUZZY_THREADS
+      planner.run(clock);
+#else
+      runAnytime(planner, clock);
+#endif
     }
 
-    // Write an action using cout. DON'T FORGET THE "<< endl"
-    // To debug: cerr << "Debug messages..." << endl;
+    {
+      FUZZY_PHASE(trace, PHASE_OUTPUT);
+      double elapsed = clock.elapsedMs();
+      cerr << "rollouts " << planner.rollouts() << " ("
+           << static_cast<long>(planner.rollouts() / elapsed * 1000)
+           << "/s) value " << planner.bestValue() << " in " << elapsed
+           << " ms" << endl;
+#if defined(FUZZY_MCTS) && !defined(FUZZY_THREADS)
+      cerr << "depth " << planner.depth() << " nodes " << planner.nodes()
+           << " arena peak " << arena.peak() / 1024 << " KB" << endl;
+#elif defined(FUZZY_BEAM) && !defined(FUZZY_THREADS)
+      cerr << "width " << planner.width() << " duplicates "
+           << planner.duplicates() << endl;
+#endif
 
-    cout << "MOVE 0 0" << endl; // MOVE x y or SHOOT id
+      // A planner reusing its search may aim at an enemy dead since.
+      Action action = playableAction(state, planner.bestAction());
+      played = action;
+      divergence.predict(state, action);
+      if (action.type == Action::SHOOT) {
+        ++state.shots;
+        cout << "SHOOT " << state.enemyIds[action.enemy] << endl;
+      } else {
+        Vector2i destination(clampToMap(action.destination));
+        cout << "MOVE " << destination.x << ' ' << destination.y << endl;
+      }
+#ifdef FUZZY_REPLAY
+      // Once the action is out, the log does not count against the turn.
+      replay.write(state, &action, planner.rollouts(), planner.bestValue(),
+                   elapsed);
+#endif
+    }
+#ifdef FUZZY_TRACE
+    trace.endTurn(cerr);
+#endif
   }
+  divergence.printTotals(cerr);
+#ifdef FUZZY_TRACE
+  if (const char *path = std::getenv("FUZZY_TRACE_JSON"))
+    trace.writeChromeTrace(path);
+#endif
 }
@@ -0,0 +1,36 @@
+#include "AliveMask.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+TEST(AliveMask, SetAndReset) {
+  AliveMask<100> mask;
+  EXPECT_EQ(0u, mask.count());
+  mask.set(0);
+  mask.set(63);
+  mask.set(64);
+  mask.set(99);
+  EXPECT_TRUE(mask[63]);
+  EXPECT_TRUE(mask[64]);
+  EXPECT_FALSE(mask[65]);
+  EXPECT_EQ(4u, mask.count());
+  mask.reset(63);
+  EXPECT_FALSE(mask[63]);
+  EXPECT_EQ(3u, mask.count());
+  mask.clear();
+  EXPECT_EQ(0u, mask.count());
+}
+
+TEST(AliveMask, NextSkipsUnsetSlots) {
+  AliveMask<130> mask;
+  EXPECT_EQ(130u, mask.next(0));
+  mask.set(3);
+  mask.set(70);
+  mask.set(129);
+  EXPECT_EQ(3u, mask.next(0));
+  EXPECT_EQ(3u, mask.next(3));
+  EXPECT_EQ(70u, mask.next(4));
+  EXPECT_EQ(129u, mask.next(71));
+  EXPECT_EQ(130u, mask.next(130));
+}
+}
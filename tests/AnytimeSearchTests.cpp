@@ -0,0 +1,70 @@
+#include "AnytimeSearch.cpp"
+#include "TurnClock.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A search counting its iterations.
+*/
+struct CountingSearch {
+  unsigned long iterations;
+  CountingSearch() : iterations(0) {}
+  void iterate() { ++iterations; }
+};
+
+/*!
+* \brief A search over after 100 iterations.
+*/
+struct EndingSearch : CountingSearch {
+  bool isDone() const { return iterations >= 100; }
+};
+
+TEST(TurnClock, FirstTurnHasLongerBudget) {
+  TurnClock clock;
+  clock.startTurn();
+  EXPECT_EQ(1, clock.turn());
+  EXPECT_EQ(TurnClock::FIRST_TURN_BUDGET_MS, clock.budgetMs());
+  clock.startTurn();
+  EXPECT_EQ(2, clock.turn());
+  EXPECT_EQ(TurnClock::TURN_BUDGET_MS, clock.budgetMs());
+}
+
+TEST(TurnClock, Expired) {
+  TurnClock clock(50, 5);
+  clock.startTurn();
+  EXPECT_FALSE(clock.expired());
+  EXPECT_TRUE(clock.expired(60));
+  EXPECT_GE(clock.elapsedMs(), 0);
+  EXPECT_LE(clock.remainingMs(), 50);
+  EXPECT_GT(TurnClock::ticksPerMs(), 0);
+}
+
+TEST(RunAnytime, StopsBeforeTheMargin) {
+  TurnClock clock(1000, 20);
+  clock.startTurn();
+  clock.startTurn();
+  CountingSearch search;
+  unsigned long iterations = runAnytime(search, clock, AnytimeConfig(16, 10));
+  EXPECT_EQ(search.iterations, iterations);
+  EXPECT_GT(iterations, 0u);
+  EXPECT_EQ(0u, iterations % 16);
+  EXPECT_GE(clock.elapsedMs(), 10);
+  EXPECT_LT(clock.elapsedMs(), 20);
+}
+
+TEST(RunAnytime, StopsWhenTheSearchIsDone) {
+  TurnClock clock(1000, 1000);
+  clock.startTurn();
+  EndingSearch search;
+  EXPECT_EQ(112u, runAnytime(search, clock, AnytimeConfig(16, 10)));
+  EXPECT_LT(clock.elapsedMs(), 500);
+}
+
+TEST(RunAnytime, NoIterationWhenAlreadyExpired) {
+  TurnClock clock(5, 5);
+  clock.startTurn();
+  CountingSearch search;
+  EXPECT_EQ(0u, runAnytime(search, clock, AnytimeConfig(16, 10)));
+}
+}
@@ -0,0 +1,98 @@
+#include "Arena.cpp"
+#include "gtest/gtest.h"
+#include <cstdint>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief A node of the tests' trees, value is its index when created.
+*/
+struct TestNode {
+  NodePool<TestNode>::Index firstChild;
+  NodePool<TestNode>::Index nextSibling;
+  int value;
+};
+
+/*!
+* \brief Add a child in front of the children of parent.
+*/
+static int addChild(NodePool<TestNode> &pool, int parent) {
+  int child = pool.create();
+  pool[child].value = child;
+  pool[child].nextSibling = pool[parent].firstChild;
+  pool[parent].firstChild = child;
+  return child;
+}
+
+TEST(Arena, AllocatesAlignedMemoryUntilFull) {
+  Arena arena;
+  arena.reserve(256);
+  EXPECT_EQ(256u, arena.capacity());
+  void *a = arena.allocate(3, 1);
+  void *b = arena.allocate(8, 16);
+  ASSERT_NE(nullptr, a);
+  ASSERT_NE(nullptr, b);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(b) % 16);
+  EXPECT_EQ(nullptr, arena.allocate(512, 1));
+  std::size_t mark = arena.mark();
+  arena.allocate(100, 1);
+  arena.release(mark);
+  EXPECT_EQ(mark, arena.used());
+  arena.reset();
+  EXPECT_EQ(0u, arena.used());
+  EXPECT_EQ(mark + 100, arena.peak());
+}
+
+TEST(NodePool, CreatesContiguousNodes) {
+  Arena arena;
+  arena.reserve(4 * sizeof(TestNode));
+  NodePool<TestNode> pool(arena);
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(i, pool.create());
+  EXPECT_EQ(NodePool<TestNode>::NONE, pool.create());
+  EXPECT_EQ(&pool[0] + 3, &pool[3]);
+  pool.clear();
+  EXPECT_EQ(0, pool.size());
+  EXPECT_EQ(0, pool.create());
+}
+
+TEST(NodePool, KeepSubtreeMovesItToTheFront) {
+  Arena arena;
+  arena.reserve(64 * sizeof(TestNode));
+  NodePool<TestNode> pool(arena);
+  int root = pool.create();
+  int left = addChild(pool, root);
+  int right = addChild(pool, root);
+  int a = addChild(pool, right);
+  addChild(pool, left);
+  int b = addChild(pool, right);
+  int c = addChild(pool, a);
+
+  ASSERT_EQ(4, pool.keepSubtree(right));
+  EXPECT_EQ(4 * sizeof(TestNode), arena.used());
+  // Breadth first : right, then its children b and a, then c.
+  EXPECT_EQ(right, pool[0].value);
+  EXPECT_EQ(NodePool<TestNode>::NONE, pool[0].nextSibling);
+  EXPECT_EQ(1, pool[0].firstChild);
+  EXPECT_EQ(b, pool[1].value);
+  EXPECT_EQ(2, pool[1].nextSibling);
+  EXPECT_EQ(NodePool<TestNode>::NONE, pool[1].firstChild);
+  EXPECT_EQ(a, pool[2].value);
+  EXPECT_EQ(NodePool<TestNode>::NONE, pool[2].nextSibling);
+  EXPECT_EQ(3, pool[2].firstChild);
+  EXPECT_EQ(c, pool[3].value);
+  EXPECT_EQ(4, pool.create());
+}
+
+TEST(NodePool, KeepSubtreeClearsWhenTheArenaIsFull) {
+  Arena arena;
+  arena.reserve(4 * sizeof(TestNode));
+  NodePool<TestNode> pool(arena);
+  int root = pool.create();
+  int child = addChild(pool, root);
+  addChild(pool, child);
+  EXPECT_EQ(0, pool.keepSubtree(child));
+  EXPECT_EQ(0, pool.size());
+  EXPECT_EQ(0u, arena.used());
+}
+}
@@ -0,0 +1,81 @@
+#include "BeamPlanner.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Iterate planner until its widest search is over, and return the
+* number of iterations.
+*/
+static int searchToTheEnd(BeamPlanner &planner) {
+  int iterations = 0;
+  while (!planner.isDone() && iterations < 1000000) {
+    planner.iterate();
+    ++iterations;
+  }
+  return iterations;
+}
+
+TEST(BeamPlanner, ShootsTheEnemyAboutToCollect) {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(5000, 1000));
+  state.addEnemy(0, Vector2f(5400, 1000), 5);
+  state.initialTotalLife = 5;
+  BeamPlanner planner(0, 16, 4);
+  planner.reset(state);
+  // The root is expanded by reset.
+  EXPECT_EQ(static_cast<unsigned long>(BeamPlanner::MOVES + 1),
+            planner.rollouts());
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+  searchToTheEnd(planner);
+  EXPECT_TRUE(planner.isDone());
+  EXPECT_EQ(16, planner.width());
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+  EXPECT_EQ(0, planner.bestAction().enemy);
+  EXPECT_GT(planner.bestValue(), 100);
+
+  unsigned long rollouts = planner.rollouts();
+  planner.iterate();
+  EXPECT_EQ(rollouts, planner.rollouts());
+}
+
+TEST(BeamPlanner, DropsDuplicateStates) {
+  // From the corner, every move down or left stays in the corner.
+  GameState state;
+  state.wolff.set(0, 0);
+  state.addDataPoint(0, Vector2f(15000, 8000));
+  state.addEnemy(0, Vector2f(9000, 8000), 50);
+  state.initialTotalLife = 50;
+  BeamPlanner planner(0, 32, 2);
+  planner.reset(state);
+  searchToTheEnd(planner);
+  EXPECT_GE(planner.duplicates(), 8u);
+  EXPECT_EQ(Action::MOVE, planner.bestAction().type);
+}
+
+TEST(BeamPlanner, IsDeterministic) {
+  GameState state;
+  state.wolff.set(8000, 4500);
+  state.addDataPoint(0, Vector2f(1000, 1000));
+  state.addDataPoint(1, Vector2f(15000, 8000));
+  for (int i = 0; i < 6; ++i)
+    state.addEnemy(i, Vector2f(3000.0f + i * 2000, 500.0f + i * 1200), 12);
+  state.initialTotalLife = 72;
+  BeamPlanner first(1, 16, 3);
+  BeamPlanner second(2, 16, 3);
+  first.reset(state);
+  second.reset(state);
+  int iterations = searchToTheEnd(first);
+  EXPECT_EQ(iterations, searchToTheEnd(second));
+  EXPECT_TRUE(first.bestAction() == second.bestAction());
+  EXPECT_EQ(first.bestValue(), second.bestValue());
+
+  // A new turn starts the narrow search again.
+  GameState next = state;
+  simulate(next, first.bestAction());
+  first.reset(next);
+  EXPECT_EQ(BeamPlanner::MIN_WIDTH, first.width());
+  EXPECT_FALSE(first.isDone());
+}
+}
@@ -0,0 +1,72 @@
+#include "Damage.cpp"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstring>
+
+namespace fuzzyTelegram {
+
+TEST(ShotDamage, ReferenceValues) {
+  EXPECT_EQ(14, shotDamage(2000));
+  EXPECT_EQ(1, shotDamage(18358));
+  EXPECT_EQ(125000, shotDamage(0));
+}
+
+TEST(DamageTable, MatchesTheFormulaOverTheMap) {
+  // Every whole distance of the map, along an axis and along the diagonal
+  // of the map, as simulate computed them.
+  for (int d = 0; d <= 18358; ++d) {
+    Vector2f axis(static_cast<float>(d), 0);
+    ASSERT_EQ(shotDamage(Vector2f::distance(axis, Vector2f::zero())),
+              shotDamageSquared(axis.squaredMagnitude()))
+        << "distance " << d;
+    Vector2f diagonal(d * (16000.0f / 18357.6f), d * (9000.0f / 18357.6f));
+    ASSERT_EQ(shotDamage(Vector2f::distance(diagonal, Vector2f::zero())),
+              shotDamageSquared(diagonal.squaredMagnitude()))
+        << "diagonal " << d;
+  }
+}
+
+TEST(DamageTable, MatchesTheFormulaOverTheBuckets) {
+  // A sample of all the floats of the table, and every damage boundary with
+  // its neighbours.
+  std::uint32_t first;
+  std::uint32_t last;
+  float low = std::ldexp(1.0f, DamageTable::MIN_EXPONENT - 1);
+  float high = std::ldexp(1.0f, DamageTable::MAX_EXPONENT + 1);
+  std::memcpy(&first, &low, sizeof(first));
+  std::memcpy(&last, &high, sizeof(last));
+  for (std::uint32_t bits = first; bits < last; bits += 97) {
+    float squaredDistance;
+    std::memcpy(&squaredDistance, &bits, sizeof(squaredDistance));
+    ASSERT_EQ(shotDamage(std::sqrt(squaredDistance)),
+              shotDamageSquared(squaredDistance))
+        << "squared distance " << squaredDistance;
+  }
+
+  DamageTable table;
+  for (int damage = 1; damage <= DamageTable::MAX_DAMAGE; ++damage) {
+    float reach = table.reach(damage);
+    EXPECT_GE(shotDamage(std::sqrt(reach)), damage);
+    EXPECT_LT(shotDamage(std::sqrt(std::nextafter(reach, INFINITY))), damage);
+    for (float s : {std::nextafter(reach, 0.0f), reach,
+                    std::nextafter(reach, INFINITY)})
+      EXPECT_EQ(shotDamage(std::sqrt(s)), table.damage(s)) << damage;
+  }
+}
+
+TEST(DamageTable, OutOfTheTable) {
+  EXPECT_EQ(125000, shotDamageSquared(0));
+  EXPECT_EQ(125000, shotDamageSquared(1));
+  EXPECT_EQ(shotDamage(100), shotDamageSquared(10000));
+  EXPECT_EQ(0, shotDamageSquared(1e12f));
+}
+
+TEST(ShotsToKill, RoundsUp) {
+  // 14 damage at 2000, 1 at the far corner.
+  EXPECT_EQ(1, shotsToKill(14, 2000.0f * 2000.0f));
+  EXPECT_EQ(2, shotsToKill(15, 2000.0f * 2000.0f));
+  EXPECT_EQ(10, shotsToKill(10, 18358.0f * 18358.0f));
+  EXPECT_EQ(0, shotsToKill(0, 100));
+  EXPECT_EQ(-1, shotsToKill(10, 1e12f));
+}
+}
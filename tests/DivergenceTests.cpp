@@ -0,0 +1,113 @@
+#include "Divergence.cpp"
+#include "gtest/gtest.h"
+#include <sstream>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return the state the bot parses for state : its alive entities in
+* new slots.
+*/
+static GameState parsed(const GameState &state) {
+  GameState result;
+  result.wolff = state.wolff;
+  for (int i = 0; i < state.dataCount; ++i)
+    if (state.dataAlive[i])
+      result.addDataPoint(state.dataIds[i], state.dataPositions[i]);
+  for (int i = 0; i < state.enemyCount; ++i)
+    if (state.enemyAlive[i])
+      result.addEnemy(state.enemyIds[i], state.enemyPositions[i],
+                      state.enemyLives[i]);
+  result.initialTotalLife = state.initialTotalLife;
+  result.shots = state.shots;
+  result.kills = state.kills;
+  return result;
+}
+
+static GameState divergenceState() {
+  GameState state;
+  state.wolff.set(8000, 4000);
+  state.addDataPoint(0, Vector2f(1000, 1000));
+  state.addDataPoint(3, Vector2f(15000, 8000));
+  state.addEnemy(2, Vector2f(7000, 1500), 1);
+  state.addEnemy(5, Vector2f(14500, 7700), 30);
+  state.addEnemy(9, Vector2f(1200, 8000), 10);
+  return state;
+}
+
+TEST(Divergence, ExactAfterAKill) {
+  GameState root = divergenceState();
+  DivergenceTracker tracker;
+  EXPECT_FALSE(tracker.hasPrediction());
+  tracker.predict(root, Action::shoot(0));
+  ASSERT_TRUE(tracker.hasPrediction());
+  GameState next = root;
+  simulate(next, Action::shoot(0));
+  ASSERT_EQ(2, next.enemiesRemaining);
+
+  const Divergence &divergence = tracker.compare(parsed(next));
+  EXPECT_TRUE(divergence.exact());
+  EXPECT_EQ(2, divergence.enemies);
+  EXPECT_FALSE(tracker.hasPrediction());
+  EXPECT_EQ(1, tracker.exactTurns());
+
+  // The prediction keeps the slot of the dead enemy, and valid targets.
+  GameState adopted = tracker.prediction();
+  EXPECT_EQ(3, adopted.enemyCount);
+  EXPECT_EQ(0, updateTargets(adopted));
+  EXPECT_TRUE(verifyTargets(adopted));
+}
+
+TEST(Divergence, CountsWhatDiffers) {
+  GameState root = divergenceState();
+  DivergenceTracker tracker;
+  tracker.predict(root, Action::move(Vector2f(9000, 4000)));
+  GameState next = root;
+  simulate(next, Action::move(Vector2f(9000, 4000)));
+  GameState observed = parsed(next);
+  observed.wolff.x += 3;
+  observed.enemyPositions.set(1, observed.enemyPositions[1] + Vector2f(0, 4));
+  observed.enemyLives[2] = 7;
+  observed.removeDataPoint(0);
+
+  const Divergence &divergence = tracker.compare(observed);
+  EXPECT_FALSE(divergence.exact());
+  EXPECT_EQ(3, divergence.wolffError);
+  EXPECT_EQ(3, divergence.enemies);
+  EXPECT_EQ(1, divergence.enemiesMoved);
+  EXPECT_EQ(4, divergence.maxEnemyError);
+  EXPECT_EQ(1, divergence.livesChanged);
+  EXPECT_EQ(0, divergence.enemiesMissed);
+  EXPECT_EQ(1, divergence.dataMissed);
+
+  std::ostringstream out;
+  tracker.printTurn(out);
+  EXPECT_EQ(0u, out.str().find("prediction off : wolff 3"));
+  EXPECT_NE(std::string::npos, out.str().find("  enemy 5 predicted"));
+  EXPECT_NE(std::string::npos, out.str().find("  enemy 9 predicted"));
+  tracker.printTotals(out);
+  EXPECT_NE(std::string::npos, out.str().find("predictions exact 0/1"));
+}
+
+TEST(Divergence, MatchesEnemiesById) {
+  GameState root = divergenceState();
+  DivergenceTracker tracker;
+  tracker.predict(root, Action::move(root.wolff));
+  GameState next = root;
+  simulate(next, Action::move(root.wolff));
+  // Enemy 5 is missing and an enemy 7 appeared.
+  GameState observed;
+  observed.wolff = next.wolff;
+  for (int i = 0; i < next.dataCount; ++i)
+    observed.addDataPoint(next.dataIds[i], next.dataPositions[i]);
+  observed.addEnemy(2, next.enemyPositions[0], next.enemyLives[0]);
+  observed.addEnemy(7, Vector2f(5000, 5000), 10);
+  observed.addEnemy(9, next.enemyPositions[2], next.enemyLives[2]);
+
+  const Divergence &divergence = tracker.compare(observed);
+  EXPECT_EQ(2, divergence.enemies);
+  EXPECT_EQ(0, divergence.enemiesMoved);
+  EXPECT_EQ(2, divergence.enemiesMissed);
+  EXPECT_FALSE(divergence.exact());
+}
+}
@@ -0,0 +1,45 @@
+#include "EvolutionPlanner.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+TEST(Gene, DecodeMove) {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  Gene gene = {Gene::MOVE, 0, 16384, 500};
+  Action action = gene.decode(state);
+  EXPECT_EQ(Action::MOVE, action.type);
+  EXPECT_NEAR(1000, action.destination.x, 0.1f);
+  EXPECT_NEAR(1500, action.destination.y, 0.1f);
+}
+
+TEST(Gene, DecodeShootAtDeadEnemyShootsClosest) {
+  GameState state;
+  state.wolff.set(0, 0);
+  state.addEnemy(0, Vector2f(5000, 0), 10);
+  state.addEnemy(1, Vector2f(9000, 0), 10);
+  state.addEnemy(2, Vector2f(3000, 0), 10);
+  Gene gene = {Gene::SHOOT, 1, 0, 0};
+  EXPECT_EQ(1, gene.decode(state).enemy);
+  state.removeEnemy(1);
+  EXPECT_EQ(2, gene.decode(state).enemy);
+}
+
+TEST(EvolutionPlanner, ShootsTheEnemyAboutToCollect) {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(5000, 1000));
+  state.addEnemy(0, Vector2f(5400, 1000), 5);
+  state.initialTotalLife = 5;
+  EvolutionPlanner planner(42);
+  planner.reset(state);
+  EXPECT_EQ(static_cast<unsigned long>(EvolutionPlanner::POPULATION),
+            planner.rollouts());
+  for (int i = 0; i < 200; ++i)
+    planner.iterate();
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+  EXPECT_GT(planner.bestValue(), 100);
+  planner.reset(state);
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+}
+}
@@ -0,0 +1,95 @@
+#include "InputReader.cpp"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <unistd.h>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return the read end of a pipe already holding text.
+*/
+static int pipeWith(const char *text) {
+  int fds[2];
+  if (pipe(fds) != 0)
+    return -1;
+  ssize_t written = write(fds[1], text, strlen(text));
+  close(fds[1]);
+  return written < 0 ? -1 : fds[0];
+}
+
+TEST(InputReader, ReadInts) {
+  int fd = pipeWith("12 -7\n0\n  345");
+  InputReader input(fd);
+  int a, b, c, d, e;
+  EXPECT_TRUE(input.readInt(a));
+  EXPECT_TRUE(input.readInt(b));
+  EXPECT_TRUE(input.readInt(c));
+  EXPECT_TRUE(input.readInt(d));
+  EXPECT_EQ(12, a);
+  EXPECT_EQ(-7, b);
+  EXPECT_EQ(0, c);
+  EXPECT_EQ(345, d);
+  EXPECT_FALSE(input.readInt(e));
+  EXPECT_TRUE(input.eof());
+  close(fd);
+}
+
+TEST(InputReader, StreamExtraction) {
+  int fd = pipeWith("2 5\n");
+  InputReader input(fd);
+  Vector2i v;
+  input >> v;
+  EXPECT_EQ(2, v.x);
+  EXPECT_EQ(5, v.y);
+  close(fd);
+}
+
+TEST(InputReader, ReadTurn) {
+  int fd = pipeWith("1100 1200\n2\n0 8250 4500\n1 8250 8999\n"
+                    "1\n0 3100 8000 10\n"
+                    "1200 1200\n1\n1 8250 8999\n0\n");
+  InputReader input(fd);
+  GameState state;
+  state.shots = 3;
+  EXPECT_TRUE(input.readTurn(state));
+  EXPECT_EQ(1100, state.wolff.x);
+  EXPECT_EQ(1200, state.wolff.y);
+  EXPECT_EQ(2, state.dataCount);
+  EXPECT_EQ(1, state.dataIds[1]);
+  EXPECT_EQ(8999, state.dataPositions[1].y);
+  EXPECT_EQ(1, state.enemyCount);
+  EXPECT_EQ(3100, state.enemyPositions[0].x);
+  EXPECT_EQ(10, state.enemyLives[0]);
+  EXPECT_EQ(3, state.shots);
+  EXPECT_TRUE(input.readTurn(state));
+  EXPECT_EQ(1, state.dataCount);
+  EXPECT_EQ(0, state.enemyCount);
+  EXPECT_FALSE(input.readTurn(state));
+  close(fd);
+}
+
+TEST(InputReader, RejectsCountsAStateCannotHold) {
+  int fd = pipeWith("1100 1200\n101\n");
+  InputReader input(fd);
+  GameState state;
+  EXPECT_FALSE(input.readTurn(state));
+  close(fd);
+  fd = pipeWith("1100 1200\n1\n0 8250 4500\n-1\n");
+  InputReader negative(fd);
+  EXPECT_FALSE(negative.readTurn(state));
+  EXPECT_EQ(1, state.dataCount);
+  close(fd);
+}
+
+TEST(InputReader, WaitInputSkipsSeparators) {
+  int fd = pipeWith(" \n-3\n\n");
+  InputReader input(fd);
+  EXPECT_TRUE(input.waitInput());
+  int value;
+  EXPECT_TRUE(input.readInt(value));
+  EXPECT_EQ(-3, value);
+  EXPECT_FALSE(input.waitInput());
+  EXPECT_TRUE(input.eof());
+  close(fd);
+}
+}
@@ -1,4 +1,25 @@
 #include "Vector2Tests.cpp"
+#include "MathPolicyTests.cpp"
+#include "Vector2BatchTests.cpp"
+#include "SpatialGridTests.cpp"
+#include "AliveMaskTests.cpp"
+#include "DamageTests.cpp"
+#include "SimulatorTests.cpp"
+#include "DivergenceTests.cpp"
+#include "ThreatMapTests.cpp"
+#include "StateHistoryTests.cpp"
+#include "ArenaTests.cpp"
+#include "InputReaderTests.cpp"
+#include "AnytimeSearchTests.cpp"
+#include "RandomTests.cpp"
+#include "RolloutPlannerTests.cpp"
+#include "EvolutionPlannerTests.cpp"
+#include "MctsPlannerTests.cpp"
+#include "BeamPlannerTests.cpp"
+#include "ParallelPlannerTests.cpp"
+#include "PhaseTraceTests.cpp"
+#include "ReplayLogTests.cpp"
+#include "RefereeTests.cpp"
 #include "gtest/gtest.h"
 
 int main(int argc, char **argv) {
@@ -0,0 +1,72 @@
+#include "MathPolicy.hpp"
+#include "Vector2.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+
+namespace fuzzyTelegram {
+
+TEST(FastMath, RsqrtRelativeError) {
+  float worst = 0;
+  for (float x = 1e-3f; x < 1e9f; x *= 1.01f)
+    worst = std::max(worst, std::fabs(FastMath::rsqrt(x) * std::sqrt(x) - 1));
+  EXPECT_LT(worst, 2e-6f);
+}
+
+TEST(FastMath, SqrtOfZeroAndNegative) {
+  EXPECT_EQ(0, FastMath::sqrt(0));
+  EXPECT_EQ(0, FastMath::sqrt(-4));
+  EXPECT_NEAR(18357.6f, FastMath::sqrt(16000.0f * 16000 + 9000.0f * 9000),
+              0.1f);
+}
+
+TEST(FastMath, AcosAbsoluteError) {
+  double worst = 0;
+  for (int i = -10000; i <= 10000; ++i) {
+    float x = i / 10000.0f;
+    double error = FastMath::acos(x) - std::acos(static_cast<double>(x));
+    worst = std::max(worst, std::fabs(error));
+  }
+  EXPECT_LT(worst, 7e-5);
+}
+
+TEST(FastMath, Atan2AbsoluteError) {
+  double worst = 0;
+  for (int i = 0; i < 3600; ++i) {
+    double angle = i * M_PI / 1800;
+    float x = static_cast<float>(std::cos(angle) * 1234);
+    float y = static_cast<float>(std::sin(angle) * 1234);
+    double error = std::fabs(FastMath::atan2(y, x) - std::atan2(y, x));
+    worst = std::max(worst, std::min(error, 2 * M_PI - error));
+  }
+  EXPECT_LT(worst, 1e-5);
+  EXPECT_EQ(0, FastMath::atan2(0, 0));
+}
+
+TEST(FastMath, Vector2Methods) {
+  Vector2f v(300, -400);
+  EXPECT_NEAR(500, v.magnitude<FastMath>(), 0.01f);
+  Vector2f n = v.normalized<FastMath>();
+  EXPECT_NEAR(0.6f, n.x, 1e-5f);
+  EXPECT_NEAR(-0.8f, n.y, 1e-5f);
+  EXPECT_NEAR(90, Vector2f::angle<FastMath>(Vector2f(3, 4), Vector2f(-8, 6)),
+              0.01f);
+  EXPECT_NEAR(11.66f,
+              Vector2f::distance<FastMath>(Vector2f(-3, 5), Vector2f(7, -1)),
+              0.01f);
+}
+
+TEST(SquaredComparisons, WithinAndCloser) {
+  static_assert(Vector2i::squaredDistance(Vector2i(1, 1), Vector2i(4, 5)) ==
+                    25,
+                "squaredDistance");
+  static_assert(Vector2i::isWithin(Vector2i(0, 0), Vector2i(3, 4), 5),
+                "isWithin on the circle");
+  static_assert(!Vector2i::isWithin(Vector2i(0, 0), Vector2i(3, 4), 4.9f),
+                "isWithin outside");
+  EXPECT_TRUE(Vector2f::isCloser(Vector2f::zero(), Vector2f(1, 1),
+                                 Vector2f(0, 2)));
+  EXPECT_FALSE(Vector2f::isCloser(Vector2f::zero(), Vector2f(2, 0),
+                                  Vector2f(0, 2)));
+}
+}
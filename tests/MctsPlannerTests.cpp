@@ -0,0 +1,123 @@
+#include "MctsPlanner.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+TEST(MctsPlanner, ShootsTheEnemyAboutToCollect) {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(5000, 1000));
+  state.addEnemy(0, Vector2f(5400, 1000), 5);
+  state.initialTotalLife = 5;
+  Arena arena;
+  arena.reserve(1 << 20);
+  MctsPlanner planner(arena, 42);
+  planner.reset(state);
+  for (int i = 0; i < 500; ++i)
+    planner.iterate();
+  EXPECT_EQ(500u, planner.rollouts());
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+  EXPECT_EQ(0, planner.bestAction().enemy);
+  EXPECT_GT(planner.bestValue(), 100);
+}
+
+TEST(MctsPlanner, WidensProgressively) {
+  GameState state;
+  state.wolff.set(8000, 4500);
+  state.addDataPoint(0, Vector2f(1000, 1000));
+  for (int i = 0; i < 10; ++i)
+    state.addEnemy(i, Vector2f(14000, 500.0f + i * 800), 20);
+  state.initialTotalLife = 200;
+  Arena arena;
+  arena.reserve(1 << 20);
+  MctsPlanner planner(arena, 3);
+  planner.reset(state);
+  for (int i = 0; i < 100; ++i)
+    planner.iterate();
+  // The root has at most 1 + sqrt(99) children, and every node one per
+  // playout at most.
+  EXPECT_LE(planner.nodes(), 101);
+  EXPECT_GT(planner.nodes(), 11);
+  EXPECT_GT(planner.depth(), 1);
+}
+
+TEST(MctsPlanner, ReusesTheTreeWhenNoEntityLeft) {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(15000, 8000));
+  state.addEnemy(0, Vector2f(9000, 1000), 50);
+  state.initialTotalLife = 50;
+  Arena arena;
+  arena.reserve(1 << 20);
+  MctsPlanner planner(arena, 9);
+  planner.reset(state);
+  for (int i = 0; i < 300; ++i)
+    planner.iterate();
+  int nodes = planner.nodes();
+
+  GameState next = state;
+  simulate(next, planner.bestAction());
+  planner.reset(next);
+  EXPECT_GT(planner.nodes(), 1);
+  EXPECT_LT(planner.nodes(), nodes);
+
+  next.clear();
+  next.wolff.set(1000, 1000);
+  next.addDataPoint(0, Vector2f(15000, 8000));
+  next.addDataPoint(1, Vector2f(1000, 8000));
+  next.addEnemy(0, Vector2f(9000, 1000), 50);
+  planner.reset(next);
+  EXPECT_EQ(1, planner.nodes());
+}
+
+TEST(MctsPlanner, KeepsTheSubtreeOfTheActionPlayed) {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(15000, 8000));
+  state.addEnemy(0, Vector2f(9000, 1000), 50);
+  state.initialTotalLife = 50;
+  Arena arena;
+  arena.reserve(1 << 20);
+  MctsPlanner planner(arena, 9);
+  planner.reset(state);
+  for (int i = 0; i < 300; ++i)
+    planner.iterate();
+  ActionStatistics children[64];
+  int count = planner.rootStatistics(children, 64);
+  ASSERT_GT(count, 1);
+  // The most visited child but the one the planner would play.
+  int second = -1;
+  for (int i = 0; i < count; ++i)
+    if (!(children[i].action == planner.bestAction()) &&
+        (second < 0 || children[i].visits > children[second].visits))
+      second = i;
+  ASSERT_GT(children[second].visits, 2);
+
+  GameState next = state;
+  simulate(next, children[second].action);
+  planner.reset(next, children[second].action);
+  EXPECT_GT(planner.nodes(), 1);
+  EXPECT_LE(planner.nodes(), children[second].visits);
+
+  // No child plays it : the tree starts again.
+  for (int i = 0; i < 300; ++i)
+    planner.iterate();
+  planner.reset(next, Action::move(Vector2f(1234, 5678)));
+  EXPECT_EQ(1, planner.nodes());
+}
+
+TEST(MctsPlanner, KeepsPlayingWhenTheArenaIsFull) {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(15000, 8000));
+  state.addEnemy(0, Vector2f(9000, 1000), 50);
+  Arena arena;
+  arena.reserve(8 * sizeof(MctsNode));
+  MctsPlanner planner(arena, 1);
+  planner.reset(state);
+  for (int i = 0; i < 100; ++i)
+    planner.iterate();
+  EXPECT_EQ(8, planner.nodes());
+  EXPECT_EQ(100u, planner.rollouts());
+}
+}
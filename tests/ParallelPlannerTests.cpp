@@ -0,0 +1,104 @@
+#include "ParallelPlanner.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return a state where the only enemy collects the only data point next
+* turn unless Wolff kills it now.
+*/
+static GameState parallelLastChanceState() {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(5000, 1000));
+  state.addEnemy(0, Vector2f(5400, 1000), 5);
+  state.initialTotalLife = 5;
+  return state;
+}
+
+TEST(ParallelPlanner, RolloutThreadsAgreeToShoot) {
+  ParallelPlanner<RolloutPlanner> planner(4, 1);
+  EXPECT_EQ(4, planner.threads());
+  planner.reset(parallelLastChanceState());
+  TurnClock clock(20, 20);
+  clock.startTurn();
+  unsigned long iterations = planner.run(clock, AnytimeConfig(16, 5));
+  EXPECT_GT(iterations, 0u);
+  EXPECT_EQ(iterations + 4, planner.rollouts());
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+  EXPECT_EQ(0, planner.bestAction().enemy);
+  EXPECT_GT(planner.bestValue(), 100);
+}
+
+TEST(ParallelPlanner, MergesTreeStatistics) {
+  ParallelPlanner<MctsPlanner> planner(3, 5);
+  planner.reset(parallelLastChanceState());
+  TurnClock clock(20, 20);
+  clock.startTurn();
+  unsigned long iterations = planner.run(clock, AnytimeConfig(16, 5));
+  EXPECT_EQ(iterations, planner.rollouts());
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+  EXPECT_GT(planner.bestValue(), 100);
+}
+
+/*!
+* \brief A planner whose best action depends on its seed, and that records the
+* action it is told was played.
+*/
+class DisagreeingPlanner {
+
+public:
+  static Action played[2];
+
+  explicit DisagreeingPlanner(unsigned seed) : seed(seed) {}
+
+  void reset(const GameState &, const Action &action) {
+    played[seed] = action;
+  }
+
+  void reset(const GameState &root) { reset(root, bestAction()); }
+
+  void iterate() {}
+
+  Action bestAction() const {
+    return seed == 0 ? Action::move(Vector2f(100, 100)) : Action::shoot(0);
+  }
+
+  float bestValue() const { return 0; }
+
+  unsigned long rollouts() const { return 0; }
+
+  int rootStatistics(ActionStatistics *out, int) const {
+    out[0].action = bestAction();
+    out[0].valueSum = 1;
+    out[0].visits = seed == 0 ? 3 : 1;
+    return 1;
+  }
+
+private:
+  unsigned seed;
+};
+
+Action DisagreeingPlanner::played[2];
+
+TEST(ParallelPlanner, ResetsEveryThreadWithTheActionPlayed) {
+  ParallelPlanner<DisagreeingPlanner> planner(2, 0);
+  GameState state = parallelLastChanceState();
+  planner.reset(state);
+  Action merged = planner.bestAction();
+  EXPECT_TRUE(merged == Action::move(Vector2f(100, 100)));
+
+  // The second thread preferred to shoot, it learns that Wolff moved.
+  planner.reset(state);
+  EXPECT_TRUE(DisagreeingPlanner::played[0] == merged);
+  EXPECT_TRUE(DisagreeingPlanner::played[1] == merged);
+  planner.reset(state, Action::shoot(0));
+  EXPECT_TRUE(DisagreeingPlanner::played[0] == Action::shoot(0));
+  EXPECT_TRUE(DisagreeingPlanner::played[1] == Action::shoot(0));
+}
+
+TEST(ParallelPlanner, ClampsTheNumberOfThreads) {
+  ParallelPlanner<EvolutionPlanner> planner(0);
+  EXPECT_EQ(1, planner.threads());
+}
+}
@@ -0,0 +1,71 @@
+#include "PhaseTrace.cpp"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace fuzzyTelegram {
+
+TEST(PhaseTrace, SumsThePhasesOfTheTurn) {
+  PhaseTrace trace;
+  const std::uint64_t ms = static_cast<std::uint64_t>(TurnClock::ticksPerMs());
+  trace.record(PHASE_PARSE, 0, ms);
+  trace.record(PHASE_SEARCH, ms, 5 * ms);
+  trace.record(PHASE_SEARCH, 6 * ms, 7 * ms);
+  EXPECT_NEAR(1, trace.turnMs(PHASE_PARSE), 0.01);
+  EXPECT_NEAR(5, trace.turnMs(PHASE_SEARCH), 0.01);
+  EXPECT_EQ(0, trace.turnMs(PHASE_OUTPUT));
+
+  std::ostringstream out;
+  trace.endTurn(out);
+  EXPECT_EQ(0u, out.str().find("turn 0 parse 1.0"));
+  EXPECT_NE(std::string::npos, out.str().find(" search 5.0"));
+  EXPECT_EQ(0, trace.turnMs(PHASE_SEARCH));
+  trace.record(PHASE_OUTPUT, 8 * ms, 9 * ms);
+  EXPECT_EQ(1, trace.event(3).turn);
+}
+
+TEST(PhaseTrace, KeepsTheLastEvents) {
+  PhaseTrace trace;
+  for (int i = 0; i < PhaseTrace::CAPACITY + 10; ++i)
+    trace.record(PHASE_RESET, i, i + 1);
+  EXPECT_EQ(PhaseTrace::CAPACITY, trace.size());
+  EXPECT_EQ(10u, trace.event(0).start);
+  EXPECT_EQ(static_cast<std::uint64_t>(PhaseTrace::CAPACITY + 9),
+            trace.event(PhaseTrace::CAPACITY - 1).start);
+}
+
+TEST(PhaseTrace, ScopesRecordTheirPhase) {
+  PhaseTrace trace;
+  {
+    FUZZY_PHASE(trace, PHASE_SEARCH);
+    FUZZY_PHASE(trace, PHASE_OUTPUT);
+  }
+  ASSERT_EQ(2, trace.size());
+  EXPECT_EQ(PHASE_OUTPUT, trace.event(0).phase);
+  EXPECT_EQ(PHASE_SEARCH, trace.event(1).phase);
+  EXPECT_LE(trace.event(1).start, trace.event(0).start);
+  EXPECT_GE(trace.event(1).end, trace.event(0).end);
+}
+
+TEST(PhaseTrace, WritesAChromeTrace) {
+  PhaseTrace trace;
+  trace.record(PHASE_PARSE, 100, 200);
+  trace.record(PHASE_SEARCH, 200, 900);
+  char path[] = "/tmp/traceXXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+  ASSERT_TRUE(trace.writeChromeTrace(path));
+  std::ifstream file(path);
+  std::stringstream text;
+  text << file.rdbuf();
+  EXPECT_EQ(0u, text.str().find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, text.str().find("\"name\":\"parse\""));
+  EXPECT_NE(std::string::npos,
+            text.str().find("\"name\":\"search\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, text.str().find("\n]}"));
+  std::remove(path);
+}
+}
@@ -0,0 +1,122 @@
+#include "Random.cpp"
+#include "RandomBatch.cpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+
+namespace fuzzyTelegram {
+
+TEST(FastRandom, SameSeedSameNumbers) {
+  // Replays depend on these numbers : they must not change.
+  FastRandom random(1);
+  EXPECT_EQ(1695105466u, random());
+  EXPECT_EQ(1423115009u, random());
+  EXPECT_EQ(634581793u, random());
+  random.seed(1);
+  EXPECT_EQ(1695105466u, random());
+  FastRandom other(2);
+  EXPECT_NE(1695105466u, other());
+}
+
+TEST(FastRandom, BelowCoversTheRange) {
+  FastRandom random(3);
+  int counts[7] = {};
+  for (int i = 0; i < 70000; ++i) {
+    std::uint32_t value = random.below(7);
+    ASSERT_LT(value, 7u);
+    ++counts[value];
+  }
+  for (int count : counts)
+    EXPECT_NEAR(10000, count, 500);
+  EXPECT_EQ(0u, random.below(1));
+}
+
+TEST(FastRandom, RangeIsInclusive) {
+  FastRandom random(4);
+  int low = 0;
+  int high = 0;
+  for (int i = 0; i < 1000; ++i) {
+    int value = random.range(-2, 2);
+    ASSERT_GE(value, -2);
+    ASSERT_LE(value, 2);
+    low += value == -2;
+    high += value == 2;
+  }
+  EXPECT_GT(low, 0);
+  EXPECT_GT(high, 0);
+}
+
+TEST(FastRandom, UnitAndCoin) {
+  FastRandom random(5);
+  float sum = 0;
+  int heads = 0;
+  for (int i = 0; i < 10000; ++i) {
+    float value = random.unit();
+    ASSERT_GE(value, 0.0f);
+    ASSERT_LT(value, 1.0f);
+    sum += value;
+    heads += random.coin();
+  }
+  EXPECT_NEAR(0.5f, sum / 10000, 0.02f);
+  EXPECT_NEAR(5000, heads, 250);
+}
+
+TEST(FastRandom, DirectionsAndDiscs) {
+  FastRandom random(6);
+  Vector2f mean;
+  int inner = 0;
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_NEAR(1, random.direction().magnitude(), 1e-5f);
+    Vector2f point = random.inDisc(1000);
+    ASSERT_LE(point.magnitude(), 1000.5f);
+    mean += point / 10000.0f;
+    inner += point.magnitude() < 500;
+  }
+  EXPECT_NEAR(0, mean.x, 30);
+  EXPECT_NEAR(0, mean.y, 30);
+  // A quarter of the area of the disc is within half of its radius.
+  EXPECT_NEAR(2500, inner, 200);
+}
+
+TEST(FastRandom, WorksWithStdAlgorithms) {
+  FastRandom random(7);
+  int values[5] = {0, 1, 2, 3, 4};
+  std::shuffle(values, values + 5, random);
+  std::sort(values, values + 5);
+  for (int i = 0; i < 5; ++i)
+    EXPECT_EQ(i, values[i]);
+}
+
+TEST(FastRandomBatch, LanesAreIndependent) {
+  FastRandomBatch<8> batch(1);
+  std::uint32_t first[8];
+  batch.fill(first, 8);
+  for (int i = 0; i < 8; ++i)
+    for (int j = i + 1; j < 8; ++j)
+      EXPECT_NE(first[i], first[j]);
+  FastRandomBatch<8> same(1);
+  std::uint32_t again[11];
+  same.fill(again, 11);
+  for (int i = 0; i < 8; ++i)
+    EXPECT_EQ(first[i], again[i]);
+}
+
+TEST(FastRandomBatch, FillsInRange) {
+  FastRandomBatch<> batch(2);
+  std::uint32_t indices[101];
+  batch.fillBelow(indices, 101, 24);
+  for (std::uint32_t index : indices)
+    EXPECT_LT(index, 24u);
+  float units[37];
+  batch.fillUnit(units, 37);
+  for (float unit : units) {
+    EXPECT_GE(unit, 0.0f);
+    EXPECT_LT(unit, 1.0f);
+  }
+  float xs[50];
+  float ys[50];
+  Vector2f center(8000, 4500);
+  batch.fillInDisc(xs, ys, 50, center, 1000);
+  for (int i = 0; i < 50; ++i)
+    EXPECT_LE(Vector2f::distance(Vector2f(xs[i], ys[i]), center), 1000.5f);
+}
+}
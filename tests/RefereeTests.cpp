@@ -0,0 +1,201 @@
+#include "Referee.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+TEST(RandomMap, DependsOnlyOnTheSeed) {
+  FastRandom first(42);
+  FastRandom second(42);
+  GameState a = randomMap(first);
+  GameState b = randomMap(second);
+  EXPECT_EQ(a.wolff, b.wolff);
+  ASSERT_EQ(a.enemyCount, b.enemyCount);
+  for (int i = 0; i < a.enemyCount; ++i) {
+    EXPECT_EQ(a.enemyPositions[i], b.enemyPositions[i]);
+    EXPECT_EQ(a.enemyLives[i], b.enemyLives[i]);
+  }
+}
+
+TEST(RandomMap, FollowsTheConfig) {
+  MapConfig config;
+  config.minDataPoints = config.maxDataPoints = 7;
+  config.minEnemies = config.maxEnemies = 20;
+  config.minLife = config.maxLife = 9;
+  FastRandom random(3);
+  GameState state = randomMap(random, config);
+  EXPECT_EQ(7, state.dataRemaining);
+  EXPECT_EQ(20, state.enemiesRemaining);
+  EXPECT_EQ(180, state.initialTotalLife);
+  for (int i = 0; i < state.enemyCount; ++i) {
+    EXPECT_EQ(i, state.enemyIds[i]);
+    EXPECT_GT(Vector2f::distance(state.enemyPositions[i], state.wolff),
+              KILL_RANGE + ENEMY_STEP);
+  }
+}
+
+TEST(WriteTurnInput, SkipsRemovedEntities) {
+  GameState state;
+  state.wolff.set(1100, 1200);
+  state.addDataPoint(0, Vector2f(8250, 4500));
+  state.addDataPoint(1, Vector2f(8250, 8999));
+  state.addEnemy(0, Vector2f(3100, 8000), 10);
+  state.addEnemy(1, Vector2f(4000, 100), 7);
+  state.removeDataPoint(0);
+  state.removeEnemy(0);
+  std::string text;
+  writeTurnInput(state, text);
+  EXPECT_EQ("1100 1200\n1\n1 8250 8999\n1\n1 4000 100 7\n", text);
+}
+
+TEST(ParseAction, ReadsMovesAndShots) {
+  GameState state;
+  state.addEnemy(4, Vector2f(3000, 3000), 10);
+  state.addEnemy(9, Vector2f(6000, 3000), 10);
+  Action action;
+  EXPECT_TRUE(parseAction("MOVE 12 -3", state, action));
+  EXPECT_EQ(Action::MOVE, action.type);
+  EXPECT_EQ(Vector2f(12, -3), action.destination);
+  EXPECT_TRUE(parseAction("SHOOT 9 bang", state, action));
+  EXPECT_EQ(Action::SHOOT, action.type);
+  EXPECT_EQ(1, action.enemy);
+}
+
+TEST(ParseAction, RejectsInvalidLines) {
+  GameState state;
+  state.addEnemy(4, Vector2f(3000, 3000), 10);
+  state.removeEnemy(0);
+  Action action;
+  EXPECT_FALSE(parseAction("", state, action));
+  EXPECT_FALSE(parseAction("MOVE 12", state, action));
+  EXPECT_FALSE(parseAction("MOVE 1x 2", state, action));
+  EXPECT_FALSE(parseAction("SHOOT 4", state, action));
+  EXPECT_FALSE(parseAction("WAIT", state, action));
+}
+
+TEST(PlayTurn, MatchesSimulate) {
+  // The rules of the referee and the simulation of the bot are written
+  // apart, they must agree.
+  for (unsigned seed = 1; seed <= 100; ++seed) {
+    FastRandom random(seed);
+    GameState state = randomMap(random);
+    GameState simulated = state;
+    while (!state.isOver() && state.turn < 200) {
+      Action action =
+          random.coin()
+              ? Action::shoot(static_cast<int>(state.enemyAlive.next(
+                    random.below(static_cast<std::uint32_t>(state.enemyCount)))))
+              : Action::move(Vector2f(random.range(0, 15999),
+                                      random.range(0, 8999)));
+      if (action.type == Action::SHOOT && action.enemy >= state.enemyCount)
+        action = Action::shoot(static_cast<int>(state.enemyAlive.next(0)));
+      playTurn(state, action);
+      simulate(simulated, action);
+      ASSERT_EQ(state.wolff, simulated.wolff) << seed;
+      ASSERT_EQ(state.wolffDead, simulated.wolffDead) << seed;
+      ASSERT_EQ(state.dataRemaining, simulated.dataRemaining) << seed;
+      ASSERT_EQ(state.kills, simulated.kills) << seed;
+      for (int i = 0; i < state.enemyCount; ++i) {
+        ASSERT_EQ(state.enemyPositions[i], simulated.enemyPositions[i])
+            << seed << " " << state.turn;
+        ASSERT_EQ(state.enemyLives[i], simulated.enemyLives[i]) << seed;
+      }
+    }
+  }
+}
+
+TEST(PlayTurn, LooksForTheClosestDataPointEveryTurn) {
+  GameState state;
+  state.wolff.set(0, 0);
+  state.addDataPoint(0, Vector2f(12603, 3586));
+  state.addDataPoint(1, Vector2f(12590, 3561));
+  state.addEnemy(0, Vector2f(3321, 8397), 10);
+  playTurn(state, Action::move(state.wolff));
+  EXPECT_EQ(Vector2f(3764, 8166), state.enemyPositions[0]);
+  // Now closer to the second data point : going on to the first one would
+  // end at (4207, 7935).
+  playTurn(state, Action::move(state.wolff));
+  EXPECT_EQ(Vector2f(4207, 7934), state.enemyPositions[0]);
+}
+
+TEST(BotProcess, ReadsLinesBeforeTheDeadline) {
+  BotProcess bot;
+  ASSERT_TRUE(bot.start("cat", false));
+  EXPECT_TRUE(bot.send("MOVE 1 2\nSHOOT 3\r\nhalf"));
+  std::uint64_t deadline =
+      TurnClock::now() +
+      static_cast<std::uint64_t>(200 * TurnClock::ticksPerMs());
+  std::string line;
+  EXPECT_EQ(1, bot.readLine(line, deadline));
+  EXPECT_EQ("MOVE 1 2", line);
+  EXPECT_EQ(1, bot.readLine(line, deadline));
+  EXPECT_EQ("SHOOT 3", line);
+  deadline = TurnClock::now() +
+             static_cast<std::uint64_t>(20 * TurnClock::ticksPerMs());
+  EXPECT_EQ(0, bot.readLine(line, deadline));
+  bot.stop();
+}
+
+TEST(PlayGame, ReportsBrokenBots) {
+  FastRandom random(5);
+  GameState map = randomMap(random);
+  RefereeConfig config;
+  config.firstTurnBudgetMs = 50;
+
+  config.command = "sleep 5";
+  GameResult result = playGame(map, config);
+  EXPECT_EQ(GameResult::TIMEOUT, result.outcome);
+  ASSERT_EQ(1u, result.latenciesMs.size());
+  EXPECT_GE(result.latenciesMs[0], 50);
+
+  config.command = "echo WAIT";
+  result = playGame(map, config);
+  EXPECT_EQ(GameResult::INVALID, result.outcome);
+  EXPECT_EQ("WAIT", result.invalidOutput);
+
+  config.command = "exit 0";
+  result = playGame(map, config);
+  EXPECT_EQ(GameResult::CRASHED, result.outcome);
+  EXPECT_EQ(0, result.score);
+}
+
+TEST(PlayGames, KeepsTheOrderOfTheSeeds) {
+  RefereeConfig config;
+  // Answers every line of the input, so it is always ahead of the turns.
+  config.command = "while read line; do echo MOVE 0 0; done";
+  config.maxTurns = 3;
+  std::vector<unsigned> seeds = {7, 8, 9};
+  std::vector<GameResult> results = playGames(seeds, 2, config);
+  ASSERT_EQ(3u, results.size());
+  for (std::size_t i = 0; i < seeds.size(); ++i) {
+    EXPECT_EQ(seeds[i], results[i].seed);
+    EXPECT_NE(GameResult::TIMEOUT, results[i].outcome);
+    EXPECT_NE(GameResult::INVALID, results[i].outcome);
+  }
+}
+
+TEST(PlayGame, LogsTheTurns) {
+  FastRandom random(11);
+  GameState map = randomMap(random);
+  RefereeConfig config;
+  config.command = "while read line; do echo MOVE 0 0; done";
+  config.maxTurns = 4;
+  char directory[] = "/tmp/refereeXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(directory));
+  std::string prefix = std::string(directory) + "/game";
+  GameResult result = playGame(map, config, prefix);
+
+  ReplayReader reader;
+  ASSERT_TRUE(reader.open((prefix + ".rpl").c_str()));
+  ReplayTurnView view;
+  ASSERT_TRUE(reader.next(view));
+  EXPECT_EQ(map.enemiesRemaining, view.turn->enemyCount);
+  EXPECT_EQ(Action::MOVE, view.turn->actionType);
+  int turns = 1;
+  while (reader.next(view))
+    ++turns;
+  EXPECT_EQ(result.turns, turns);
+  reader.close();
+  std::remove((prefix + ".rpl").c_str());
+  rmdir(directory);
+}
+}
@@ -0,0 +1,129 @@
+#include "ReplayLog.cpp"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return the path of a new temporary file.
+*/
+static std::string temporaryReplay() {
+  char path[] = "/tmp/replayXXXXXX";
+  int fd = mkstemp(path);
+  if (fd >= 0)
+    close(fd);
+  return path;
+}
+
+TEST(ReplayLog, ReadsBackWhatWasWritten) {
+  GameState state;
+  state.wolff.set(1100, 1200);
+  state.addDataPoint(3, Vector2f(8250, 4500));
+  state.addDataPoint(5, Vector2f(8250, 8999));
+  state.addEnemy(2, Vector2f(3100, 8000), 10);
+  state.addEnemy(7, Vector2f(4000, 100), 7);
+  state.removeDataPoint(0);
+
+  std::string path = temporaryReplay();
+  ReplayWriter writer;
+  ASSERT_TRUE(writer.open(path.c_str()));
+  Action shoot = Action::shoot(1);
+  Action move = Action::move(Vector2f(-50, 300.5f));
+  EXPECT_TRUE(writer.write(state, &shoot, 1234, 56.5f, 12.25));
+  state.removeEnemy(0);
+  EXPECT_TRUE(writer.write(state, &move, 0, 0, 3));
+  EXPECT_TRUE(writer.write(state, nullptr, 0, 0, 101));
+  writer.close();
+
+  ReplayReader reader;
+  ASSERT_TRUE(reader.open(path.c_str()));
+  ReplayTurnView view;
+  ASSERT_TRUE(reader.next(view));
+  EXPECT_EQ(0, view.turn->turn);
+  EXPECT_EQ(Vector2i(1100, 1200), view.turn->wolff);
+  ASSERT_EQ(1, view.turn->dataCount);
+  EXPECT_EQ(5, view.dataIds[0]);
+  EXPECT_EQ(Vector2i(8250, 8999), view.dataPositions[0]);
+  ASSERT_EQ(2, view.turn->enemyCount);
+  EXPECT_EQ(7, view.enemyIds[1]);
+  EXPECT_EQ(Vector2i(4000, 100), view.enemyPositions[1]);
+  EXPECT_EQ(7, view.enemyLives[1]);
+  EXPECT_EQ(Action::SHOOT, view.turn->actionType);
+  EXPECT_EQ(7, view.turn->target);
+  EXPECT_EQ(1234u, view.turn->rollouts);
+  EXPECT_EQ(56.5f, view.turn->value);
+  EXPECT_EQ(12.25f, view.turn->elapsedMs);
+
+  GameState read;
+  read.shots = 4;
+  view.toState(read);
+  EXPECT_EQ(4, read.shots);
+  EXPECT_EQ(2, read.enemyCount);
+  EXPECT_EQ(1, read.findEnemy(7));
+  Action action;
+  EXPECT_TRUE(view.toAction(read, action));
+  EXPECT_EQ(Action::shoot(1), action);
+
+  ASSERT_TRUE(reader.next(view));
+  EXPECT_EQ(1, view.turn->enemyCount);
+  EXPECT_EQ(Vector2i(0, 300), view.turn->destination);
+  ASSERT_TRUE(reader.next(view));
+  EXPECT_EQ(2, view.turn->turn);
+  EXPECT_EQ(REPLAY_NO_ACTION, view.turn->actionType);
+  EXPECT_FALSE(view.toAction(read, action));
+  EXPECT_FALSE(reader.next(view));
+
+  reader.rewind();
+  ASSERT_TRUE(reader.next(view));
+  EXPECT_EQ(0, view.turn->turn);
+  reader.close();
+  std::remove(path.c_str());
+}
+
+TEST(ReplayLog, FlushesLongGames) {
+  GameState state;
+  for (int i = 0; i < MAX_DATA_POINTS; ++i)
+    state.addDataPoint(i, Vector2f(i * 10, i * 5));
+  for (int i = 0; i < MAX_ENEMIES; ++i)
+    state.addEnemy(i, Vector2f(i * 20, i * 7), i + 1);
+  Action move = Action::move(Vector2f(500, 500));
+
+  std::string path = temporaryReplay();
+  ReplayWriter writer;
+  ASSERT_TRUE(writer.open(path.c_str()));
+  const int turns = 200;
+  for (int t = 0; t < turns; ++t)
+    ASSERT_TRUE(writer.write(state, &move, t, 0, t));
+  writer.close();
+
+  ReplayReader reader;
+  ASSERT_TRUE(reader.open(path.c_str()));
+  ReplayTurnView view;
+  int count = 0;
+  while (reader.next(view)) {
+    EXPECT_EQ(count, view.turn->turn);
+    EXPECT_EQ(static_cast<unsigned>(count), view.turn->rollouts);
+    EXPECT_EQ(MAX_ENEMIES, view.enemyLives[MAX_ENEMIES - 1]);
+    ++count;
+  }
+  EXPECT_EQ(turns, count);
+  std::remove(path.c_str());
+}
+
+TEST(ReplayLog, RefusesOtherFiles) {
+  std::string path = temporaryReplay();
+  FILE *file = std::fopen(path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  std::fputs("1100 1200\n1\n1 8250 8999\n", file);
+  std::fclose(file);
+  ReplayReader reader;
+  EXPECT_FALSE(reader.open(path.c_str()));
+  ReplayTurnView view;
+  EXPECT_FALSE(reader.next(view));
+  EXPECT_FALSE(reader.open("/nonexistent/replay.rpl"));
+  std::remove(path.c_str());
+}
+}
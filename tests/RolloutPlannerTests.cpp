@@ -0,0 +1,72 @@
+#include "RolloutPlanner.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Return a state where the only enemy collects the only data point next
+* turn unless Wolff kills it now.
+*/
+static GameState lastChanceState() {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(5000, 1000));
+  state.addEnemy(0, Vector2f(5400, 1000), 5);
+  state.initialTotalLife = 5;
+  return state;
+}
+
+TEST(RolloutPlanner, ShootsTheEnemyAboutToCollect) {
+  RolloutPlanner planner(42);
+  planner.reset(lastChanceState());
+  for (int i = 0; i < 200; ++i)
+    planner.iterate();
+  EXPECT_EQ(201u, planner.rollouts());
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+  EXPECT_EQ(0, planner.bestAction().enemy);
+  EXPECT_GT(planner.bestValue(), 100);
+}
+
+TEST(RolloutPlanner, WarmStartFollowsEnemyIds) {
+  GameState state;
+  state.wolff.set(1000, 1000);
+  state.addDataPoint(0, Vector2f(15000, 8000));
+  state.addEnemy(3, Vector2f(7000, 1000), 50);
+  state.addEnemy(5, Vector2f(7000, 5000), 50);
+  state.initialTotalLife = 100;
+  RolloutPlanner planner(7);
+  planner.reset(state);
+  for (int i = 0; i < 100; ++i)
+    planner.iterate();
+
+  // Enemy 3 died, enemy 5 moves to slot 0.
+  GameState next;
+  next.wolff = state.wolff;
+  next.addDataPoint(0, Vector2f(15000, 8000));
+  next.addEnemy(5, Vector2f(7300, 5200), 50);
+  next.initialTotalLife = 100;
+  next.kills = 1;
+  for (int turn = 0; turn < RolloutPlanner::DEPTH; ++turn) {
+    planner.reset(next);
+    EXPECT_EQ(1u, planner.rollouts());
+    Action action = planner.bestAction();
+    if (action.type == Action::SHOOT) {
+      EXPECT_EQ(0, action.enemy);
+    }
+  }
+}
+
+TEST(RolloutPlanner, BestSequenceStopsWhenTheGameEnds) {
+  // Shooting the only enemy ends the game, the actions after it were never
+  // played and must not be kept.
+  GameState state = lastChanceState();
+  state.enemyLives[0] = 1;
+  state.initialTotalLife = 1;
+  RolloutPlanner planner(42);
+  planner.reset(state);
+  for (int i = 0; i < 200; ++i)
+    planner.iterate();
+  EXPECT_EQ(Action::SHOOT, planner.bestAction().type);
+  EXPECT_EQ(1, planner.bestSequenceLength());
+}
+}
@@ -0,0 +1,261 @@
+#include "Simulator.cpp"
+#include "gtest/gtest.h"
+#include <random>
+
+namespace fuzzyTelegram {
+
+TEST(NearestDataPoint, SkipsCollectedData) {
+  GameState state;
+  state.addDataPoint(0, Vector2f(100, 0));
+  state.addDataPoint(1, Vector2f(500, 0));
+  EXPECT_EQ(0, nearestDataPoint(state, Vector2f::zero()));
+  state.removeDataPoint(0);
+  EXPECT_EQ(1, nearestDataPoint(state, Vector2f::zero()));
+  state.removeDataPoint(1);
+  EXPECT_EQ(-1, nearestDataPoint(state, Vector2f::zero()));
+}
+
+TEST(NearestDataPoint, FirstSlotWinsTies) {
+  GameState state;
+  state.addDataPoint(3, Vector2f(100, 0));
+  state.addDataPoint(7, Vector2f(-100, 0));
+  EXPECT_EQ(0, nearestDataPoint(state, Vector2f::zero()));
+}
+
+TEST(NearestDataPoint, GridMatchesBatch) {
+  GameState state;
+  for (int i = 0; i < MAX_DATA_POINTS; ++i)
+    state.addDataPoint(i, Vector2f(i * 7919 % 16000, i * 104729 % 9000));
+  for (int i = 0; i < MAX_DATA_POINTS; i += 3)
+    state.removeDataPoint(i);
+  ASSERT_GE(state.dataRemaining, DATA_GRID_THRESHOLD);
+  for (int i = 0; i < 200; ++i) {
+    Vector2f position(i * 331 % 16000, i * 577 % 9000);
+    EXPECT_EQ(static_cast<int>(state.dataPositions.nearest(position)),
+              nearestDataPoint(state, position));
+  }
+  // A grid out of sync with dataRemaining finds nothing.
+  state.dataGrid.clear();
+  EXPECT_EQ(-1, nearestDataPoint(state, Vector2f::zero()));
+}
+
+TEST(MoveTowards, StopsAtDestination) {
+  Vector2f v(0, 0);
+  EXPECT_FALSE(moveTowards(v, Vector2f(3000, 4000), 1000));
+  EXPECT_NEAR(600, v.x, 0.01f);
+  EXPECT_NEAR(800, v.y, 0.01f);
+  EXPECT_TRUE(moveTowards(v, Vector2f(700, 800), 1000));
+  EXPECT_EQ(700, v.x);
+  EXPECT_EQ(800, v.y);
+}
+
+TEST(MoveTowards, KeepsWholeCoordinates) {
+  // The referee truncates the positions after every move : predictions
+  // several turns ahead stay on the same whole coordinates.
+  GameState state;
+  state.wolff.set(8000, 4500);
+  state.addDataPoint(0, Vector2f(1234, 8765));
+  state.addDataPoint(1, Vector2f(15001, 17));
+  state.addEnemy(0, Vector2f(9999, 333), 10);
+  state.addEnemy(1, Vector2f(3, 7001), 10);
+  for (int turn = 0; turn < 6 && !state.isOver(); ++turn) {
+    simulate(state, Action::move(Vector2f(1500.7f, 2000.2f)));
+    EXPECT_EQ(Vector2f(Vector2i(state.wolff)), state.wolff);
+    for (int i = 0; i < state.enemyCount; ++i) {
+      Vector2f position = state.enemyPositions[i];
+      if (state.enemyAlive[i]) {
+        EXPECT_EQ(Vector2f(Vector2i(position)), position);
+      }
+    }
+  }
+}
+
+TEST(MoveTowards, GetsCloserToOtherPointsByLessThanTheTargetSlack) {
+  // The targets cached by updateTargets rely on it.
+  std::mt19937 random(3);
+  std::uniform_int_distribution<int> x(0, static_cast<int>(MAP_WIDTH) - 1);
+  std::uniform_int_distribution<int> y(0, static_cast<int>(MAP_HEIGHT) - 1);
+  for (int i = 0; i < 20000; ++i) {
+    Vector2f position(x(random), y(random));
+    Vector2f target(x(random), y(random));
+    Vector2f other(x(random), y(random));
+    double before = Vector2d::distance(Vector2d(other), Vector2d(position)) -
+                    Vector2d::distance(Vector2d(target), Vector2d(position));
+    moveTowards(position, target, ENEMY_STEP);
+    double after = Vector2d::distance(Vector2d(other), Vector2d(position)) -
+                   Vector2d::distance(Vector2d(target), Vector2d(position));
+    ASSERT_LT(before - after, 2 * std::sqrt(2.0)) << position;
+    ASSERT_LT(before - after, TARGET_SLACK);
+  }
+}
+
+TEST(Simulate, EnemyMovesToNearestDataAndCollectsIt) {
+  GameState state;
+  state.wolff.set(0, 0);
+  state.addDataPoint(0, Vector2f(10000, 8000));
+  state.addDataPoint(1, Vector2f(10000, 5300));
+  state.addEnemy(0, Vector2f(10000, 6000), 10);
+  simulate(state, Action::move(Vector2f::zero()));
+  EXPECT_EQ(10000, state.enemyPositions[0].x);
+  EXPECT_EQ(5500, state.enemyPositions[0].y);
+  EXPECT_EQ(2, state.dataRemaining);
+  simulate(state, Action::move(Vector2f::zero()));
+  EXPECT_EQ(5300, state.enemyPositions[0].y);
+  EXPECT_FALSE(state.dataAlive[1]);
+  EXPECT_EQ(1, state.dataRemaining);
+  EXPECT_EQ(2, state.turn);
+}
+
+TEST(UpdateTargets, OnlyLooksForCollectedTargets) {
+  GameState state;
+  state.addDataPoint(0, Vector2f(1000, 1000));
+  state.addDataPoint(1, Vector2f(9000, 1000));
+  state.addEnemy(0, Vector2f(1500, 1000), 10);
+  state.addEnemy(1, Vector2f(1000, 3000), 10);
+  state.addEnemy(2, Vector2f(8000, 1000), 10);
+  EXPECT_EQ(3, updateTargets(state));
+  EXPECT_EQ(0, state.enemyTargets[0]);
+  EXPECT_EQ(0, state.enemyTargets[1]);
+  EXPECT_EQ(1, state.enemyTargets[2]);
+  EXPECT_EQ(0, updateTargets(state));
+
+  state.removeDataPoint(0);
+  EXPECT_FALSE(verifyTargets(state));
+  EXPECT_EQ(2, updateTargets(state));
+  EXPECT_EQ(1, state.enemyTargets[0]);
+  EXPECT_EQ(1, state.enemyTargets[1]);
+  EXPECT_TRUE(verifyTargets(state));
+
+  state.enemyPositions.set(2, Vector2f(1000, 1000));
+  state.addDataPoint(2, Vector2f(1000, 1200));
+  EXPECT_EQ(3, updateTargets(state));
+  EXPECT_EQ(2, state.enemyTargets[2]);
+}
+
+TEST(UpdateTargets, CacheMatchesBruteForceDuringGames) {
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> x(0, static_cast<int>(MAP_WIDTH) - 1);
+  std::uniform_int_distribution<int> y(0, static_cast<int>(MAP_HEIGHT) - 1);
+  for (int game = 0; game < 20; ++game) {
+    GameState state;
+    state.wolff.set(-1e5f, -1e5f);
+    for (int i = 0; i < 40; ++i)
+      state.addDataPoint(i, Vector2f(x(random), y(random)));
+    for (int i = 0; i < 40; ++i)
+      state.addEnemy(i, Vector2f(x(random), y(random)), 10);
+    while (state.dataRemaining > 0) {
+      // Wolff stays out of the map and never shoots.
+      simulate(state, Action::shoot(-1));
+      updateTargets(state);
+      ASSERT_TRUE(verifyTargets(state));
+    }
+  }
+}
+
+TEST(UpdateTargets, LooksAgainWhenTruncatedMovesBringAnotherPointCloser) {
+  // Moving straight to P, the enemy would stay closer to P than to Q. Its
+  // truncated moves end strictly closer to Q after one turn.
+  const Vector2f cases[2][3] = {
+      {Vector2f(3321, 8397), Vector2f(12603, 3586), Vector2f(12590, 3561)},
+      {Vector2f(8481, 797), Vector2f(1140, 3662), Vector2f(1133, 3644)}};
+  for (const Vector2f *positions : cases) {
+    GameState state;
+    state.wolff.set(-1e5f, -1e5f);
+    state.addDataPoint(0, positions[1]);
+    state.addDataPoint(1, positions[2]);
+    state.addEnemy(0, positions[0], 10);
+    updateTargets(state);
+    EXPECT_EQ(0, state.enemyTargets[0]);
+    simulate(state, Action::shoot(-1));
+    updateTargets(state);
+    EXPECT_EQ(1, state.enemyTargets[0]) << state.enemyPositions[0];
+    EXPECT_TRUE(verifyTargets(state));
+  }
+}
+
+TEST(VerifyTargets, ComparesExactly) {
+  // 3000^2 + 1 against 3000^2 : a relative tolerance would accept both.
+  GameState state;
+  state.addDataPoint(0, Vector2f(3000, 1));
+  state.addDataPoint(1, Vector2f(3000, 0));
+  state.addDataPoint(2, Vector2f(0, 3000));
+  state.addEnemy(0, Vector2f::zero(), 10);
+  updateTargets(state);
+  EXPECT_EQ(1, state.enemyTargets[0]);
+  EXPECT_TRUE(verifyTargets(state));
+  state.enemyTargets[0] = 0;
+  EXPECT_FALSE(verifyTargets(state));
+  // Slots 1 and 2 tie, the first wins.
+  state.enemyTargets[0] = 2;
+  EXPECT_FALSE(verifyTargets(state));
+}
+
+TEST(Simulate, WolffDiesInKillRange) {
+  GameState state;
+  state.wolff.set(0, 0);
+  state.addDataPoint(0, Vector2f(5000, 0));
+  state.addEnemy(0, Vector2f(10000, 0), 10);
+  simulate(state, Action::move(Vector2f(3000, 0)));
+  EXPECT_FALSE(state.wolffDead);
+  EXPECT_EQ(1000, state.wolff.x);
+  state.wolff.set(7000, 0);
+  simulate(state, Action::move(Vector2f(7000, 0)));
+  EXPECT_TRUE(state.wolffDead);
+  EXPECT_TRUE(state.isOver());
+  EXPECT_EQ(0, score(state));
+}
+
+TEST(Simulate, ShootKillsEnemyBeforeItCollects) {
+  GameState state;
+  state.wolff.set(0, 0);
+  state.addDataPoint(0, Vector2f(2500, 0));
+  state.addEnemy(0, Vector2f(2800, 0), 10);
+  simulate(state, Action::shoot(0));
+  EXPECT_FALSE(state.enemyAlive[0]);
+  EXPECT_TRUE(state.dataAlive[0]);
+  EXPECT_EQ(1, state.shots);
+  EXPECT_EQ(1, state.kills);
+  EXPECT_TRUE(state.isOver());
+}
+
+TEST(Score, CountsDataKillsAndBonus) {
+  GameState state;
+  state.addDataPoint(0, Vector2f::zero());
+  state.addDataPoint(1, Vector2f::zero());
+  state.initialTotalLife = 20;
+  state.shots = 4;
+  state.kills = 1;
+  EXPECT_EQ(2 * 100 + 10 + 2 * (20 - 12) * 3, score(state));
+  state.shots = 10;
+  EXPECT_EQ(2 * 100 + 10, score(state));
+}
+
+TEST(PlayableAction, ReplacesShotsAtDeadEnemies) {
+  GameState state;
+  state.wolff.set(1000, 2000);
+  state.addEnemy(0, Vector2f(5000, 0), 8);
+  state.addEnemy(1, Vector2f(9000, 0), 8);
+  EXPECT_TRUE(playableAction(state, Action::shoot(1)) == Action::shoot(1));
+  state.removeEnemy(1);
+  EXPECT_TRUE(playableAction(state, Action::shoot(1)) ==
+              Action::move(Vector2f(1000, 2000)));
+  EXPECT_TRUE(playableAction(state, Action::shoot(5)) ==
+              Action::move(Vector2f(1000, 2000)));
+  EXPECT_TRUE(playableAction(state, Action::shoot(-1)).type == Action::MOVE);
+  Action move = Action::move(Vector2f(20000, -5));
+  EXPECT_TRUE(playableAction(state, move) == move);
+}
+
+TEST(Evaluate, CountsTheShotsGiven) {
+  GameState state;
+  state.addDataPoint(0, Vector2f::zero());
+  state.addEnemy(0, Vector2f(5000, 0), 8);
+  state.initialTotalLife = 10;
+  state.shots = 2;
+  EXPECT_FLOAT_EQ(100 + (10 - 6) * 3 + 0.2f, evaluate(state));
+  EXPECT_FLOAT_EQ(evaluate(state), evaluate(state, 2));
+  EXPECT_FLOAT_EQ(100 + 10 * 3 + 0.2f, evaluate(state, 0));
+  state.wolffDead = true;
+  EXPECT_EQ(0, evaluate(state, 0));
+}
+}
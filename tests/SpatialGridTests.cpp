@@ -0,0 +1,127 @@
+#include "SpatialGrid.cpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace fuzzyTelegram {
+
+typedef SpatialGrid<64, 16000, 9000, 1000> TestGrid;
+
+/*!
+* \brief Fill a batch and a grid with random positions.
+*/
+static void fillGrid(Vector2Batch<float, 64> &positions, TestGrid &grid,
+                     unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> x(0, 15999);
+  std::uniform_real_distribution<float> y(0, 8999);
+  for (std::size_t i = 0; i < 64; ++i) {
+    Vector2f position(x(random), y(random));
+    positions.push(position);
+    grid.insert(i, position);
+  }
+}
+
+TEST(SpatialGrid, CellOfClampsToTheMap) {
+  EXPECT_EQ(Vector2i(0, 0), TestGrid::cellOf(Vector2f(-500, -1)));
+  EXPECT_EQ(Vector2i(3, 4), TestGrid::cellOf(Vector2f(3999, 4000)));
+  EXPECT_EQ(Vector2i(15, 8), TestGrid::cellOf(Vector2f(1e6f)));
+  EXPECT_EQ(16, TestGrid::COLUMNS);
+  EXPECT_EQ(9, TestGrid::ROWS);
+}
+
+TEST(SpatialGrid, InsertRemoveAndMove) {
+  Vector2Batch<float, 64> positions;
+  TestGrid grid;
+  TestGrid::Index out[64];
+  for (int i = 0; i < 3; ++i) {
+    positions.push(Vector2f(100.0f + i, 100));
+    grid.insert(i, positions[i]);
+  }
+  EXPECT_EQ(3u, grid.within(positions, Vector2f(100), 10, out, 64));
+
+  grid.remove(1);
+  EXPECT_FALSE(grid.contains(1));
+  ASSERT_EQ(2u, grid.within(positions, Vector2f(100), 10, out, 64));
+  EXPECT_NE(1, out[0]);
+  EXPECT_NE(1, out[1]);
+
+  positions.set(0, Vector2f(9000, 5000));
+  grid.move(0, positions[0]);
+  ASSERT_EQ(1u, grid.within(positions, Vector2f(100), 10, out, 64));
+  EXPECT_EQ(2, out[0]);
+  ASSERT_EQ(1u, grid.within(positions, Vector2f(9000, 5000), 1, out, 64));
+  EXPECT_EQ(0, out[0]);
+}
+
+TEST(SpatialGrid, WithinMatchesBruteForce) {
+  Vector2Batch<float, 64> positions;
+  TestGrid grid;
+  fillGrid(positions, grid, 3);
+  grid.remove(7);
+  TestGrid::Index out[64];
+  Vector2f center(5000, 3000);
+  std::size_t count = grid.within(positions, center, 2500, out, 64);
+  std::vector<int> found(out, out + count);
+  std::sort(found.begin(), found.end());
+  std::vector<int> expected;
+  for (int i = 0; i < 64; ++i)
+    if (i != 7 && Vector2f::distance(positions[i], center) <= 2500)
+      expected.push_back(i);
+  EXPECT_EQ(expected, found);
+  EXPECT_EQ(std::min<std::size_t>(2, expected.size()),
+            grid.within(positions, center, 2500, out, 2));
+}
+
+TEST(SpatialGrid, NearestMatchesBruteForce) {
+  Vector2Batch<float, 64> positions;
+  TestGrid grid;
+  fillGrid(positions, grid, 5);
+  std::mt19937 random(11);
+  std::uniform_real_distribution<float> x(-2000, 18000);
+  std::uniform_real_distribution<float> y(-2000, 11000);
+  for (int test = 0; test < 50; ++test) {
+    Vector2f center(x(random), y(random));
+    std::vector<std::pair<float, int>> expected;
+    for (int i = 0; i < 64; ++i)
+      expected.push_back(std::make_pair(
+          Vector2f::squaredDistance(positions[i], center), i));
+    std::sort(expected.begin(), expected.end());
+    TestGrid::Index out[5];
+    float distances[5];
+    ASSERT_EQ(5u, grid.nearest(positions, center, 5, out, distances));
+    for (int i = 0; i < 5; ++i) {
+      EXPECT_EQ(expected[i].second, out[i]);
+      EXPECT_EQ(expected[i].first, distances[i]);
+    }
+  }
+}
+
+TEST(SpatialGrid, NearestFindsFirstOfTies) {
+  Vector2Batch<float, 64> positions;
+  TestGrid grid;
+  positions.push(Vector2f(3000, 1000));
+  positions.push(Vector2f(1000, 1000));
+  positions.push(Vector2f(1000, 3000));
+  for (std::size_t i = 0; i < 3; ++i)
+    grid.insert(i, positions[i]);
+  TestGrid::Index out[4];
+  float distances[4];
+  ASSERT_EQ(3u, grid.nearest(positions, Vector2f(2000, 2000), 4, out,
+                             distances));
+  EXPECT_EQ(0, out[0]);
+  EXPECT_EQ(1, out[1]);
+  EXPECT_EQ(2, out[2]);
+}
+
+TEST(SpatialGrid, NearestOnEmptyGrid) {
+  Vector2Batch<float, 64> positions;
+  TestGrid grid;
+  TestGrid::Index out[1];
+  float distances[1];
+  EXPECT_EQ(0u, grid.nearest(positions, Vector2f::zero(), 1, out,
+                             distances));
+}
+}
@@ -0,0 +1,96 @@
+#include "StateHistory.cpp"
+#include "gtest/gtest.h"
+#include <memory>
+#include <random>
+
+namespace fuzzyTelegram {
+
+/*!
+* \brief Expect two states to hold the same game, whatever the order of the
+* data points in their grid cells.
+*/
+static void expectSameGame(const GameState &expected, const GameState &actual) {
+  EXPECT_EQ(expected.wolff, actual.wolff);
+  EXPECT_EQ(expected.wolffDead, actual.wolffDead);
+  EXPECT_EQ(expected.turn, actual.turn);
+  EXPECT_EQ(expected.shots, actual.shots);
+  EXPECT_EQ(expected.kills, actual.kills);
+  EXPECT_EQ(expected.dataRemaining, actual.dataRemaining);
+  EXPECT_EQ(expected.enemiesRemaining, actual.enemiesRemaining);
+  for (int i = 0; i < expected.dataCount; ++i) {
+    EXPECT_EQ(expected.dataAlive[i], actual.dataAlive[i]);
+    EXPECT_EQ(expected.dataPositions[i], actual.dataPositions[i]);
+    EXPECT_EQ(expected.dataGrid.contains(i), actual.dataGrid.contains(i));
+  }
+  for (int i = 0; i < expected.enemyCount; ++i) {
+    EXPECT_EQ(expected.enemyAlive[i], actual.enemyAlive[i]);
+    EXPECT_EQ(expected.enemyPositions[i], actual.enemyPositions[i]);
+    EXPECT_EQ(expected.enemyLives[i], actual.enemyLives[i]);
+    EXPECT_EQ(expected.enemyTargets[i], actual.enemyTargets[i]);
+  }
+}
+
+/*!
+* \brief Return a random game where Wolff can shoot for a while before dying.
+*/
+static GameState historyGame(unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> x(0, static_cast<int>(MAP_WIDTH) - 1);
+  std::uniform_int_distribution<int> y(0, static_cast<int>(MAP_HEIGHT) - 1);
+  GameState state;
+  state.wolff.set(8000, 4500);
+  for (int i = 0; i < 50; ++i)
+    state.addDataPoint(i, Vector2f(x(random), y(random)));
+  for (int i = 0; i < 50; ++i) {
+    Vector2f position;
+    do {
+      position.set(x(random), y(random));
+    } while (Vector2f::distance(position, state.wolff) < 6000);
+    state.addEnemy(i, position, 3);
+  }
+  return state;
+}
+
+TEST(SnapshotStack, RestoresTheLastSavedState) {
+  SnapshotStack<2> snapshots;
+  GameState state = historyGame(1);
+  GameState root = state;
+  snapshots.push(state);
+  simulate(state, Action::shoot(0));
+  snapshots.push(state);
+  GameState afterShot = state;
+  simulate(state, Action::move(Vector2f::zero()));
+  EXPECT_EQ(2u, snapshots.size());
+  snapshots.restore(state);
+  expectSameGame(afterShot, state);
+  snapshots.pop();
+  snapshots.restore(state);
+  expectSameGame(root, state);
+  snapshots.pop();
+  EXPECT_EQ(0u, snapshots.size());
+}
+
+TEST(UndoLog, UndoesTurnsInReverseOrder) {
+  std::unique_ptr<UndoLog> log(new UndoLog());
+  std::mt19937 random(5);
+  for (unsigned game = 0; game < 10; ++game) {
+    GameState state = historyGame(game);
+    GameState history[UndoLog::MAX_TURNS];
+    int turns = 0;
+    while (!state.isOver() && turns < UndoLog::MAX_TURNS) {
+      history[turns++] = state;
+      int enemy = static_cast<int>(state.enemyAlive.next(0));
+      Action action =
+          random() % 2 ? Action::shoot(enemy)
+                       : Action::move(Vector2f(random() % 16000,
+                                               random() % 9000));
+      simulate(state, action, *log);
+    }
+    EXPECT_EQ(turns, log->turns());
+    while (log->turns() > 0) {
+      log->undo(state);
+      expectSameGame(history[log->turns()], state);
+    }
+  }
+}
+}
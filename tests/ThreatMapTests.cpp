@@ -0,0 +1,88 @@
+#include "ThreatMap.cpp"
+#include "gtest/gtest.h"
+#include <cmath>
+
+namespace fuzzyTelegram {
+
+static GameState threatState() {
+  GameState state;
+  state.addDataPoint(0, Vector2f(8000, 4500));
+  state.addEnemy(0, Vector2f(1000, 1000), 10);
+  state.addEnemy(1, Vector2f(12000, 7000), 10);
+  state.addEnemy(2, Vector2f(13000, 2000), 10);
+  return state;
+}
+
+/*!
+* \brief Return the earliest turn an enemy of state can kill Wolff standing
+* at position.
+*/
+static int exactTurn(const GameState &state, const Vector2f &position) {
+  int best = ThreatMap::NEVER;
+  for (int i = 0; i < state.enemyCount; ++i) {
+    if (!state.enemyAlive[i])
+      continue;
+    float distance = Vector2f::distance(state.enemyPositions[i], position);
+    int turn = std::max(
+        1, static_cast<int>(std::ceil((distance - KILL_RANGE) / ENEMY_STEP)));
+    best = std::min(best, turn);
+  }
+  return best;
+}
+
+TEST(ThreatMap, NeverLaterThanTheEnemies) {
+  GameState state = threatState();
+  ThreatMap threats;
+  EXPECT_EQ(ThreatMap::NEVER, threats.earliestTurn(Vector2f(500, 500)));
+  threats.build(state);
+  EXPECT_EQ(1, threats.earliestTurn(Vector2f(1000, 1000)));
+  EXPECT_FALSE(threats.isSafe(Vector2f(1000, 1000), 1));
+  for (int i = 0; i < 5000; ++i) {
+    Vector2f position(i * 7919 % 16000, i * 104729 % 9000);
+    int exact = exactTurn(state, position);
+    int turn = threats.earliestTurn(position);
+    // At most half a cell diagonal early : less than a turn.
+    ASSERT_LE(turn, exact) << position;
+    ASSERT_GE(turn, exact - 1) << position;
+  }
+}
+
+TEST(ThreatMap, MatchesTheSimulation) {
+  // Wolff standing still on a cell said safe for k turns survives them.
+  GameState state = threatState();
+  ThreatMap threats;
+  threats.build(state);
+  for (int i = 0; i < 300; ++i) {
+    Vector2f position(i * 6151 % 16000, i * 3571 % 9000);
+    int turns = threats.earliestTurn(position) - 1;
+    GameState game = state;
+    game.wolff = Vector2f(Vector2i(position));
+    for (int k = 0; k < std::min(turns, 20); ++k)
+      simulate(game, Action::move(game.wolff));
+    EXPECT_FALSE(game.wolffDead) << position;
+  }
+}
+
+TEST(ThreatMap, RemovingAnEnemyMatchesABuild) {
+  GameState state = threatState();
+  ThreatMap threats;
+  threats.build(state);
+  int before = threats.earliestTurn(Vector2f(13000, 2000));
+  int updated = threats.enemyRemoved(2);
+  EXPECT_GT(updated, 0);
+  EXPECT_LT(updated, ThreatMap::CELLS);
+  EXPECT_LT(before, threats.earliestTurn(Vector2f(13000, 2000)));
+  EXPECT_EQ(0, threats.enemyRemoved(2));
+
+  state.removeEnemy(2);
+  ThreatMap rebuilt;
+  rebuilt.build(state);
+  for (int row = 0; row < ThreatMap::ROWS; ++row)
+    for (int column = 0; column < ThreatMap::COLUMNS; ++column)
+      ASSERT_EQ(rebuilt.cellTurn(column, row), threats.cellTurn(column, row));
+
+  threats.enemyRemoved(0);
+  threats.enemyRemoved(1);
+  EXPECT_EQ(ThreatMap::NEVER, threats.earliestTurn(Vector2f(12000, 7000)));
+}
+}
@@ -0,0 +1,67 @@
+#include "Vector2Batch.cpp"
+#include "gtest/gtest.h"
+
+namespace fuzzyTelegram {
+
+TEST(Vector2Batch, PushAndSubscript) {
+  Vector2Batch<int, 4> batch;
+  EXPECT_EQ(0u, batch.size());
+  EXPECT_EQ(0u, batch.push(Vector2i(1, 2)));
+  EXPECT_EQ(1u, batch.push(Vector2i(3, 4)));
+  batch.set(0, Vector2i(5, 6));
+  EXPECT_EQ(5, batch[0].x);
+  EXPECT_EQ(6, batch[0].y);
+  EXPECT_EQ(3, batch[1].x);
+  batch.clear();
+  EXPECT_EQ(0u, batch.size());
+}
+
+TEST(Vector2Batch, SquaredDistancesMatchScalar) {
+  Vector2Batch<float, 21> batch;
+  for (int i = 0; i < 21; ++i)
+    batch.push(Vector2f(i * 37 % 11, i * 13 % 7 - 3));
+  float out[21];
+  Vector2f point(2.5f, -1);
+  batch.squaredDistances(point, out);
+  for (int i = 0; i < 21; ++i)
+    EXPECT_FLOAT_EQ((batch[i] - point).squaredMagnitude(), out[i]);
+}
+
+TEST(Vector2Batch, DotsMatchScalar) {
+  Vector2Batch<float, 13> batch;
+  for (int i = 0; i < 13; ++i)
+    batch.push(Vector2f(i, -i * 2));
+  float out[13];
+  Vector2f v(3, 0.5f);
+  batch.dots(v, out);
+  for (int i = 0; i < 13; ++i)
+    EXPECT_FLOAT_EQ(Vector2f::dot(batch[i], v), out[i]);
+}
+
+TEST(Vector2Batch, NearestFindsFirstOfTies) {
+  Vector2Batch<float, 20> batch;
+  for (int i = 0; i < 20; ++i)
+    batch.push(Vector2f(1000 - i * 10, 0));
+  batch.set(5, Vector2f(1, 0));
+  batch.set(17, Vector2f(-1, 0));
+  float distance;
+  EXPECT_EQ(5u, batch.nearest(Vector2f::zero(), &distance));
+  EXPECT_EQ(1.0f, distance);
+  batch.set(18, Vector2f(0, 0));
+  EXPECT_EQ(18u, batch.nearest(Vector2f::zero()));
+}
+
+TEST(Vector2Batch, NearestOnEmptyBatch) {
+  Vector2Batch<double, 8> batch;
+  EXPECT_EQ(0u, batch.nearest(Vector2d::one()));
+}
+
+TEST(Vector2Batch, AnyWithin) {
+  Vector2Batch<float, 10> batch;
+  for (int i = 0; i < 10; ++i)
+    batch.push(Vector2f(5000 + i * 100, 0));
+  EXPECT_FALSE(batch.anyWithin(Vector2f::zero(), 2000));
+  batch.set(9, Vector2f(2000, 0));
+  EXPECT_TRUE(batch.anyWithin(Vector2f::zero(), 2000));
+}
+}
@@ -1,9 +1,10 @@
-#include "Vector2.cpp"
+#include "Vector2.hpp"
 #include "gtest/gtest.h"
 #include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
 
 namespace fuzzyTelegram {
 
@@ -64,6 +65,41 @@ TEST(ValueConstructor, DifferentType) {
   EXPECT_EQ(2, v.y);
 }
 
+TEST(TrivialCopy, AllTypes) {
+  EXPECT_TRUE(std::is_trivially_copyable<Vector2i>::value);
+  EXPECT_TRUE(std::is_trivially_copyable<Vector2f>::value);
+  EXPECT_TRUE(std::is_trivially_copyable<Vector2d>::value);
+  EXPECT_TRUE(std::is_trivially_destructible<Vector2f>::value);
+}
+
+TEST(CompileTime, Arithmetic) {
+  constexpr Vector2i v = Vector2i(2, 3) * 4 - Vector2i::one() + Vector2i::up();
+  static_assert(v.x == 7 && v.y == 12, "constexpr arithmetic");
+  constexpr Vector2f u = -(Vector2f::right() + Vector2f::down()) / 2;
+  static_assert(u == Vector2f(-0.5f, 0.5f), "constexpr division");
+  static_assert(Vector2i(3, 4).squaredMagnitude() == 25, "squaredMagnitude");
+  static_assert(Vector2i::dot(Vector2i(1, 2), Vector2i(3, 4)) == 11, "dot");
+  static_assert(Vector2i::zero() != Vector2i::left(), "comparison");
+  static_assert(Vector2i(5, 9)[1] == 9, "subscript");
+  static_assert(Vector2f::lerp(Vector2f::zero(), Vector2f(10, 20), 0.5f) ==
+                    Vector2f(5, 10),
+                "lerp");
+  EXPECT_EQ(7, v.x);
+}
+
+TEST(CompileTime, CompoundAssignment) {
+  struct Table {
+    static constexpr Vector2i walk(int steps) {
+      Vector2i v;
+      for (int i = 0; i < steps; ++i)
+        v += Vector2i::right() * 2;
+      return v;
+    }
+  };
+  static_assert(Table::walk(5) == Vector2i(10, 0), "constexpr loop");
+  EXPECT_EQ(10, Table::walk(5).x);
+}
+
 // Methods
 
 TEST(Magnitude, NegativeVector) {
@@ -182,6 +218,83 @@ TEST(Distance, FloatNegativeVectors) {
   Vector2f u(7, -1);
   EXPECT_NEAR(11.6, Vector2f::distance(v, u), 0.1f);
 }
+TEST(ClampMagnitude, LongerVector) {
+  Vector2f v = Vector2f::clampMagnitude(Vector2f(30, 40), 10);
+  EXPECT_NEAR(6, v.x, 0.001f);
+  EXPECT_NEAR(8, v.y, 0.001f);
+}
+
+TEST(ClampMagnitude, ShorterVector) {
+  Vector2i v = Vector2i::clampMagnitude(Vector2i(3, 4), 10);
+  EXPECT_EQ(3, v.x);
+  EXPECT_EQ(4, v.y);
+}
+
+TEST(Lerp, FloatVectors) {
+  Vector2f v(0, 10);
+  Vector2f u(10, 20);
+  EXPECT_EQ(v, Vector2f::lerp(v, u, 0));
+  EXPECT_EQ(u, Vector2f::lerp(v, u, 1));
+  EXPECT_NEAR(5, Vector2f::lerp(v, u, 0.5f).x, 0.001f);
+  EXPECT_NEAR(15, Vector2f::lerp(v, u, 0.5f).y, 0.001f);
+}
+
+TEST(Lerp, IntVectorsClampT) {
+  Vector2i v(0, 0);
+  Vector2i u(100, -100);
+  EXPECT_EQ(25, Vector2i::lerp(v, u, 0.25f).x);
+  EXPECT_EQ(-25, Vector2i::lerp(v, u, 0.25f).y);
+  EXPECT_EQ(100, Vector2i::lerp(v, u, 2).x);
+}
+
+TEST(IntegerSqrt, ExactAroundSquares) {
+  for (std::uint64_t root = 0; root < 5000; ++root) {
+    EXPECT_EQ(root, integerSqrt(root * root));
+    EXPECT_EQ(root, integerSqrt(root * root + 2 * root));
+  }
+  const std::uint64_t big = (1ull << 26) - 1;
+  EXPECT_EQ(big, integerSqrt(big * big));
+  EXPECT_EQ(big - 1, integerSqrt(big * big - 1));
+}
+
+TEST(StepTowards, ExactOnWholeSteps) {
+  // 3-4-5 triangles : the steps are whole numbers in both directions.
+  Vector2i v(5000, 5000);
+  EXPECT_FALSE(stepTowards(v, Vector2i(8000, 9000), 1000));
+  EXPECT_EQ(Vector2i(5600, 5800), v);
+  EXPECT_FALSE(stepTowards(v, Vector2i(2600, 1800), 1000));
+  EXPECT_EQ(Vector2i(5000, 5000), v);
+  EXPECT_TRUE(stepTowards(v, Vector2i(5300, 5400), 500));
+  EXPECT_EQ(Vector2i(5300, 5400), v);
+}
+
+TEST(StepTowards, RoundsDownLikeTheReferee) {
+  Vector2i v(100, 100);
+  // Moved by (707.1, -707.1) : down to 807 and to 99 - 707.
+  EXPECT_FALSE(stepTowards(v, Vector2i(5100, -4900), 1000));
+  EXPECT_EQ(Vector2i(807, -608), v);
+  for (int i = 0; i < 10000; ++i) {
+    Vector2i from(i * 7919 % 16000, i * 104729 % 9000);
+    Vector2i to(i * 6151 % 16000, i * 3571 % 9000);
+    long double dx = to.x - from.x;
+    long double dy = to.y - from.y;
+    long double length = std::sqrt(dx * dx + dy * dy);
+    long double x = from.x + dx * 1000 / length;
+    long double y = from.y + dy * 1000 / length;
+    Vector2i moved(from);
+    if (stepTowards(moved, to, 1000)) {
+      EXPECT_LE(length, 1000);
+      continue;
+    }
+    // Too close to a whole number for long doubles to round.
+    if (std::fabs(x - std::round(x)) < 1e-9L ||
+        std::fabs(y - std::round(y)) < 1e-9L)
+      continue;
+    ASSERT_EQ(static_cast<int>(std::floor(x)), moved.x) << from << to;
+    ASSERT_EQ(static_cast<int>(std::floor(y)), moved.y) << from << to;
+  }
+}
+
 // Operators
 
 TEST(Stream, StreamInsertion) {
@@ -267,6 +380,13 @@ TEST(EqualityOperator, VectorsDifferentType) {
   EXPECT_TRUE(v == v2);
 }
 
+TEST(EqualityOperator, VectorsDifferentY) {
+  Vector2i v(30, 25);
+  Vector2i v2(30, 2);
+  EXPECT_FALSE(v == v2);
+  EXPECT_TRUE(v != v2);
+}
+
 TEST(EqualityOperator, VectorsNotEqual) {
   Vector2i v(30, 25);
   Vector2i v2(3, 2);